@@ -0,0 +1,510 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            main.cpp
+// Created:         10/19/2026
+//
+// Description:     The Benchmark: searches a fixed set of positions with an
+//                  AI Engine Plugin to a fixed depth, and reports the nodes,
+//                  the time and the statistics of the search.
+//
+//   Usage:  AI_bench [options] <plugin>
+//
+//      -d depth     The search depth, in plies as the engine counts them
+//                   (default: 5).
+//      -s file      The positions: one per line, as the moves leading to it
+//                   from the initial position in the 4-digit HOX form
+//                   ("7747 7062 ..."), '#' comments.
+//      -o file      Write the results to this file, in JSON.
+//
+//   The positions are searched one after the other, each by a new engine,
+//   without time limit, opening book or randomness: the total of the nodes
+//   is the same on every run, and changes only when the search does.  It
+//   is the signature of a build; the time is its speed.
+/////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include "AIEngineLib.h"
+#include "MatchReferee.h"
+
+#define DEFAULT_DEPTH  5
+
+/* The built-in positions, from games of HaQiKiD against itself. */
+static const char* s_defaultPositions[] =
+{
+    /* Openings (12-14 plies) */
+    "7747 7062 7967 1022 8979 8070 5948 5041 1927 0001 7973 0131",
+    "7747 7062 7967 1022 5948 8070 6665 5041 8979 0001 1927 0131 2625 3136",
+    "7747 1242 4743 4246 1927 4644 0919 7062 4333 0002 4948 0242",
+    "7747 1242 4743 4246 4345 7274 1714 7434 7967 4656 5948 4041 8979 7062",
+    "7747 7242 4743 4246 4948 7062 4344 1215 4838 8081 7967 8131",
+    "7747 7242 4743 4246 1927 4644 1715 7062 1505 1002 0919 0010 1914 6243",
+    "7747 7062 7967 8081 1727 8171 2723 7121 2363 2126 1907 2606",
+    "7747 7062 7967 8081 5948 1022 8979 7271 1927 5041 1715 1214 7972 6042",
+    "2947 7062 1907 5041 3948 6042 0939 8050 7967 1002 6665 1222",
+    "2947 7062 1938 6042 7967 1002 7773 7271 3948 5041 2625 8050 0939 1232",
+    /* Middlegames (40-44 plies) */
+    "7747 7062 7967 1022 8979 8070 5948 5041 1927 0001 7973 0131 1707 6364 "
+    "0919 1202 1912 3138 2625 3828 2735 2825 3554 6254 1222 6042 4743 6465 "
+    "7374 6566 6759 5462 4363 2529 6947 2924 7424 2324 6373 7050",
+    "7747 7062 7967 1022 5948 8070 6665 5041 8979 0001 1927 0131 2625 3136 "
+    "1707 3626 0919 1202 1917 2625 7973 2565 1715 6564 2735 0206 1505 0636 "
+    "0506 3638 0727 3818 0603 6467 2767 2203 6762 0324 6222 1812 3543 2443",
+    "7747 1242 4743 4246 1927 4644 0919 7062 4333 0002 4948 0242 4838 4232 "
+    "1713 2324 3337 7277 1917 8070 1314 4449 8988 4941 8848 6042 4868 7727 "
+    "1727 1022 1413 7079 2625 2425 2725 7977 3948 4131 3839 3137 2947 2234 "
+    "1317 3446",
+    "7747 1242 4743 4246 4345 7274 1714 7434 7967 4656 5948 4041 8979 7062 "
+    "7971 5651 7174 3464 1444 4131 0907 0002 6665 6467 0737 0232 4434 3234 "
+    "7434 3141 3767 1002 6757 0221 3444 2142 5752 4140 4442 5141",
+    "7747 7242 4743 4246 4948 7062 4344 1215 4838 8081 7967 8131 1737 4645 "
+    "1907 1517 6748 1022 8979 0010 7972 3132 4856 2324 7275 4546 0919 4041 "
+    "7571 4142 4474 5041 5644 3233 7473 6364 7172 4152 7262 3373 4452 7378",
+    "7747 7242 4743 4246 1927 4644 1715 7062 1505 1002 0919 0010 1914 6243 "
+    "1444 1242 4448 4248 3948 4335 2746 8070 7967 2324 2625 2425 4625 1019 "
+    "0535 1929 3539 2925 8979 7079 6779 5041 7967 2545 3936 6042 3646 0223 "
+    "8685 2335",
+    "7747 7062 7967 8081 1727 8171 2723 7121 2363 2126 1907 2606 6360 5041 "
+    "8979 1002 5948 0616 4743 6243 7972 0010 7270 4351 6061 4150 7080 2042 "
+    "6160 4041 8083 5163 6080 1613 6665 1222 6755 6351 8384 1333",
+    "7747 7062 7967 8081 5948 1022 8979 7271 1927 5041 1715 1214 7972 6042 "
+    "1585 1484 7262 0010 2625 7174 6263 7464 6788 8171 6383 8474 4743 2243 "
+    "8343 7479 6947 7989 4345 7179 4859 8959 4769 6469 8869 7969 8565 6979",
+    "2947 7062 1907 5041 3948 6042 0939 8050 7967 1002 6665 1222 6775 0010 "
+    "7563 5056 7767 7276 4645 7626 1727 1017 0719 2624 8979 1715 6382 1545 "
+    "8261 4050 7970 5051 6564 5666 7073 4264 7353 2252 5363 6281 6764 6656 "
+    "1938 2444",
+    "2947 7062 1938 6042 7967 1002 7773 7271 3948 5041 2625 8050 0939 1232 "
+    "3826 0010 1727 1016 3936 2324 7375 1619 4839 1917 2729 2425 2925 6364 "
+    "5948 6254 7555 7151 5551 5051 8979 5150 2555 5462 7975 1716",
+    /* Late middlegames and endgames (80-88 plies) */
+    "7747 7062 7967 1022 8979 8070 5948 5041 1927 0001 7973 0131 1707 6364 "
+    "0919 1202 1912 3138 2625 3828 2735 2825 3554 6254 1222 6042 4743 6465 "
+    "7374 6566 6759 5462 4363 2529 6947 2924 7424 2324 6373 7050 2223 6254 "
+    "4645 0206 4544 5475 2303 7556 0708 0636 0363 3646 4443 7252 4342 2042 "
+    "6343 4616 4342 1618 7353 5668 5358 1810 0818 6667 4243 5202 4383 5056 "
+    "8363 0252 6367 5258 1819 6889 6787 2425 4725 5636",
+    "7747 7062 7967 1022 5948 8070 6665 5041 8979 0001 1927 0131 2625 3136 "
+    "1707 3626 0919 1202 1917 2625 7973 2565 1715 6564 2735 0206 1505 0636 "
+    "0506 3638 0727 3818 0603 6467 2767 2203 6762 0324 6222 1812 3543 2443 "
+    "4743 6042 2272 7072 7383 7252 8380 5250 8050 4050 4645 1222 6947 6364 "
+    "4544 6465 8685 6555 8584 2324 8483 2425 8373 2526 7372 2627 7271 2221 "
+    "4454 2171 5453 7176 5363 7646 6362 2737 6261 5556 4959 3738",
+    "7747 1242 4743 4246 1927 4644 0919 7062 4333 0002 4948 0242 4838 4232 "
+    "1713 2324 3337 7277 1917 8070 1314 4449 8988 4941 8848 6042 4868 7727 "
+    "1727 1022 1413 7079 2625 2425 2725 7977 3948 4131 3839 3137 2947 2234 "
+    "1317 3446 2523 7776 6858 5041 3949 3733 6665 4634 5854 3343 5444 7686 "
+    "1737 3446 4445 3236 2303 8656 0323 8384 0605 8485 0504 8575 0403 5653 "
+    "3717 7565 1713 6555 4544 3634 4434 4634 1343 6243 2333 3426 3336 2614",
+    "7747 7242 4743 4246 1927 4644 1715 7062 1505 1002 0919 0010 1914 6243 "
+    "1444 1242 4448 4248 3948 4335 2746 8070 7967 2324 2625 2425 4625 1019 "
+    "0535 1929 3539 2925 8979 7079 6779 5041 7967 2545 3936 6042 3646 0223 "
+    "8685 2335 6665 4565 6779 3516 4636 6569 7987 6965 3638 6535 3837 1628 "
+    "4939 6364 8584 8384 0605 8485 0504 8586 8768 0304 3738 2816 6847 3533 "
+    "4766 3323 3949 2329 4839 2928 4948 1624 6654 2436",
+    "7747 7062 7967 8081 1727 8171 2723 7121 2363 2126 1907 2606 6360 5041 "
+    "8979 1002 5948 0616 4743 6243 7972 0010 7270 4351 6061 4150 7080 2042 "
+    "6160 4041 8083 5163 6080 1613 6665 1222 6755 6351 8384 1333 8434 3353 "
+    "3432 5355 3222 4220 8030 5143 2228 2042 3037 5565 2947 6505 4645 0504 "
+    "4729 1016 2825 0424 2515 1646 2947 4140 0919 4364 1512 4220 4765 5041 "
+    "3747 4666 6987 6646 1282 4030 8280 3031 1911 2421 1114 6443",
+    "2947 7062 1907 5041 3948 6042 0939 8050 7967 1002 6665 1222 6775 0010 "
+    "7563 5056 7767 7276 4645 7626 1727 1017 0719 2624 8979 1715 6382 1545 "
+    "8261 4050 7970 5051 6564 5666 7073 4264 7353 2252 5363 6281 6764 6656 "
+    "1938 2444 6353 5653 6153 4555 3846 5553 2720 5356 3936 5242 3626 4424 "
+    "2024 4246 2454 5654 2646 5464 4643 5150 4342 6462 4243 2324 4383 8160 "
+    "8343 6232 8685 6052 8584 5264 4363 6456 6360 5051 6063 0223 8483 2344 "
+    "6361 5150",
+    "2947 7062 1938 6042 7967 1002 7773 7271 3948 5041 2625 8050 0939 1232 "
+    "3826 0010 1727 1016 3936 2324 7375 1619 4839 1917 2729 2425 2925 6364 "
+    "5948 6254 7555 7151 5551 5051 8979 5150 2555 5462 7975 1716 6665 6465 "
+    "7565 0223 5559 5058 6525 2344 3634 5856 4645 4463 2638 5666 6779 6355 "
+    "7987 6686 3433 6274 2523 5547 6947 8687 4769 8767 3343 6769 4544 6964 "
+    "5954 7466 4353 1636 2333 3633 5333 6654 4454 6454 3383 5444 8303 4264 "
+    "0353 3222 3817 2242",
+    "2625 2324 2524 7062 5948 1002 1907 7276 7967 5041 2434 1242 0919 0010 "
+    "6665 7606 1712 8070 8979 6281 7771 4262 7172 4152 1262 1019 0719 8162 "
+    "7273 6364 6564 6281 7371 5241 6755 0686 1927 8689 5563 8985 6351 7080 "
+    "6463 2042 7170 6082 5143 0223 3433 2331 7973 8589 6947 3112 3323 1231 "
+    "4335 3112 3554 4264 2735 1224 5433 2436 6362 3628 4959 4132 3352 4050 "
+    "7030 8260 7383 3241 3020 4152 6252 5040 2028 8979",
+    "2625 2324 1747 5041 4743 7242 2524 7062 4344 6243 2434 4244 3444 4324 "
+    "1907 1242 7747 4246 5948 1022 7967 4645 6746 0010 0908 1016 0828 6042 "
+    "4745 2445 4625 2214 2513 8070 1321 4050 6947 1656 8959 5659 4859 7072 "
+    "3948 4566 2825 7252 2515 1402 1512 6687 0726 8768 4939 5256 2618 5636 "
+    "1837 4224 2113 6856 1272 5040 7270 4150 4434 0223 3424 5637 4837 3637 "
+    "3949 2342 5948 3733 2414 4234 1334 3334 1413 6364 7073 5041",
+    "1927 7062 3948 1002 2625 5041 7747 6364 2735 6042 7967 8050 8979 7282 "
+    "3543 6254 0908 5466 0838 1232 4322 6647 6947 0210 1711 0002 2210 0212 "
+    "1101 1211 7973 1101 1022 0131 7323 5056 2343 3121 2203 6465 0324 3222 "
+    "3833 6566 6779 2225 2445 2522 7987 6667 4553 8286 5361 5651 4383 5161 "
+    "8386 2111 8680 4260 8775 1114 3363 1464 6323 2242 8070 6768 4645 4282 "
+    "7587 8212 8775 1219 2907 2042 2343 6424 0725 6162 4544 1914 7554 6261",
+    NULL
+};
+
+//-----------------------------------------------------------------------------
+//
+//                                  Types
+//
+//-----------------------------------------------------------------------------
+
+typedef std::vector<AIMove> Position;  // The moves from the initial position.
+
+/* The search of one position. */
+struct Result
+{
+    Result() : rc( hoxAI_RC_ERR ), move( hoxAI_MOVE_NONE ), ms( 0 ) {}
+
+    int           rc;    // Of benchSearch().
+    AIMove        move;
+    double        ms;
+    AISearchInfo  info;
+};
+
+//-----------------------------------------------------------------------------
+//
+//                              Bench state
+//
+//-----------------------------------------------------------------------------
+
+static std::string              s_name;        // Of the plugin.
+static PICreateAIEngineLibFunc  s_createFunc = NULL;
+static std::vector<Position>    s_positions;
+static int                      s_depth      = DEFAULT_DEPTH;
+static FILE*                    s_report     = NULL;  // The real stdout.
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+
+static double
+_now_ms()
+{
+    struct timeval t;
+    ::gettimeofday( &t, NULL );
+    return t.tv_sec * 1000.0 + t.tv_usec / 1000.0;
+}
+
+static std::string
+_move_text( AIMove move )
+{
+    if ( move == hoxAI_MOVE_NONE ) return "none";
+
+    char szMove[5];
+    AIMoveToString( move, szMove );
+    return szMove;
+}
+
+/* A position must be reached by legal moves, and not be over. */
+static bool
+_parse_position( const std::string& line, Position& position )
+{
+    std::istringstream in( line );
+    std::string        sMove;
+    MatchReferee       referee;
+    while ( in >> sMove )
+    {
+        const AIMove move = ( sMove.size() == 4 ? AIMoveFromString( sMove.c_str() )
+                                                : hoxAI_MOVE_NONE );
+        if ( move == hoxAI_MOVE_NONE || ! referee.Play( move ) ) return false;
+        position.push_back( move );
+    }
+    return referee.HasLegalMove();
+}
+
+static bool
+_load_positions( const char* szFile )
+{
+    if ( szFile == NULL )
+    {
+        for ( int i = 0; s_defaultPositions[i] != NULL; ++i )
+        {
+            Position position;
+            if ( ! _parse_position( s_defaultPositions[i], position ) )
+            {
+                fprintf(stderr, "AI_bench: Bad built-in position %d.\n", i + 1);
+                return false;
+            }
+            s_positions.push_back( position );
+        }
+        return true;
+    }
+
+    std::ifstream in( szFile );
+    if ( ! in )
+    {
+        fprintf(stderr, "AI_bench: Cannot read [%s].\n", szFile);
+        return false;
+    }
+    std::string line;
+    int         lineNo = 0;
+    while ( std::getline( in, line ) )
+    {
+        ++lineNo;
+        const std::string::size_type comment = line.find( '#' );
+        if ( comment != std::string::npos ) line.erase( comment );
+        if ( line.find_first_not_of( " \t\r" ) == std::string::npos ) continue;
+
+        Position position;
+        if ( ! _parse_position( line, position ) )
+        {
+            fprintf(stderr, "AI_bench: Bad position at %s:%d.\n", szFile, lineNo);
+            return false;
+        }
+        s_positions.push_back( position );
+    }
+    if ( s_positions.empty() )
+    {
+        fprintf(stderr, "AI_bench: No position in [%s].\n", szFile);
+        return false;
+    }
+    return true;
+}
+
+static bool
+_load_plugin( const char* szPath )
+{
+    /* The name is the file name without its extension. */
+    std::string name = szPath;
+    const std::string::size_type slash = name.rfind( '/' );
+    if ( slash != std::string::npos ) name.erase( 0, slash + 1 );
+    const std::string::size_type dot = name.find( '.' );
+    if ( dot != std::string::npos && dot > 0 ) name.erase( dot );
+    s_name = name;
+
+    void* handle = ::dlopen( szPath, RTLD_NOW );
+    if ( handle == NULL )
+    {
+        fprintf(stderr, "AI_bench: %s\n", ::dlerror());
+        return false;
+    }
+    s_createFunc = (PICreateAIEngineLibFunc) ::dlsym( handle, "CreateAIEngineLib" );
+    if ( s_createFunc == NULL )
+    {
+        fprintf(stderr, "AI_bench: No 'CreateAIEngineLib' in [%s].\n", szPath);
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Searching
+// ----------------------------------------------------------------------------
+
+static Result
+_search( const Position& position )
+{
+    Result result;
+
+    AIEngineLib* engine = s_createFunc();
+    if ( engine == NULL ) return result;
+
+    /* NOTE: The moves are given one by one since some engines (MaxQi,
+     *       TSITO) ignore those given to initGame().
+     */
+    engine->initEngine();
+    if ( engine->initGameBinary( NULL, NULL, 0 ) == hoxAI_RC_OK )
+    {
+        for ( Position::const_iterator it = position.begin(); it != position.end(); ++it )
+        {
+            engine->onHumanMoveBinary( *it );
+        }
+
+        const double start = _now_ms();
+        result.rc = engine->benchSearch( s_depth, result.move, result.info );
+        result.ms = _now_ms() - start;
+    }
+
+    engine->destroy();
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Report
+// ----------------------------------------------------------------------------
+
+/* The share of 'part' in 'total', or 0. */
+static double
+_rate( unsigned long part, unsigned long total )
+{
+    return ( total ? (double) part / total : 0.0 );
+}
+
+/* The sums over all positions. */
+static void
+_sum( const std::vector<Result>& results,
+      AISearchInfo&              total,
+      double&                    ms )
+{
+    ms = 0;
+    for ( size_t i = 0; i < results.size(); ++i )
+    {
+        const AISearchInfo& info = results[i].info;
+        total.nodes       += info.nodes;
+        total.hashProbes  += info.hashProbes;
+        total.hashHits    += info.hashHits;
+        total.hashCutoffs += info.hashCutoffs;
+        total.betaCutoffs += info.betaCutoffs;
+        total.nullCutoffs += info.nullCutoffs;
+        ms                += results[i].ms;
+    }
+}
+
+static void
+_report( const std::vector<Result>& results )
+{
+    AISearchInfo total;
+    double       ms = 0;
+    _sum( results, total, ms );
+
+    fprintf(s_report, "%s, depth %d, %lu positions\n",
+        s_name.c_str(), s_depth, (unsigned long) results.size());
+    fprintf(s_report, "  nodes          %lu\n", total.nodes);
+    fprintf(s_report, "  time           %.0f ms\n", ms);
+    fprintf(s_report, "  nps            %.0f\n", ( ms > 0 ? 1000.0 * total.nodes / ms : 0.0 ));
+    fprintf(s_report, "  hash hits      %.1f%% of %lu probes\n",
+        100 * _rate( total.hashHits, total.hashProbes ), total.hashProbes);
+    fprintf(s_report, "  hash cutoffs   %lu\n", total.hashCutoffs);
+    fprintf(s_report, "  beta cutoffs   %lu\n", total.betaCutoffs);
+    fprintf(s_report, "  null cutoffs   %lu\n", total.nullCutoffs);
+    fflush( s_report );
+}
+
+static bool
+_write_json( const char* szFile, const std::vector<Result>& results )
+{
+    FILE* out = ::fopen( szFile, "w" );
+    if ( out == NULL )
+    {
+        fprintf(stderr, "AI_bench: Cannot write [%s].\n", szFile);
+        return false;
+    }
+
+    AISearchInfo total;
+    double       ms = 0;
+    _sum( results, total, ms );
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"engine\": \"%s\",\n", s_name.c_str());
+    fprintf(out, "  \"depth\": %d,\n", s_depth);
+    fprintf(out, "  \"positions\": %lu,\n", (unsigned long) results.size());
+    fprintf(out, "  \"nodes\": %lu,\n", total.nodes);
+    fprintf(out, "  \"ms\": %.1f,\n", ms);
+    fprintf(out, "  \"nps\": %.0f,\n", ( ms > 0 ? 1000.0 * total.nodes / ms : 0.0 ));
+    fprintf(out, "  \"hashProbes\": %lu,\n", total.hashProbes);
+    fprintf(out, "  \"hashHits\": %lu,\n", total.hashHits);
+    fprintf(out, "  \"hashHitRate\": %.4f,\n", _rate( total.hashHits, total.hashProbes ));
+    fprintf(out, "  \"hashCutoffs\": %lu,\n", total.hashCutoffs);
+    fprintf(out, "  \"betaCutoffs\": %lu,\n", total.betaCutoffs);
+    fprintf(out, "  \"nullCutoffs\": %lu,\n", total.nullCutoffs);
+    fprintf(out, "  \"results\": [\n");
+    for ( size_t i = 0; i < results.size(); ++i )
+    {
+        const Result& result = results[i];
+        fprintf(out, "    { \"position\": %lu, \"move\": \"%s\", \"depth\": %d,"
+                     " \"nodes\": %lu, \"ms\": %.1f, \"hashProbes\": %lu,"
+                     " \"hashHits\": %lu, \"hashCutoffs\": %lu,"
+                     " \"betaCutoffs\": %lu, \"nullCutoffs\": %lu }%s\n",
+            (unsigned long) ( i + 1 ), _move_text( result.move ).c_str(),
+            result.info.depth, result.info.nodes, result.ms,
+            result.info.hashProbes, result.info.hashHits, result.info.hashCutoffs,
+            result.info.betaCutoffs, result.info.nullCutoffs,
+            ( i + 1 < results.size() ? "," : "" ));
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+    ::fclose( out );
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Setup
+// ----------------------------------------------------------------------------
+
+static void
+_usage()
+{
+    fprintf(stderr, "Usage: AI_bench [-d depth] [-s positions] [-o json] <plugin>\n");
+}
+
+int main( int argc, char** argv )
+{
+    const char* szPositions = NULL;
+    const char* szJson      = NULL;
+
+    int opt;
+    while ( (opt = ::getopt( argc, argv, "d:s:o:" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'd': s_depth     = ::atoi( optarg ); break;
+            case 's': szPositions = optarg;           break;
+            case 'o': szJson      = optarg;           break;
+            default:
+                _usage();
+                return 1;
+        }
+    }
+    if ( optind != argc - 1 || s_depth < 1 ) { _usage(); return 1; }
+
+    if (    ! _load_plugin( argv[optind] )
+         || ! _load_positions( szPositions ) )
+    {
+        return 1;
+    }
+
+    /* Keep stdout for the report only: the engines print their traces
+     * to what they think is stdout, which now goes to stderr.
+     */
+    s_report = ::fdopen( ::dup( 1 ), "w" );
+    ::dup2( 2, 1 );
+
+    std::vector<Result> results;
+    for ( size_t i = 0; i < s_positions.size(); ++i )
+    {
+        const Result result = _search( s_positions[i] );
+        if ( result.rc != hoxAI_RC_OK )
+        {
+            fprintf(stderr, "AI_bench: %s cannot search position %lu (%d).\n",
+                s_name.c_str(), (unsigned long) ( i + 1 ), result.rc);
+            return 1;
+        }
+        fprintf(stderr, "AI_bench: Position %lu: %s, depth %d, %lu nodes, %.0f ms.\n",
+            (unsigned long) ( i + 1 ), _move_text( result.move ).c_str(),
+            result.info.depth, result.info.nodes, result.ms);
+        results.push_back( result );
+    }
+
+    _report( results );
+    if ( szJson != NULL && ! _write_json( szJson, results ) ) return 1;
+    return 0;
+}
+
+/************************* END OF FILE ***************************************/
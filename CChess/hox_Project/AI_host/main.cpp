@@ -0,0 +1,508 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            main.cpp
+// Created:         10/19/2026
+//
+// Description:     The Engine Host: runs an AI Engine Plugin in its own
+//                  process and serves it over stdin/stdout with the
+//                  protocol of AIHostProtocol.h.
+//
+//   Usage:  AI_host [-c cpu,cpu,...] [-m megabytes] <plugin>
+//
+//      -c   The CPUs to run the engines on.  The engine of slot N is
+//           pinned to the (N mod count)-th CPU of the list.
+//      -m   The limit of the address space of the whole host.
+//
+//   Each slot has its own engine and thread, so several searches can run
+//   at the same time.  NOTE: Only plugins whose engines do not share
+//   global state (HaQiKiD, MaxQi...) can use more than one slot.  Not
+//   XQWLight (its search is global) nor TSITO (its engines share the
+//   global Options and observe them).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _GNU_SOURCE
+  #define _GNU_SOURCE  // pthread_setaffinity_np()
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <deque>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include "AIHostProtocol.h"
+
+//-----------------------------------------------------------------------------
+//
+//                                  Slots
+//
+//-----------------------------------------------------------------------------
+
+/* Sends the progress of the searches of a slot to the client. */
+struct SlotListener : public AISearchListener
+{
+    int  id;
+    void onSearchProgress( const AISearchProgress& progress );
+};
+
+struct Slot
+{
+    int                      id;
+    AIEngineLib*             engine;
+    SlotListener             listener;
+    pthread_t                thread;
+    bool                     started;  // Has the thread been created?
+    pthread_mutex_t          mutex;
+    pthread_cond_t           cond;
+    std::deque<std::string>  requests; // Frames (without their length).
+    bool                     stop;
+};
+
+static Slot                    s_slots[AI_HOST_MAX_SLOTS];
+static std::vector<int>        s_cpus;        // -c
+static PICreateAIEngineLibFunc s_createFunc = NULL;
+static int                     s_out = -1;    // The protocol's output.
+static pthread_mutex_t         s_outMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// ----------------------------------------------------------------------------
+// Low-level I/O
+// ----------------------------------------------------------------------------
+
+static bool
+_read_all( int fd, char* buf, size_t n )
+{
+    while ( n > 0 )
+    {
+        const ssize_t got = ::read( fd, buf, n );
+        if ( got <= 0 ) return false;  // EOF or error.
+        buf += got;
+        n   -= (size_t) got;
+    }
+    return true;
+}
+
+static void
+_write_frame( AIHostWriter& writer )
+{
+    const std::string& data = writer.data();
+    const char* p = data.data();
+    size_t      n = data.size();
+
+    pthread_mutex_lock( &s_outMutex );
+    while ( n > 0 )
+    {
+        const ssize_t sent = ::write( s_out, p, n );
+        if ( sent <= 0 ) break;  // The client is gone.
+        p += sent;
+        n -= (size_t) sent;
+    }
+    pthread_mutex_unlock( &s_outMutex );
+}
+
+// ----------------------------------------------------------------------------
+// Request handling (on the thread of the slot)
+// ----------------------------------------------------------------------------
+
+void
+SlotListener::onSearchProgress( const AISearchProgress& progress )
+{
+    AIHostWriter frame( AI_HOST_PROGRESS, id );
+    frame.put32( hoxAI_RC_OK );
+    frame.put32( progress.depth );
+    frame.put32( progress.selDepth );
+    frame.put32( progress.score );
+    frame.put32( (int) progress.nodes );
+    frame.put32( (int) progress.msecs );
+    frame.put32( progress.hashFull );
+    frame.put16( progress.pvLength );
+    for ( int i = 0; i < progress.pvLength; ++i ) frame.put16( progress.pv[i] );
+    _write_frame( frame );
+}
+
+static void
+_put_search_info( AIHostWriter& reply, const AISearchInfo& info )
+{
+    reply.put32( info.depth );
+    reply.put32( (int) info.nodes );
+    reply.put32( (int) info.hashProbes );
+    reply.put32( (int) info.hashHits );
+    reply.put32( (int) info.hashCutoffs );
+    reply.put32( (int) info.betaCutoffs );
+    reply.put32( (int) info.nullCutoffs );
+}
+
+static void
+_handle_request( Slot& slot, const std::string& frame )
+{
+    AIHostReader reader( frame.data(), frame.size() );
+    const int command = reader.get8();
+    (void) reader.get8();  // The slot.
+
+    AIHostWriter reply( command, slot.id );
+    AIEngineLib* engine = slot.engine;
+
+    if ( command != AI_HOST_OPEN && engine == NULL )
+    {
+        reply.put32( hoxAI_RC_NOT_FOUND );
+        _write_frame( reply );
+        return;
+    }
+
+    switch ( command )
+    {
+        case AI_HOST_OPEN:
+        {
+            if ( engine == NULL ) slot.engine = s_createFunc();
+            reply.put32( slot.engine ? hoxAI_RC_OK : hoxAI_RC_ERR );
+            break;
+        }
+        case AI_HOST_CLOSE:
+        {
+            engine->destroy();
+            slot.engine = NULL;
+            reply.put32( hoxAI_RC_OK );
+            break;
+        }
+        case AI_HOST_INIT_ENGINE:
+        {
+            engine->initEngine( reader.get32() );
+            reply.put32( hoxAI_RC_OK );
+            break;
+        }
+        case AI_HOST_INIT_GAME:
+        {
+            AIPosition position;
+            const bool bPosition = ( reader.get8() != 0 );
+            if ( bPosition )
+            {
+                reader.getBytes( position.squares, sizeof(position.squares) );
+                position.side = (char) reader.get8();
+            }
+            std::vector<AIMove> moves( (size_t) reader.get16() );
+            for ( size_t i = 0; i < moves.size(); ++i )
+            {
+                moves[i] = (AIMove) reader.get16();
+            }
+            if ( ! reader.ok() )
+            {
+                reply.put32( hoxAI_RC_ERR );
+                break;
+            }
+            reply.put32( engine->initGameBinary( bPosition ? &position : NULL,
+                                                 moves.empty() ? NULL : &moves[0],
+                                                 (int) moves.size() ) );
+            break;
+        }
+        case AI_HOST_GENERATE_MOVE:
+        {
+            const AIMove move = engine->generateMoveBinary();
+            reply.put32( hoxAI_RC_OK );
+            reply.put16( move );
+            break;
+        }
+        case AI_HOST_HUMAN_MOVE:
+        {
+            engine->onHumanMoveBinary( (AIMove) reader.get16() );
+            reply.put32( hoxAI_RC_OK );
+            break;
+        }
+        case AI_HOST_SET_LEVEL:
+        {
+            reply.put32( engine->setDifficultyLevel( reader.get32() ) );
+            break;
+        }
+        case AI_HOST_GET_INFO:
+        {
+            reply.put32( hoxAI_RC_OK );
+            reply.putString( engine->getInfo() );
+            break;
+        }
+        case AI_HOST_LIST_OPTIONS:
+        {
+            AIOptionList options;
+            const int nRet = engine->listOptions( options );
+            reply.put32( nRet );
+            reply.put16( nRet == hoxAI_RC_OK ? (int) options.size() : 0 );
+            if ( nRet != hoxAI_RC_OK ) break;
+            for ( AIOptionList::const_iterator it = options.begin();
+                                               it != options.end(); ++it )
+            {
+                reply.putString( it->name );
+                reply.put8( it->type );
+                reply.putString( it->value );
+                reply.put32( it->minValue );
+                reply.put32( it->maxValue );
+            }
+            break;
+        }
+        case AI_HOST_SET_OPTION:
+        {
+            const std::string name  = reader.getString();
+            const std::string value = reader.getString();
+            reply.put32( reader.ok() ? engine->setOption( name, value )
+                                     : hoxAI_RC_ERR );
+            break;
+        }
+        case AI_HOST_SEARCH_INFO:
+        {
+            AISearchInfo info;
+            reply.put32( engine->getSearchInfo( info ) );
+            _put_search_info( reply, info );
+            break;
+        }
+        case AI_HOST_BENCH:
+        {
+            const int depth = reader.get32();
+            AIMove       move = hoxAI_MOVE_NONE;
+            AISearchInfo info;
+            reply.put32( reader.ok() ? engine->benchSearch( depth, move, info )
+                                     : hoxAI_RC_ERR );
+            reply.put16( move );
+            _put_search_info( reply, info );
+            break;
+        }
+        case AI_HOST_SET_LISTENER:
+        {
+            reply.put32( engine->setSearchListener( reader.get8() ? &slot.listener
+                                                                  : NULL ) );
+            break;
+        }
+        default:
+        {
+            reply.put32( hoxAI_RC_NOT_SUPPORTED );
+        }
+    }
+
+    _write_frame( reply );
+}
+
+static void*
+_slot_thread( void* arg )
+{
+    Slot& slot = *(Slot*) arg;
+
+#ifdef __linux__
+    if ( ! s_cpus.empty() )
+    {
+        cpu_set_t cpus;
+        CPU_ZERO( &cpus );
+        CPU_SET( s_cpus[slot.id % s_cpus.size()], &cpus );
+        if ( pthread_setaffinity_np( pthread_self(), sizeof(cpus), &cpus ) != 0 )
+        {
+            fprintf(stderr, "AI_host: Failed to pin slot %d to CPU %d.\n",
+                slot.id, s_cpus[slot.id % s_cpus.size()]);
+        }
+    }
+#endif
+
+    for (;;)
+    {
+        pthread_mutex_lock( &slot.mutex );
+        while ( slot.requests.empty() && ! slot.stop )
+        {
+            pthread_cond_wait( &slot.cond, &slot.mutex );
+        }
+        if ( slot.requests.empty() )  // ... and stopping.
+        {
+            pthread_mutex_unlock( &slot.mutex );
+            break;
+        }
+        const std::string frame = slot.requests.front();
+        slot.requests.pop_front();
+        pthread_mutex_unlock( &slot.mutex );
+
+        _handle_request( slot, frame );
+    }
+
+    if ( slot.engine )
+    {
+        slot.engine->destroy();
+        slot.engine = NULL;
+    }
+    return NULL;
+}
+
+static bool
+_post_request( int id, const std::string& frame )
+{
+    Slot& slot = s_slots[id];
+
+    if ( ! slot.started )
+    {
+        if ( pthread_create( &slot.thread, NULL, _slot_thread, &slot ) != 0 )
+        {
+            return false;
+        }
+        slot.started = true;
+    }
+
+    pthread_mutex_lock( &slot.mutex );
+    slot.requests.push_back( frame );
+    pthread_cond_signal( &slot.cond );
+    pthread_mutex_unlock( &slot.mutex );
+    return true;
+}
+
+static void
+_stop_all_slots()
+{
+    for ( int i = 0; i < AI_HOST_MAX_SLOTS; ++i )
+    {
+        Slot& slot = s_slots[i];
+        if ( ! slot.started ) continue;
+
+        pthread_mutex_lock( &slot.mutex );
+        slot.stop = true;
+        pthread_cond_signal( &slot.cond );
+        pthread_mutex_unlock( &slot.mutex );
+
+        pthread_join( slot.thread, NULL );  // After its pending requests.
+        slot.started = false;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Setup
+// ----------------------------------------------------------------------------
+
+static bool
+_parse_cpus( const char* szList )
+{
+    const char* p = szList;
+    while ( *p )
+    {
+        char* end = NULL;
+        const long cpu = ::strtol( p, &end, 10 );
+        if ( end == p || cpu < 0 ) return false;
+        s_cpus.push_back( (int) cpu );
+        p = ( *end == ',' ? end + 1 : end );
+        if ( *end != ',' && *end != '\0' ) return false;
+    }
+    return ! s_cpus.empty();
+}
+
+static bool
+_limit_memory( long nMegabytes )
+{
+    struct rlimit limit;
+    limit.rlim_cur = limit.rlim_max = (rlim_t) nMegabytes << 20;
+    return ( ::setrlimit( RLIMIT_AS, &limit ) == 0 );
+}
+
+static void
+_usage()
+{
+    fprintf(stderr, "Usage: AI_host [-c cpu,cpu,...] [-m megabytes] <plugin>\n");
+}
+
+int main( int argc, char** argv )
+{
+    int opt;
+    while ( (opt = ::getopt( argc, argv, "c:m:" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'c':
+                if ( ! _parse_cpus( optarg ) ) { _usage(); return 1; }
+                break;
+            case 'm':
+                if ( ! _limit_memory( ::atol( optarg ) ) )
+                {
+                    fprintf(stderr, "AI_host: Failed to limit the memory to [%s] MB.\n", optarg);
+                    return 1;
+                }
+                break;
+            default:
+                _usage();
+                return 1;
+        }
+    }
+    if ( optind != argc - 1 ) { _usage(); return 1; }
+
+    const char* szPlugin = argv[optind];
+    void* handle = ::dlopen( szPlugin, RTLD_NOW );
+    if ( handle == NULL )
+    {
+        fprintf(stderr, "AI_host: %s\n", ::dlerror());
+        return 1;
+    }
+    s_createFunc = (PICreateAIEngineLibFunc) ::dlsym( handle, "CreateAIEngineLib" );
+    if ( s_createFunc == NULL )
+    {
+        fprintf(stderr, "AI_host: No 'CreateAIEngineLib' in [%s].\n", szPlugin);
+        return 1;
+    }
+
+    /* Keep stdout for the protocol only: the engines print their traces
+     * to what they think is stdout, which now goes to stderr.
+     */
+    s_out = ::dup( 1 );
+    ::dup2( 2, 1 );
+
+    for ( int i = 0; i < AI_HOST_MAX_SLOTS; ++i )
+    {
+        s_slots[i].id      = i;
+        s_slots[i].engine  = NULL;
+        s_slots[i].started = false;
+        s_slots[i].stop    = false;
+        s_slots[i].listener.id = i;
+        pthread_mutex_init( &s_slots[i].mutex, NULL );
+        pthread_cond_init( &s_slots[i].cond, NULL );
+    }
+
+    /* Dispatch the requests to the slots until QUIT (or EOF). */
+
+    unsigned char header[4];
+    std::string   frame;
+    while ( _read_all( 0, (char*) header, sizeof(header) ) )
+    {
+        const size_t length = AIHostFrameLength( header );
+        if ( length < 2 || length > AI_HOST_MAX_FRAME )
+        {
+            fprintf(stderr, "AI_host: Bad frame length [%lu].\n", (unsigned long) length);
+            break;
+        }
+        frame.resize( length );
+        if ( ! _read_all( 0, &frame[0], length ) ) break;
+
+        const int command = (unsigned char) frame[0];
+        const int slot    = (unsigned char) frame[1];
+        if ( command == AI_HOST_QUIT ) break;
+
+        if ( slot >= AI_HOST_MAX_SLOTS || ! _post_request( slot, frame ) )
+        {
+            AIHostWriter reply( command, slot );
+            reply.put32( hoxAI_RC_ERR );
+            _write_frame( reply );
+        }
+    }
+
+    _stop_all_slots();
+    return 0;
+}
+
+/************************* END OF FILE ***************************************/
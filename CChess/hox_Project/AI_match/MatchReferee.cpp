@@ -0,0 +1,248 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            MatchReferee.cpp
+// Created:         10/19/2026
+//
+// Description:     The referee of the match runner.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "MatchReferee.h"
+#include <cstdlib>   // abs()
+#include <cctype>
+
+/* The board of hoxReferee.cpp: the square of (x, y) is 9 * y + x, where
+ * x is the column [0-8] and y the row [0-9] with Black at the top. */
+
+static inline int  _X( int sq )       { return sq % 9; }
+static inline int  _Y( int sq )       { return sq / 9; }
+static inline bool _IsRed( char p )   { return isupper( (unsigned char) p ) != 0; }
+
+static bool
+_IsInsidePalace( bool red, int sq )
+{
+    const int x = _X(sq), y = _Y(sq);
+    return ( x >= 3 && x <= 5 ) && ( red ? ( y >= 7 ) : ( y <= 2 ) );
+}
+
+/* The # of pieces strictly between two squares of the same row or column. */
+static int
+_CountBetween( const char* b, int from, int to )
+{
+    const int step = ( _Y(from) == _Y(to) ) ? ( to > from ? 1 : -1 )
+                                            : ( to > from ? 9 : -9 );
+    int count = 0;
+    for ( int sq = from + step; sq != to; sq += step )
+    {
+        if ( b[sq] ) ++count;
+    }
+    return count;
+}
+
+/**
+ * Does the piece on 'from' move (or capture) to 'to' by its own rules?
+ * The safety of the own King is not checked.
+ */
+static bool
+_CanMove( const char* b, int from, int to )
+{
+    const char piece = b[from];
+    if ( piece == 0 || from == to ) return false;
+
+    const bool red = _IsRed( piece );
+    if ( b[to] && _IsRed( b[to] ) == red ) return false;  // Own piece.
+
+    const int dx = _X(to) - _X(from);
+    const int dy = _Y(to) - _Y(from);
+    const int ax = abs(dx), ay = abs(dy);
+
+    switch ( toupper( (unsigned char) piece ) )
+    {
+        case 'K':
+            return ( ax + ay == 1 ) && _IsInsidePalace( red, to );
+
+        case 'A':
+            return ( ax == 1 && ay == 1 ) && _IsInsidePalace( red, to );
+
+        case 'E':
+            return ( ax == 2 && ay == 2 )
+                && b[ (from + to) / 2 ] == 0                   // The eye.
+                && ( red ? _Y(to) >= 5 : _Y(to) <= 4 );        // The river.
+
+        case 'H':
+            if ( ax == 2 && ay == 1 ) return b[ from + dx / 2 ] == 0;     // The leg.
+            if ( ax == 1 && ay == 2 ) return b[ from + 9 * (dy / 2) ] == 0;
+            return false;
+
+        case 'R':
+            return ( dx == 0 || dy == 0 ) && _CountBetween( b, from, to ) == 0;
+
+        case 'C':
+            return ( dx == 0 || dy == 0 )
+                && _CountBetween( b, from, to ) == ( b[to] ? 1 : 0 );
+
+        case 'P':
+        {
+            const int  forward = ( red ? -1 : 1 );
+            const bool crossed = ( red ? _Y(from) <= 4 : _Y(from) >= 5 );
+            return ( dx == 0 && dy == forward )
+                || ( crossed && ax == 1 && dy == 0 );
+        }
+    }
+    return false;
+}
+
+static bool
+_IsAttacked( const char* b, int square, bool byRed )
+{
+    for ( int sq = 0; sq < 90; ++sq )
+    {
+        if ( b[sq] && _IsRed( b[sq] ) == byRed && _CanMove( b, sq, square ) )
+            return true;
+    }
+    return false;
+}
+
+/* Is the King of a side neither attacked nor facing the other King? */
+static bool
+_IsKingSafe( const char* b, bool red )
+{
+    int king = -1, other = -1;
+    for ( int sq = 0; sq < 90; ++sq )
+    {
+        if      ( b[sq] == ( red ? 'K' : 'k' ) ) king  = sq;
+        else if ( b[sq] == ( red ? 'k' : 'K' ) ) other = sq;
+    }
+    if ( king == -1 ) return false;
+
+    if (    other != -1 && _X(king) == _X(other)
+         && _CountBetween( b, king, other ) == 0 )
+    {
+        return false;  // The Kings face each other.
+    }
+    return ! _IsAttacked( b, king, ! red );
+}
+
+//-----------------------------------------------------------------------------
+// MatchReferee
+//-----------------------------------------------------------------------------
+
+MatchReferee::MatchReferee()
+        : m_pliesSinceCapture( 0 )
+{
+    AIPositionFromFEN( "rheakaehr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RHEAKAEHR w",
+                       m_position );
+    m_keys.push_back( _Key() );
+}
+
+bool
+MatchReferee::Play( AIMove move )
+{
+    const int from = AIMoveFrom( move );
+    const int to   = AIMoveTo( move );
+    if ( ! _IsLegal( from, to ) ) return false;
+
+    const bool bCapture = ( m_position.squares[to] != 0 );
+    m_position.squares[to]   = m_position.squares[from];
+    m_position.squares[from] = 0;
+    m_position.side = ( m_position.side == 'w' ? 'b' : 'w' );
+
+    if ( bCapture )
+    {
+        m_pliesSinceCapture = 0;
+        m_keys.clear();  // No earlier position can come back.
+    }
+    else
+    {
+        ++m_pliesSinceCapture;
+    }
+    m_keys.push_back( _Key() );
+    return true;
+}
+
+bool
+MatchReferee::IsLegal( AIMove move ) const
+{
+    return _IsLegal( AIMoveFrom( move ), AIMoveTo( move ) );
+}
+
+bool
+MatchReferee::HasLegalMove() const
+{
+    const bool red = ( m_position.side == 'w' );
+    for ( int from = 0; from < 90; ++from )
+    {
+        const char piece = m_position.squares[from];
+        if ( piece == 0 || _IsRed( piece ) != red ) continue;
+
+        for ( int to = 0; to < 90; ++to )
+        {
+            if ( _IsLegal( from, to ) ) return true;
+        }
+    }
+    return false;
+}
+
+bool
+MatchReferee::InCheck() const
+{
+    return ! _IsKingSafe( m_position.squares, m_position.side == 'w' );
+}
+
+int
+MatchReferee::RepetitionCount() const
+{
+    const std::string& current = m_keys.back();
+    int count = 0;
+    for ( std::vector<std::string>::const_iterator it = m_keys.begin();
+                                                   it != m_keys.end(); ++it )
+    {
+        if ( *it == current ) ++count;
+    }
+    return count;
+}
+
+bool
+MatchReferee::_IsLegal( int from, int to ) const
+{
+    if ( from < 0 || from >= 90 || to < 0 || to >= 90 ) return false;
+
+    const char piece = m_position.squares[from];
+    const bool red   = ( m_position.side == 'w' );
+    if ( piece == 0 || _IsRed( piece ) != red ) return false;
+    if ( ! _CanMove( m_position.squares, from, to ) ) return false;
+
+    char b[90];
+    for ( int i = 0; i < 90; ++i ) b[i] = m_position.squares[i];
+    b[to]   = b[from];
+    b[from] = 0;
+    return _IsKingSafe( b, red );
+}
+
+std::string
+MatchReferee::_Key() const
+{
+    std::string key( m_position.squares, sizeof(m_position.squares) );
+    key += m_position.side;
+    return key;
+}
+
+/************************* END OF FILE ***************************************/
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            MatchReferee.h
+// Created:         10/19/2026
+//
+// Description:     The referee of the match runner.  It applies the same
+//                  rules as the client's hoxReferee, without wxWidgets.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_MATCH_REFEREE_H__
+#define __INCLUDED_MATCH_REFEREE_H__
+
+#include <string>
+#include <vector>
+#include "AIEngineLib.h"
+
+/**
+ * Keeps the state of one game and validates its moves.  The board is an
+ * AIPosition (FEN letters, row 0 being Black's back rank), so it can be
+ * handed to the engines as is.
+ *
+ * A side without a legal move loses, in check or not.  Repetitions and
+ * long runs without a capture are only counted: what to make of them is
+ * left to the caller.
+ */
+class MatchReferee
+{
+public:
+    MatchReferee();  /* The initial position, Red to move. */
+
+    bool Play( AIMove move );
+        /* Plays a move of the side to move.  Returns false (and changes
+         * nothing) if the move is not legal. */
+
+    bool IsLegal( AIMove move ) const;
+    bool HasLegalMove() const;
+    bool InCheck() const;  /* Is the side to move in check? */
+
+    char Side() const { return m_position.side; }  /* 'w' (Red) or 'b' */
+    const AIPosition& Position() const { return m_position; }
+
+    int  RepetitionCount() const;
+        /* How many times the current position has occurred (1 if new). */
+
+    int  PliesSinceCapture() const { return m_pliesSinceCapture; }
+
+private:
+    bool        _IsLegal( int from, int to ) const;
+    std::string _Key() const;
+
+private:
+    AIPosition                m_position;
+    int                       m_pliesSinceCapture;
+    std::vector<std::string>  m_keys;  /* The positions since the last capture. */
+};
+
+#endif /* __INCLUDED_MATCH_REFEREE_H__ */
@@ -0,0 +1,640 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            main.cpp
+// Created:         10/19/2026
+//
+// Description:     The Match Runner: plays games between two AI Engine
+//                  Plugins, without any UI, and reports the results and
+//                  the speed of the engines.
+//
+//   Usage:  AI_match [options] <plugin-1> <plugin-2>
+//
+//      -n games     The # of games (default: each opening with both colors).
+//      -j threads   The # of games played at the same time (default: 1).
+//                   Forced to 1 for a plugin that is not reentrant.
+//      -l level     The difficulty level of both engines (default: 3).
+//      -p plies     Adjudicate a draw after so many plies (default: 300).
+//      -s file      The opening suite: one opening per line, as moves in
+//                   the 4-digit HOX form ("7747 7062 ..."), '#' comments.
+//      -o file      Write the games to this file, in a PGN-like form.
+//
+//   Game N plays the opening (N / 2) of the suite, with plugin-1 as Red
+//   when N is even, as Black when it is odd.
+//
+//   Each game creates its own engines.  NOTE: A plugin whose engines share
+//   global state (XQWLight's search, TSITO's Options) is played with one
+//   thread, and cannot play against itself.
+/////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include "AIEngineLib.h"
+#include "MatchReferee.h"
+
+#define DEFAULT_LEVEL        3
+#define DEFAULT_MAX_PLIES  300
+#define MAX_QUIET_PLIES    120  /* 60 moves by each side without a capture */
+
+/* The built-in opening suite. */
+static const char* s_defaultOpenings[] =
+{
+    "7747 7062 7967 1022",       /* Central Cannon vs. Screen Horses  */
+    "7747 1242",                 /* Same Direction Cannons            */
+    "7747 7242",                 /* Opposite Direction Cannons        */
+    "7747 7062 7967 8081",       /* Central Cannon vs. Early Chariot  */
+    "2947 7062",                 /* Elephant Opening                  */
+    "2625 2324",                 /* Pawn Opening                      */
+    "1927 7062",                 /* Horse Opening                     */
+    "1747 7062 1927 2324",       /* Left Central Cannon               */
+    NULL
+};
+
+//-----------------------------------------------------------------------------
+//
+//                                  Types
+//
+//-----------------------------------------------------------------------------
+
+typedef std::vector<AIMove> Opening;
+
+struct Player
+{
+    std::string              path;
+    std::string              name;
+    PICreateAIEngineLibFunc  createFunc;
+};
+
+/* What is measured on the moves of one engine. */
+struct Stats
+{
+    Stats() : depthSum( 0 ), depthCount( 0 ), nodes( 0 ), searchMs( 0 ) {}
+
+    void Add( const Stats& other )
+        {
+            latencies.insert( latencies.end(), other.latencies.begin(),
+                                               other.latencies.end() );
+            depthSum   += other.depthSum;
+            depthCount += other.depthCount;
+            nodes      += other.nodes;
+            searchMs   += other.searchMs;
+        }
+
+    std::vector<double>  latencies;   // ms, one per move.
+    double               depthSum;    // Over the moves with search info...
+    long                 depthCount;
+    double               nodes;
+    double               searchMs;
+};
+
+struct Game
+{
+    int          index;
+    bool         firstIsRed;    // Is plugin-1 Red?
+    int          opening;
+    std::string  result;        // "1-0", "0-1" or "1/2-1/2".
+    std::string  termination;
+    std::vector<AIMove> moves;  // Opening included.
+    int          openingPlies;
+    Stats        stats[2];      // Of plugin-1 and plugin-2.
+};
+
+//-----------------------------------------------------------------------------
+//
+//                              Match state
+//
+//-----------------------------------------------------------------------------
+
+static Player                s_players[2];
+static std::vector<Opening>  s_openings;
+static int                   s_level      = DEFAULT_LEVEL;
+static int                   s_maxPlies   = DEFAULT_MAX_PLIES;
+static int                   s_nGames     = 0;
+static FILE*                 s_report     = NULL;  // The real stdout.
+static FILE*                 s_log        = NULL;  // -o
+
+static pthread_mutex_t       s_mutex       = PTHREAD_MUTEX_INITIALIZER;
+static int                   s_nextGame    = 0;
+static int                   s_score[3]    = { 0, 0, 0 };  // W, D, L of plugin-1.
+static Stats                 s_stats[2];
+
+static pthread_mutex_t       s_engineMutex = PTHREAD_MUTEX_INITIALIZER;
+    /* Engines are created and set up one at a time: some plugins (TSITO)
+     * register them in global tables. */
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+
+static double
+_now_ms()
+{
+    struct timeval t;
+    ::gettimeofday( &t, NULL );
+    return t.tv_sec * 1000.0 + t.tv_usec / 1000.0;
+}
+
+static std::string
+_move_text( AIMove move )
+{
+    char szMove[5];
+    AIMoveToString( move, szMove );
+    return szMove;
+}
+
+static bool
+_parse_opening( const std::string& line, Opening& opening )
+{
+    std::istringstream in( line );
+    std::string        sMove;
+    MatchReferee       referee;
+    while ( in >> sMove )
+    {
+        const AIMove move = ( sMove.size() == 4 ? AIMoveFromString( sMove.c_str() )
+                                                : hoxAI_MOVE_NONE );
+        if ( move == hoxAI_MOVE_NONE || ! referee.Play( move ) ) return false;
+        opening.push_back( move );
+    }
+    return true;
+}
+
+static bool
+_load_openings( const char* szFile )
+{
+    if ( szFile == NULL )
+    {
+        for ( int i = 0; s_defaultOpenings[i] != NULL; ++i )
+        {
+            Opening opening;
+            if ( ! _parse_opening( s_defaultOpenings[i], opening ) )
+            {
+                fprintf(stderr, "AI_match: Bad built-in opening [%s].\n", s_defaultOpenings[i]);
+                return false;
+            }
+            s_openings.push_back( opening );
+        }
+        return true;
+    }
+
+    std::ifstream in( szFile );
+    if ( ! in )
+    {
+        fprintf(stderr, "AI_match: Cannot read [%s].\n", szFile);
+        return false;
+    }
+    std::string line;
+    int         lineNo = 0;
+    while ( std::getline( in, line ) )
+    {
+        ++lineNo;
+        const std::string::size_type comment = line.find( '#' );
+        if ( comment != std::string::npos ) line.erase( comment );
+        if ( line.find_first_not_of( " \t\r" ) == std::string::npos ) continue;
+
+        Opening opening;
+        if ( ! _parse_opening( line, opening ) )
+        {
+            fprintf(stderr, "AI_match: Bad opening at %s:%d.\n", szFile, lineNo);
+            return false;
+        }
+        s_openings.push_back( opening );
+    }
+    if ( s_openings.empty() )
+    {
+        fprintf(stderr, "AI_match: No opening in [%s].\n", szFile);
+        return false;
+    }
+    return true;
+}
+
+/* The plugins whose engines share global state, so that two of them
+ * cannot search at the same time (see the NOTE above). */
+static bool
+_is_reentrant( const Player& player )
+{
+    return (    player.name.compare( 0, 11, "AI_XQWLight" ) != 0
+             && player.name.compare( 0, 8, "AI_TSITO" ) != 0 );
+}
+
+static bool
+_load_player( Player& player, const char* szPath )
+{
+    player.path = szPath;
+
+    /* The name is the file name without its extension... */
+    std::string name = szPath;
+    const std::string::size_type slash = name.rfind( '/' );
+    if ( slash != std::string::npos ) name.erase( 0, slash + 1 );
+    const std::string::size_type dot = name.find( '.' );
+    if ( dot != std::string::npos && dot > 0 ) name.erase( dot );
+    player.name = name;
+
+    void* handle = ::dlopen( szPath, RTLD_NOW );
+    if ( handle == NULL )
+    {
+        fprintf(stderr, "AI_match: %s\n", ::dlerror());
+        return false;
+    }
+    player.createFunc = (PICreateAIEngineLibFunc) ::dlsym( handle, "CreateAIEngineLib" );
+    if ( player.createFunc == NULL )
+    {
+        fprintf(stderr, "AI_match: No 'CreateAIEngineLib' in [%s].\n", szPath);
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Playing a game
+// ----------------------------------------------------------------------------
+
+static AIEngineLib*
+_create_engine( const Player& player )
+{
+    pthread_mutex_lock( &s_engineMutex );
+    AIEngineLib* engine = player.createFunc();
+    if ( engine )
+    {
+        /* NOTE: TSITO has no engine to set the level of before a game. */
+        engine->initEngine( s_level );
+        if ( engine->initGameBinary( NULL, NULL, 0 ) == hoxAI_RC_OK )
+        {
+            engine->setDifficultyLevel( s_level );
+        }
+        else
+        {
+            engine->destroy();
+            engine = NULL;
+        }
+    }
+    pthread_mutex_unlock( &s_engineMutex );
+    return engine;
+}
+
+static void
+_destroy_engine( AIEngineLib* engine )
+{
+    pthread_mutex_lock( &s_engineMutex );
+    if ( engine ) engine->destroy();
+    pthread_mutex_unlock( &s_engineMutex );
+}
+
+/**
+ * Plays a game between two engines (index 0 is Red, 1 is Black).
+ * Returns the winner: 0 (Red), 1 (Black) or -1 for a draw.
+ */
+static int
+_play_moves( Game&        game,
+             AIEngineLib* engines[2],
+             const int    players[2] )
+{
+    const Opening& opening = s_openings[game.opening];
+    MatchReferee   referee;
+
+    /* The engines are told the opening as if it were played by humans. */
+    for ( Opening::const_iterator it = opening.begin(); it != opening.end(); ++it )
+    {
+        referee.Play( *it );
+        engines[0]->onHumanMoveBinary( *it );
+        engines[1]->onHumanMoveBinary( *it );
+        game.moves.push_back( *it );
+    }
+    game.openingPlies = (int) opening.size();
+
+    for (;;)
+    {
+        const int side = ( referee.Side() == 'w' ? 0 : 1 );
+
+        if ( ! referee.HasLegalMove() )
+        {
+            game.termination = ( referee.InCheck() ? "checkmate" : "stalemate" );
+            return 1 - side;
+        }
+        if ( (int) game.moves.size() >= s_maxPlies )
+        {
+            game.termination = "move limit";
+            return -1;
+        }
+
+        const double start = _now_ms();
+        const AIMove move  = engines[side]->generateMoveBinary();
+        const double ms    = _now_ms() - start;
+
+        Stats& stats = game.stats[ players[side] ];
+        stats.latencies.push_back( ms );
+        AISearchInfo info;
+        if ( engines[side]->getSearchInfo( info ) == hoxAI_RC_OK )
+        {
+            stats.depthSum += info.depth;
+            ++stats.depthCount;
+            stats.nodes    += info.nodes;
+            stats.searchMs += ms;
+        }
+
+        if ( move == hoxAI_MOVE_NONE )
+        {
+            game.termination = "no move (resigned)";
+            return 1 - side;
+        }
+        if ( ! referee.Play( move ) )
+        {
+            game.termination = "illegal move " + _move_text( move );
+            return 1 - side;
+        }
+        game.moves.push_back( move );
+        engines[1 - side]->onHumanMoveBinary( move );
+
+        if ( referee.RepetitionCount() >= 3 )
+        {
+            game.termination = "repetition";
+            return -1;
+        }
+        if ( referee.PliesSinceCapture() >= MAX_QUIET_PLIES )
+        {
+            game.termination = "no capture in 60 moves";
+            return -1;
+        }
+    }
+}
+
+static void
+_play_game( Game& game )
+{
+    /* Index 0 is Red, 1 is Black. */
+    const int players[2] = { game.firstIsRed ? 0 : 1, game.firstIsRed ? 1 : 0 };
+    AIEngineLib* engines[2] = { _create_engine( s_players[players[0]] ),
+                                _create_engine( s_players[players[1]] ) };
+
+    int winner = -1;
+    if ( engines[0] && engines[1] )
+    {
+        winner = _play_moves( game, engines, players );
+    }
+    else
+    {
+        game.termination = "engine failed to start";
+        if      ( engines[0] ) winner = 0;
+        else if ( engines[1] ) winner = 1;
+    }
+
+    _destroy_engine( engines[0] );
+    _destroy_engine( engines[1] );
+
+    game.result = ( winner == 0 ? "1-0" : winner == 1 ? "0-1" : "1/2-1/2" );
+}
+
+static void
+_write_game( const Game& game )
+{
+    if ( s_log == NULL ) return;
+
+    const std::string& red   = s_players[ game.firstIsRed ? 0 : 1 ].name;
+    const std::string& black = s_players[ game.firstIsRed ? 1 : 0 ].name;
+
+    fprintf(s_log, "[Event \"AI_match\"]\n");
+    fprintf(s_log, "[Round \"%d\"]\n", game.index + 1);
+    fprintf(s_log, "[Red \"%s\"]\n", red.c_str());
+    fprintf(s_log, "[Black \"%s\"]\n", black.c_str());
+    fprintf(s_log, "[Level \"%d\"]\n", s_level);
+    fprintf(s_log, "[Opening \"%d\"]\n", game.opening + 1);
+    fprintf(s_log, "[Result \"%s\"]\n", game.result.c_str());
+    fprintf(s_log, "[Termination \"%s\"]\n\n", game.termination.c_str());
+
+    for ( size_t i = 0; i < game.moves.size(); ++i )
+    {
+        if ( i % 2 == 0 )  // A new move #, 8 per line.
+        {
+            if ( i > 0 ) fputs( ( i % 16 == 0 ? "\n" : " " ), s_log );
+            fprintf(s_log, "%lu.", (unsigned long) ( i / 2 + 1 ));
+        }
+        fprintf(s_log, " %s", _move_text( game.moves[i] ).c_str());
+        if ( (int) i + 1 == game.openingPlies ) fprintf(s_log, " {end of opening}");
+    }
+    fprintf(s_log, " %s\n\n", game.result.c_str());
+    fflush( s_log );
+}
+
+static void*
+_worker_thread( void* )
+{
+    for (;;)
+    {
+        pthread_mutex_lock( &s_mutex );
+        const int index = s_nextGame++;
+        pthread_mutex_unlock( &s_mutex );
+        if ( index >= s_nGames ) break;
+
+        Game game;
+        game.index        = index;
+        game.firstIsRed   = ( index % 2 == 0 );
+        game.opening      = ( index / 2 ) % (int) s_openings.size();
+        game.openingPlies = 0;
+        _play_game( game );
+
+        const int firstSide = ( game.firstIsRed ? 0 : 1 );
+        const int outcome = ( game.result == "1/2-1/2" ? 1        // Draw.
+                            : ( game.result == "1-0" ) == ( firstSide == 0 ) ? 0 : 2 );
+
+        pthread_mutex_lock( &s_mutex );
+        ++s_score[outcome];
+        s_stats[0].Add( game.stats[0] );
+        s_stats[1].Add( game.stats[1] );
+        _write_game( game );
+        fprintf(stderr, "AI_match: Game %d: %s (%s). Score: +%d =%d -%d\n",
+            index + 1, game.result.c_str(), game.termination.c_str(),
+            s_score[0], s_score[1], s_score[2]);
+        pthread_mutex_unlock( &s_mutex );
+    }
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Report
+// ----------------------------------------------------------------------------
+
+/* The Elo difference of a score in ]0, 1[. */
+static double
+_elo( double score )
+{
+    return 400.0 * std::log10( score / ( 1.0 - score ) );
+}
+
+static void
+_report()
+{
+    const int    n     = s_score[0] + s_score[1] + s_score[2];
+    if ( n == 0 ) return;
+
+    const double score = ( s_score[0] + 0.5 * s_score[1] ) / n;
+
+    /* The 95% margin of the score, from the variance of the game results. */
+    const double variance = ( s_score[0] * (1.0 - score) * (1.0 - score)
+                            + s_score[1] * (0.5 - score) * (0.5 - score)
+                            + s_score[2] * (0.0 - score) * (0.0 - score) ) / n;
+    const double margin = 1.96 * std::sqrt( variance / n );
+
+    fprintf(s_report, "%s vs %s, level %d, %d games\n",
+        s_players[0].name.c_str(), s_players[1].name.c_str(), s_level, n);
+    fprintf(s_report, "  +%d =%d -%d   score %.1f%% +/- %.1f%%",
+        s_score[0], s_score[1], s_score[2], 100 * score, 100 * margin);
+    if ( score > 0 && score < 1 )
+    {
+        const double lo = std::max( score - margin, 0.001 );
+        const double hi = std::min( score + margin, 0.999 );
+        fprintf(s_report, "   Elo %+.0f [%+.0f, %+.0f]", _elo( score ), _elo( lo ), _elo( hi ));
+    }
+    fprintf(s_report, "\n\n");
+
+    fprintf(s_report, "  %-20s %7s %10s %10s %7s %10s\n",
+        "engine", "moves", "avg ms", "p95 ms", "depth", "knps");
+    for ( int i = 0; i < 2; ++i )
+    {
+        Stats& stats = s_stats[i];
+        std::vector<double>& latencies = stats.latencies;
+        std::sort( latencies.begin(), latencies.end() );
+
+        double total = 0;
+        for ( size_t k = 0; k < latencies.size(); ++k ) total += latencies[k];
+
+        const size_t nMoves = latencies.size();
+        const double avg = ( nMoves ? total / nMoves : 0 );
+        const double p95 = ( nMoves ? latencies[ (size_t) std::ceil( 0.95 * nMoves ) - 1 ] : 0 );
+
+        fprintf(s_report, "  %-20s %7lu %10.1f %10.1f", s_players[i].name.c_str(),
+            (unsigned long) nMoves, avg, p95);
+        if ( stats.depthCount > 0 )
+        {
+            fprintf(s_report, " %7.1f", stats.depthSum / stats.depthCount);
+            if ( stats.searchMs > 0 ) fprintf(s_report, " %10.1f", stats.nodes / stats.searchMs);
+            else                      fprintf(s_report, " %10s", "-");
+        }
+        else
+        {
+            fprintf(s_report, " %7s %10s", "-", "-");  // No getSearchInfo().
+        }
+        fprintf(s_report, "\n");
+    }
+    fflush( s_report );
+}
+
+// ----------------------------------------------------------------------------
+// Setup
+// ----------------------------------------------------------------------------
+
+static void
+_usage()
+{
+    fprintf(stderr, "Usage: AI_match [-n games] [-j threads] [-l level] [-p plies]\n"
+                    "                [-s openings] [-o log] <plugin-1> <plugin-2>\n");
+}
+
+int main( int argc, char** argv )
+{
+    int         nThreads   = 1;
+    const char* szOpenings = NULL;
+    const char* szLog      = NULL;
+
+    int opt;
+    while ( (opt = ::getopt( argc, argv, "n:j:l:p:s:o:" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'n': s_nGames   = ::atoi( optarg ); break;
+            case 'j': nThreads   = ::atoi( optarg ); break;
+            case 'l': s_level    = ::atoi( optarg ); break;
+            case 'p': s_maxPlies = ::atoi( optarg ); break;
+            case 's': szOpenings = optarg;           break;
+            case 'o': szLog      = optarg;           break;
+            default:
+                _usage();
+                return 1;
+        }
+    }
+    if ( optind != argc - 2 ) { _usage(); return 1; }
+    if ( nThreads < 1 ) nThreads = 1;
+
+    if (    ! _load_player( s_players[0], argv[optind] )
+         || ! _load_player( s_players[1], argv[optind + 1] )
+         || ! _load_openings( szOpenings ) )
+    {
+        return 1;
+    }
+    if (    nThreads > 1
+         && ( ! _is_reentrant( s_players[0] ) || ! _is_reentrant( s_players[1] ) ) )
+    {
+        fprintf(stderr, "AI_match: *WARN* [%s] is not reentrant: using one thread.\n",
+                ( _is_reentrant( s_players[0] ) ? s_players[1] : s_players[0] ).name.c_str());
+        nThreads = 1;
+    }
+    if ( s_players[0].name == s_players[1].name )  // e.g. a new build vs the old one.
+    {
+        const bool bSamePath = ( s_players[0].path == s_players[1].path );
+        s_players[0].name = ( bSamePath ? s_players[0].name + "#1" : s_players[0].path );
+        s_players[1].name = ( bSamePath ? s_players[1].name + "#2" : s_players[1].path );
+    }
+    if ( s_nGames <= 0 ) s_nGames = 2 * (int) s_openings.size();
+
+    if ( szLog != NULL && (s_log = ::fopen( szLog, "w" )) == NULL )
+    {
+        fprintf(stderr, "AI_match: Cannot write [%s].\n", szLog);
+        return 1;
+    }
+
+    /* Keep stdout for the report only: the engines print their traces
+     * to what they think is stdout, which now goes to stderr.
+     */
+    s_report = ::fdopen( ::dup( 1 ), "w" );
+    ::dup2( 2, 1 );
+
+    std::vector<pthread_t> threads;
+    for ( int i = 0; i < nThreads && i < s_nGames; ++i )
+    {
+        pthread_t thread;
+        if ( pthread_create( &thread, NULL, _worker_thread, NULL ) != 0 )
+        {
+            fprintf(stderr, "AI_match: Failed to create a thread.\n");
+            break;
+        }
+        threads.push_back( thread );
+    }
+    if ( threads.empty() ) _worker_thread( NULL );
+
+    for ( size_t i = 0; i < threads.size(); ++i )
+    {
+        pthread_join( threads[i], NULL );
+    }
+
+    _report();
+    if ( s_log ) ::fclose( s_log );
+    return 0;
+}
+
+/************************* END OF FILE ***************************************/
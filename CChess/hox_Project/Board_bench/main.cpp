@@ -0,0 +1,245 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            main.cpp
+// Created:         10/19/2026
+//
+// Description:     The Board Benchmark: replays a game on a core Board
+//                  (hoxCoreBoard) that is never shown, and times the
+//                  drawing of each Move in two ways:
+//
+//      full    The whole Board (background and Pieces) is drawn again,
+//              and copied into a wxMemoryDC: what every Move cost before
+//              the Board had its back buffer.
+//      dirty   Only the rectangles of the Pieces changed are composed
+//              again in the back buffer.  (A shown Board also copies
+//              these rectangles to the screen.)
+//
+//   Usage:  Board_bench [options]
+//
+//      -n moves     The Moves of the game (default: 200).  The game is
+//                   made of random legal Moves, from a seed giving no
+//                   game-over before the end.
+//      -r runs      The runs of each way; the best is reported (default: 3).
+//      -p pieces    The piece set, under resource/pieces (default: 1).
+//      -b image     The board image, under resource/boards (default: none,
+//                   the board is drawn).
+//
+//   The resources are found as the client finds them, so the program must
+//   be run from its own directory (hox_Project/Board_bench).  No window is
+//   shown, but wxWidgets needs a display (Xvfb will do).
+/////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/time.h>
+#include "hoxCoreBoard.h"
+#include "hoxReferee.h"
+
+#define DEFAULT_MOVES  200
+#define DEFAULT_RUNS   3
+
+static const wxSize s_boardSize( 600, 700 );
+
+static double
+_now_ms()
+{
+    struct timeval t;
+    ::gettimeofday( &t, NULL );
+    return t.tv_sec * 1000.0 + t.tv_usec / 1000.0;
+}
+
+/**
+ * Makes a game of random legal Moves (without game-over).
+ * Returns false if the seed leads to a game-over.
+ */
+static bool
+_MakeGame( unsigned int   seed,
+           int            nMoves,
+           hoxMoveVector& moves )
+{
+    hoxReferee referee;
+    moves.clear();
+
+    unsigned int state = seed;
+    for ( int i = 0; i < nMoves; ++i )
+    {
+        hoxMoveVector nextMoves;
+        referee.GetAvailableNextMoves( nextMoves );
+        if ( nextMoves.empty() ) return false;
+
+        state = state * 1103515245 + 12345;
+        hoxMove move = nextMoves[(state >> 16) % nextMoves.size()];
+
+        hoxGameStatus status = hoxGAME_STATUS_UNKNOWN;
+        if (    ! referee.ValidateMove( move, status )
+             || hoxIReferee::IsGameOverStatus( status ) )
+        {
+            return false;
+        }
+        moves.push_back( move );
+    }
+    return true;
+}
+
+/**
+ * Replays the game on the Board from the start.
+ * Returns the time in milliseconds, or -1 if a Move was refused.
+ */
+static double
+_Replay( hoxCoreBoard*        board,
+         hoxIReferee_SPtr     referee,
+         const hoxMoveVector& moves,
+         bool                 bFull,
+         wxDC&                dc )
+{
+    referee->ResetGame();
+    board->ResetBoard();
+    board->DrawOn( dc );  // The back buffer is ready.
+
+    const double start = _now_ms();
+    for ( size_t i = 0; i < moves.size(); ++i )
+    {
+        hoxMove move = moves[i];
+        if ( bFull )
+        {
+            if ( ! board->DoMove( move, false /* bRefresh */ ) ) return -1;
+            board->Repaint();
+            board->DrawOn( dc );
+        }
+        else
+        {
+            if ( ! board->DoMove( move ) ) return -1;
+        }
+    }
+    return _now_ms() - start;
+}
+
+// ----------------------------------------------------------------------------
+// Setup
+// ----------------------------------------------------------------------------
+
+class BenchApp : public wxApp
+{
+public:
+    virtual bool OnInit() { return true; }
+};
+
+static void
+_usage()
+{
+    fprintf(stderr, "Usage: Board_bench [-n moves] [-r runs] [-p pieces] [-b image]\n");
+}
+
+static int
+_run( int argc, char** argv )
+{
+    int      nMoves = DEFAULT_MOVES;
+    int      nRuns  = DEFAULT_RUNS;
+    wxString sPieces( DEFAULT_PIECE_PATH );
+    wxString sImage;
+
+    int opt;
+    while ( (opt = ::getopt( argc, argv, "n:r:p:b:" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'n': nMoves  = ::atoi( optarg ); break;
+            case 'r': nRuns   = ::atoi( optarg ); break;
+            case 'p': sPieces = optarg;           break;
+            case 'b': sImage  = optarg;           break;
+            default:
+                _usage();
+                return 1;
+        }
+    }
+    if ( optind != argc || nMoves < 1 || nRuns < 1 )
+    {
+        _usage();
+        return 1;
+    }
+
+    hoxMoveVector moves;
+    unsigned int seed = 1;
+    while ( ! _MakeGame( seed, nMoves, moves ) )
+    {
+        if ( ++seed > 1000 )
+        {
+            fprintf(stderr, "Board_bench: No game of %d Moves found.\n", nMoves);
+            return 1;
+        }
+    }
+
+    ::wxInitAllImageHandlers();
+    wxFrame* frame = new wxFrame( NULL, wxID_ANY, "Board_bench" );  // Not shown.
+    hoxIReferee_SPtr referee( new hoxReferee() );
+    hoxCoreBoard* board = new hoxCoreBoard( frame, referee, sImage, sPieces );
+    board->SetSize( s_boardSize );
+    board->LoadPiecesAndStatus();
+
+    wxBitmap   bitmap( s_boardSize.x, s_boardSize.y );
+    wxMemoryDC dc( bitmap );
+
+    double best[2] = { -1, -1 };
+    for ( int r = 0; r < nRuns; ++r )
+    {
+        for ( int way = 0; way < 2; ++way )
+        {
+            const double ms = _Replay( board, referee, moves, way == 0, dc );
+            if ( ms < 0 )
+            {
+                fprintf(stderr, "Board_bench: A Move was refused by the Board.\n");
+                return 1;
+            }
+            if ( best[way] < 0 || ms < best[way] ) best[way] = ms;
+        }
+    }
+
+    printf("%d moves (seed %u), best of %d runs, %dx%d board, pieces [%s], image [%s]\n",
+        nMoves, seed, nRuns, s_boardSize.x, s_boardSize.y,
+        (const char*) sPieces.c_str(), (const char*) sImage.c_str());
+    printf("  full (us/move)   dirty (us/move)   speedup\n");
+    printf("  %14.1f   %15.1f   %6.2fx\n",
+        1000 * best[0] / nMoves, 1000 * best[1] / nMoves,
+        ( best[1] > 0 ? best[0] / best[1] : 0.0 ));
+
+    frame->Destroy();
+    return 0;
+}
+
+int main( int argc, char** argv )
+{
+    wxApp::SetInstance( new BenchApp() );
+    if ( ! ::wxEntryStart( argc, argv ) )
+    {
+        fprintf(stderr, "Board_bench: Failed to initialize wxWidgets (no display?).\n");
+        return 1;
+    }
+
+    const int rc = _run( argc, argv );
+
+    ::wxEntryCleanup();
+    return rc;
+}
+
+/************************* END OF FILE ***************************************/
@@ -0,0 +1,359 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            main.cpp
+// Created:         10/19/2026
+//
+// Description:     The Socket Benchmark: compares, over a loopback
+//                  connection, the writes of hoxAsyncSocket (all the
+//                  pending messages in one gather write) with the ones
+//                  they replaced (one write per message).
+//
+//   Usage:  Socket_bench [options]
+//
+//      -n count     The messages sent by each run (default: 200000),
+//                   shared by the producers.
+//      -s size      The size of a message in bytes (default: 64).
+//      -b burst     The messages sent at once by a producer, as a join,
+//                   a move and a chat (default: 3).
+//      -g usec      The pause of a producer between its bursts
+//                   (default: 0).
+//      -p threads   The producer threads (default: 4).
+//      -t threads   The I/O threads (default: 2).
+//      -r runs      The runs of each case; the best is reported
+//                   (default: 3).
+//
+//   The writes are counted as the 'write_some' operations of the socket,
+//   each being one 'sendmsg' system call once the socket is writable.
+/////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/time.h>
+#include <asio.hpp>
+#include <boost/bind.hpp>
+
+using asio::ip::tcp;
+
+#define DEFAULT_COUNT  200000
+#define DEFAULT_RUNS   3
+
+/* The same limits as hoxAsyncSocket. */
+#define MAX_WRITE_MESSAGES  64
+#define MAX_WRITE_BYTES     (64 * 1024)
+
+//-----------------------------------------------------------------------------
+//
+//                                  Writers
+//
+//-----------------------------------------------------------------------------
+
+/* A socket counting its 'write_some' operations. */
+class CountingSocket
+{
+public:
+    CountingSocket( asio::io_service& io_service )
+        : m_socket( io_service ), m_nWrites( 0 ) {}
+
+    tcp::socket&      socket()         { return m_socket; }
+    asio::io_service& get_io_service() { return m_socket.get_io_service(); }
+    long              writes() const   { return m_nWrites; }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    void async_write_some( const ConstBufferSequence& buffers,
+                           WriteHandler               handler )
+    {
+        ++m_nWrites;  // Within the strand of the writer.
+        m_socket.async_write_some( buffers, handler );
+    }
+
+private:
+    tcp::socket  m_socket;
+    long         m_nWrites;
+};
+
+/**
+ * The writing part of hoxAsyncSocket: write() may be called from any
+ * thread, and the handlers run through a strand.  If 'bGather' is set, the
+ * pending messages are written together (as now), else one at a time (as
+ * before).
+ */
+class Writer
+{
+public:
+    Writer( asio::io_service& io_service, bool bGather )
+        : m_strand( io_service ), m_stream( io_service ), m_bGather( bGather ) {}
+
+    tcp::socket& socket()       { return m_stream.socket(); }
+    long         writes() const { return m_stream.writes(); }
+
+    void write( const std::string& msg )
+    {
+        m_strand.post( boost::bind(&Writer::_doWrite, this, msg) );
+    }
+
+private:
+    void _doWrite( const std::string msg )
+    {
+        m_writeQueue.push_back( msg );
+        if ( m_writingQueue.empty() )
+        {
+            _startWrite();
+        }
+    }
+
+    void _startWrite()
+    {
+        const size_t maxMessages = ( m_bGather ? MAX_WRITE_MESSAGES : 1 );
+        size_t nBytes = 0;
+        while (    !m_writeQueue.empty()
+                && m_writingQueue.size() < maxMessages
+                && ( m_writingQueue.empty()
+                     || nBytes + m_writeQueue.front().length() <= MAX_WRITE_BYTES ) )
+        {
+            m_writingQueue.push_back( std::string() );
+            m_writingQueue.back().swap( m_writeQueue.front() );
+            m_writeQueue.pop_front();
+            nBytes += m_writingQueue.back().length();
+        }
+
+        m_writeBuffers.clear();
+        for ( MessageQueue::const_iterator it = m_writingQueue.begin();
+                                           it != m_writingQueue.end(); ++it )
+        {
+            m_writeBuffers.push_back( asio::buffer( it->data(), it->length() ) );
+        }
+
+        asio::async_write( m_stream,
+                           m_writeBuffers,
+                           m_strand.wrap(
+                               boost::bind( &Writer::_handleWrite, this,
+                                            asio::placeholders::error)));
+    }
+
+    void _handleWrite( const asio::error_code& error )
+    {
+        if ( error )
+        {
+            fprintf(stderr, "Socket_bench: Write failed: %s\n", error.message().c_str());
+            ::exit( 1 );
+        }
+        m_writingQueue.clear();
+        if ( !m_writeQueue.empty() )
+        {
+            _startWrite();
+        }
+    }
+
+private:
+    typedef std::deque<std::string> MessageQueue;
+
+    asio::io_service::strand         m_strand;
+    CountingSocket                   m_stream;
+    const bool                       m_bGather;
+    MessageQueue                     m_writeQueue;
+    MessageQueue                     m_writingQueue;
+    std::vector<asio::const_buffer>  m_writeBuffers;
+};
+
+//-----------------------------------------------------------------------------
+//
+//                                  Runs
+//
+//-----------------------------------------------------------------------------
+
+static int  s_count     = DEFAULT_COUNT;
+static int  s_size      = 64;
+static int  s_burst     = 3;
+static int  s_gap       = 0;
+static int  s_producers = 4;
+static int  s_ioThreads = 2;
+static int  s_runs      = DEFAULT_RUNS;
+
+struct Result
+{
+    double  ms;      // The time until the last byte is read.
+    long    writes;
+};
+
+static double
+_now_ms()
+{
+    struct timeval t;
+    ::gettimeofday( &t, NULL );
+    return t.tv_sec * 1000.0 + t.tv_usec / 1000.0;
+}
+
+/* Reads (and drops) 'nBytes' bytes from a connection. */
+static void
+_read_all( tcp::socket* socket, size_t nBytes )
+{
+    char buf[64 * 1024];
+    asio::error_code error;
+    while ( nBytes > 0 )
+    {
+        const size_t n = socket->read_some( asio::buffer( buf ), error );
+        if ( error )
+        {
+            fprintf(stderr, "Socket_bench: Read failed: %s\n", error.message().c_str());
+            ::exit( 1 );
+        }
+        nBytes -= n;
+    }
+}
+
+static void
+_produce( Writer* writer, int count )
+{
+    const std::string msg = std::string( s_size - 1, 'x' ) + "\n";
+    for ( int i = 0; i < count; ++i )
+    {
+        writer->write( msg );
+        if ( s_gap > 0 && (i + 1) % s_burst == 0 ) ::usleep( s_gap );
+    }
+}
+
+/**
+ * Sends s_count messages from s_producers threads through a new loopback
+ * connection.
+ */
+static Result
+_run( bool bGather )
+{
+    asio::io_service io_service;
+    tcp::acceptor acceptor( io_service, tcp::endpoint( asio::ip::address_v4::loopback(), 0 ) );
+    tcp::socket   server( io_service );
+    Writer        writer( io_service, bGather );
+    writer.socket().connect( acceptor.local_endpoint() );
+    acceptor.accept( server );
+
+    asio::io_service::work* work = new asio::io_service::work( io_service );
+    std::vector<asio::thread*> ioThreads;
+    for ( int t = 0; t < s_ioThreads; ++t )
+    {
+        ioThreads.push_back(
+            new asio::thread( boost::bind(&asio::io_service::run, &io_service) ) );
+    }
+
+    const int    perProducer = s_count / s_producers;
+    const size_t nBytes      = (size_t) perProducer * s_producers * s_size;
+
+    const double start = _now_ms();
+    asio::thread reader( boost::bind(&_read_all, &server, nBytes) );
+    std::vector<asio::thread*> producers;
+    for ( int p = 0; p < s_producers; ++p )
+    {
+        producers.push_back(
+            new asio::thread( boost::bind(&_produce, &writer, perProducer) ) );
+    }
+    reader.join();
+
+    Result result;
+    result.ms     = _now_ms() - start;
+    for ( int p = 0; p < s_producers; ++p )
+    {
+        producers[p]->join();
+        delete producers[p];
+    }
+
+    delete work;
+    for ( int t = 0; t < s_ioThreads; ++t )
+    {
+        ioThreads[t]->join();  // ... once the last handler is done.
+        delete ioThreads[t];
+    }
+    result.writes = writer.writes();
+    return result;
+}
+
+static Result
+_best( bool bGather )
+{
+    Result best = { -1, 0 };
+    for ( int r = 0; r < s_runs; ++r )
+    {
+        const Result result = _run( bGather );
+        if ( best.ms < 0 || result.ms < best.ms ) best = result;
+    }
+    return best;
+}
+
+// ----------------------------------------------------------------------------
+// Setup
+// ----------------------------------------------------------------------------
+
+static void
+_usage()
+{
+    fprintf(stderr, "Usage: Socket_bench [-n count] [-s size] [-b burst] [-g usec]\n"
+                    "                    [-p threads] [-t threads] [-r runs]\n");
+}
+
+int main( int argc, char** argv )
+{
+    int opt;
+    while ( (opt = ::getopt( argc, argv, "n:s:b:g:p:t:r:" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'n': s_count     = ::atoi( optarg ); break;
+            case 's': s_size      = ::atoi( optarg ); break;
+            case 'b': s_burst     = ::atoi( optarg ); break;
+            case 'g': s_gap       = ::atoi( optarg ); break;
+            case 'p': s_producers = ::atoi( optarg ); break;
+            case 't': s_ioThreads = ::atoi( optarg ); break;
+            case 'r': s_runs      = ::atoi( optarg ); break;
+            default:
+                _usage();
+                return 1;
+        }
+    }
+    if (    optind != argc || s_size < 1 || s_burst < 1 || s_gap < 0
+         || s_producers < 1 || s_count < s_producers
+         || s_ioThreads < 1 || s_runs < 1 )
+    {
+        _usage();
+        return 1;
+    }
+
+    printf("%d messages of %d bytes, bursts of %d, %d us pause, %d producers, %d I/O threads\n",
+        s_count, s_size, s_burst, s_gap, s_producers, s_ioThreads);
+    printf("  mode            msg/s     writes/msg   bytes/write\n");
+
+    static const char* s_names[] = { "one per msg", "gathered" };
+    const double total = (double) ( s_count / s_producers * s_producers );
+    for ( int i = 0; i < 2; ++i )
+    {
+        const Result result = _best( i == 1 );
+        printf("  %-11s  %10.0f   %10.3f   %11.1f\n", s_names[i],
+            1000.0 * total / result.ms,
+            result.writes / total,
+            total * s_size / result.writes);
+        fflush( stdout );
+    }
+    return 0;
+}
+
+/************************* END OF FILE ***************************************/
@@ -27,6 +27,9 @@
 
 #include "MyApp.h"
 #include "hoxAIPluginMgr.h"
+#include "hoxIOService.h"
+#include "hoxClockService.h"
+#include "hoxPieceAtlas.h"
 #include "hoxUtil.h"
 
 // Create a new application object: this macro will allow wxWidgets to create
@@ -113,6 +116,8 @@ MyApp::OnInit()
 
     const wxString sDefaultAI = wxGetApp().GetOption("defaultAI");
     hoxAIPluginMgr::SetDefaultPluginName( sDefaultAI );
+    hoxAIPluginMgr::SetEngineHost( wxGetApp().GetOption("aiHost") );
+    hoxIOService::SetThreadCount( ::atoi( wxGetApp().GetOption("ioThreads").c_str() ) );
 
     // success: wxApp::OnRun() will be called which will enter the main message
     // loop and the application will run. If we returned false here, the
@@ -273,6 +278,9 @@ MyApp::OnExit()
 
     hoxAIPluginMgr::DeleteInstance();
 	hoxSiteManager::DeleteInstance();
+    hoxIOService::DeleteInstance();
+    hoxClockService::DeleteInstance();
+    hoxPieceAtlas::DeleteInstance();
     _SaveAppOptions();
 	delete m_config; // The changes will be written back automatically
 
@@ -385,6 +393,9 @@ MyApp::_LoadAppOptions()
     m_options["showTables"] = m_config->Read("/Options/showTables", "1");
     m_options["moveMode"] = m_config->Read("/Options/moveMode", "0");
     m_options["defaultAI"] = m_config->Read("/Options/defaultAI", "");
+    m_options["aiHost"] = m_config->Read("/Options/aiHost", "");
+    m_options["aiStatsDir"] = m_config->Read("/Options/aiStatsDir", "");
+    m_options["ioThreads"] = m_config->Read("/Options/ioThreads", "0");
     m_options["optionsPage"] = m_config->Read("/Options/optionsPage", "0");
 
     m_options["/Board/Image/path"] =
@@ -398,6 +409,57 @@ MyApp::_LoadAppOptions()
 
     m_options["/Board/Color/foreground"] =
         m_config->Read("/Board/Color/foreground", DEFAULT_BOARD_FOREGROUND_COLOR);
+
+    _LoadAIOptions();
+}
+
+void
+MyApp::_LoadAIOptions()
+{
+    /* The options are saved as "/AI/<plugin>/<option>". */
+
+    const wxString sOldPath = m_config->GetPath();
+    m_config->SetPath("/AI");
+
+    wxArrayString plugins;
+    wxString      sName;
+    long          index = 0;
+    for ( bool cont = m_config->GetFirstGroup( sName, index );
+               cont == true;
+               cont = m_config->GetNextGroup( sName, index ) )
+    {
+        plugins.Add( sName );
+    }
+
+    for ( size_t i = 0; i < plugins.size(); ++i )
+    {
+        m_config->SetPath( "/AI/" + plugins[i] );
+        for ( bool cont = m_config->GetFirstEntry( sName, index );
+                   cont == true;
+                   cont = m_config->GetNextEntry( sName, index ) )
+        {
+            m_options["/AI/" + plugins[i] + "/" + sName] = m_config->Read( sName, "" );
+        }
+    }
+
+    m_config->SetPath( sOldPath );
+}
+
+wxString
+MyApp::GetAIOption( const wxString& sPlugin,
+                    const wxString& sName ) const
+{
+    hoxOptions::const_iterator found_it =
+        m_options.find( "/AI/" + sPlugin + "/" + sName );
+    return ( found_it != m_options.end() ? found_it->second : "" );
+}
+
+void
+MyApp::SetAIOption( const wxString& sPlugin,
+                    const wxString& sName,
+                    const wxString& sValue )
+{
+    m_options["/AI/" + sPlugin + "/" + sName] = sValue;
 }
 
 void
@@ -409,11 +471,24 @@ MyApp::_SaveAppOptions()
     m_config->Write("/Options/showTables", m_options["showTables"]);
     m_config->Write("/Options/moveMode", m_options["moveMode"]);
     m_config->Write("/Options/defaultAI", m_options["defaultAI"]);
+    m_config->Write("/Options/aiHost", m_options["aiHost"]);
+    m_config->Write("/Options/aiStatsDir", m_options["aiStatsDir"]);
+    m_config->Write("/Options/ioThreads", m_options["ioThreads"]);
     m_config->Write("/Options/optionsPage", m_options["optionsPage"]);
     m_config->Write("/Board/Image/path", m_options["/Board/Image/path"]);
     m_config->Write("/Board/Piece/path", m_options["/Board/Piece/path"]);
     m_config->Write("/Board/Color/background", m_options["/Board/Color/background"]);
     m_config->Write("/Board/Color/foreground", m_options["/Board/Color/foreground"]);
+
+    for ( hoxOptions::const_iterator it = m_options.begin();
+                                     it != m_options.end(); ++it )
+    {
+        if ( it->first.StartsWith("/AI/") )
+        {
+            if ( it->second.empty() ) m_config->DeleteEntry( it->first );
+            else                      m_config->Write( it->first, it->second );
+        }
+    }
 }
 
 /************************* END OF FILE ***************************************/
@@ -105,6 +105,15 @@ public:
     void SetOption( const wxString& name, const wxString& value )
         { m_options[name] = value; }
 
+    /* The options of the AI engines, saved per plugin.
+     * An empty value means the engine's own default.
+     */
+    wxString GetAIOption( const wxString& sPlugin,
+                          const wxString& sName ) const;
+    void SetAIOption( const wxString& sPlugin,
+                      const wxString& sName,
+                      const wxString& sValue );
+
 	bool GetDefaultFrameLayout( wxPoint& position, wxSize& size );
 	bool SaveDefaultFrameLayout( const wxPoint& position, const wxSize& size );
 
@@ -122,6 +131,7 @@ private:
 
     void _LoadAppOptions();
     void _SaveAppOptions();
+    void _LoadAIOptions();
 
 private:
 	wxConfig*           m_config;
@@ -699,6 +699,17 @@ MyFrame::OnOptions( wxCommandEvent& event )
     hoxAIPluginMgr::SetDefaultPluginName( dlg.m_sDefaultAI );
     wxGetApp().SetOption( "defaultAI", dlg.m_sDefaultAI );
 
+    /* NOTE: The AI options take effect with the next Practice table. */
+    for ( hoxOptionsUI::AIOptionsMap::const_iterator it = dlg.m_aiOptions.begin();
+                                                     it != dlg.m_aiOptions.end(); ++it )
+    {
+        for ( hoxParameters::const_iterator option_it = it->second.begin();
+                                            option_it != it->second.end(); ++option_it )
+        {
+            wxGetApp().SetAIOption( it->first, option_it->first, option_it->second );
+        }
+    }
+
     wxGetApp().SetOption( "optionsPage", wxString::Format("%d", dlg.m_selectedPage) );
 
     // Apply the new Options to the Active Table.
@@ -1001,14 +1012,14 @@ void
 MyFrame::_SaveCurrentTableToDisk( const hoxTable_SPtr& pTable,
                                   const wxString&      fileName ) const
 {
-    hoxMoveList      moveList;
+    hoxMoveHistory   pastMoves;
     hoxGameState     gameState;
 
-    pTable->GetReferee()->GetHistoryMoves( moveList );
+    pTable->GetReferee()->GetHistoryMoves( pastMoves );
     pTable->GetReferee()->GetGameState( gameState );
 
     hoxSavedTable savedTable( fileName );
-    savedTable.SaveGameState( pTable->GetId(), moveList,
+    savedTable.SaveGameState( pTable->GetId(), pastMoves,
                               gameState.pieceList, gameState.nextColor );
 }
 
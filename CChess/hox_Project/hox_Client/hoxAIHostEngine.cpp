@@ -0,0 +1,408 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxAIHostEngine.cpp
+// Created:         10/19/2026
+//
+// Description:     An AI Engine running out of process, in the Engine Host.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "hoxAIHostEngine.h"
+#include "../plugins/common/AIHostProtocol.h"
+#include <vector>
+
+/* The host serves this client with a single engine. */
+#define HOST_SLOT  0
+
+hoxAIHostEngine::hoxAIHostEngine( const wxString& sHostCommand,
+                                  const wxString& sPluginPath )
+        : m_process( NULL )
+        , m_pid( 0 )
+        , m_listener( NULL )
+{
+    const wxString sCommand = sHostCommand + " \"" + sPluginPath + "\"";
+    wxLogDebug("%s: Start the Engine Host [%s]...", __FUNCTION__, sCommand.c_str());
+
+    m_process = new wxProcess();
+    m_process->Redirect();
+    m_pid = ::wxExecute( sCommand, wxEXEC_ASYNC, m_process );
+    if ( m_pid == 0 )
+    {
+        wxLogWarning("%s: Failed to start the Engine Host [%s].", __FUNCTION__, sCommand.c_str());
+        delete m_process;
+        m_process = NULL;
+        return;
+    }
+
+    std::string reply;
+    AIHostWriter request( AI_HOST_OPEN, HOST_SLOT );
+    if ( _Call( request, reply ) != hoxAI_RC_OK )
+    {
+        wxLogWarning("%s: The Engine Host could not load [%s].", __FUNCTION__, sPluginPath.c_str());
+        _Kill();
+    }
+}
+
+hoxAIHostEngine::~hoxAIHostEngine()
+{
+    /* NOTE: The host is killed rather than asked to QUIT since it keeps
+     *       nothing worth saving, and a runaway search would not stop.
+     */
+    _Kill();
+}
+
+void
+hoxAIHostEngine::initEngine( int nAILevel /* = 0 */ )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_INIT_ENGINE, HOST_SLOT );
+    request.put32( nAILevel );
+    _Call( request, reply );
+}
+
+int
+hoxAIHostEngine::initGame( const std::string& fen,
+                           const MoveList&    moves )
+{
+    AIPosition position;
+    if ( ! fen.empty() && ! AIPositionFromFEN( fen, position ) )
+    {
+        return hoxAI_RC_ERR;
+    }
+
+    std::vector<AIMove> aiMoves;
+    for ( MoveList::const_iterator it = moves.begin(); it != moves.end(); ++it )
+    {
+        aiMoves.push_back( AIMoveFromString( it->c_str() ) );
+    }
+
+    return initGameBinary( fen.empty() ? NULL : &position,
+                           aiMoves.empty() ? NULL : &aiMoves[0],
+                           (int) aiMoves.size() );
+}
+
+std::string
+hoxAIHostEngine::generateMove()
+{
+    const AIMove move = generateMoveBinary();
+    if ( move == hoxAI_MOVE_NONE ) return "";
+
+    char szMove[5];
+    AIMoveToString( move, szMove );
+    return szMove;
+}
+
+void
+hoxAIHostEngine::onHumanMove( const std::string& sMove )
+{
+    onHumanMoveBinary( AIMoveFromString( sMove.c_str() ) );
+}
+
+int
+hoxAIHostEngine::setDifficultyLevel( int nAILevel )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_SET_LEVEL, HOST_SLOT );
+    request.put32( nAILevel );
+    return _Call( request, reply );
+}
+
+std::string
+hoxAIHostEngine::getInfo()
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_GET_INFO, HOST_SLOT );
+    if ( _Call( request, reply ) != hoxAI_RC_OK ) return "";
+
+    AIHostReader reader( reply.data(), reply.size() );
+    return reader.getString();
+}
+
+int
+hoxAIHostEngine::listOptions( AIOptionList& options )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_LIST_OPTIONS, HOST_SLOT );
+    const int nRet = _Call( request, reply );
+    if ( nRet != hoxAI_RC_OK ) return nRet;
+
+    AIHostReader reader( reply.data(), reply.size() );
+    const int nOptions = reader.get16();
+    for ( int i = 0; i < nOptions && reader.ok(); ++i )
+    {
+        AIOption option;
+        option.name     = reader.getString();
+        option.type     = (AIOption::Type) reader.get8();
+        option.value    = reader.getString();
+        option.minValue = reader.get32();
+        option.maxValue = reader.get32();
+        if ( reader.ok() ) options.push_back( option );
+    }
+    return reader.ok() ? hoxAI_RC_OK : hoxAI_RC_ERR;
+}
+
+int
+hoxAIHostEngine::setOption( const std::string& name,
+                            const std::string& value )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_SET_OPTION, HOST_SLOT );
+    request.putString( name );
+    request.putString( value );
+    return _Call( request, reply );
+}
+
+int
+hoxAIHostEngine::initGameBinary( const AIPosition* position,
+                                 const AIMove*     moves,
+                                 int               nMoves )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_INIT_GAME, HOST_SLOT );
+    request.put8( position ? 1 : 0 );
+    if ( position )
+    {
+        for ( int i = 0; i < 90; ++i ) request.put8( position->squares[i] );
+        request.put8( position->side );
+    }
+    request.put16( nMoves );
+    for ( int i = 0; i < nMoves; ++i ) request.put16( moves[i] );
+    return _Call( request, reply );
+}
+
+AIMove
+hoxAIHostEngine::generateMoveBinary()
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_GENERATE_MOVE, HOST_SLOT );
+    if ( _Call( request, reply ) != hoxAI_RC_OK ) return hoxAI_MOVE_NONE;
+
+    AIHostReader reader( reply.data(), reply.size() );
+    const AIMove move = (AIMove) reader.get16();
+    return reader.ok() ? move : hoxAI_MOVE_NONE;
+}
+
+void
+hoxAIHostEngine::onHumanMoveBinary( AIMove move )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_HUMAN_MOVE, HOST_SLOT );
+    request.put16( move );
+    _Call( request, reply );
+}
+
+int
+hoxAIHostEngine::getSearchInfo( AISearchInfo& info )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_SEARCH_INFO, HOST_SLOT );
+    const int nRet = _Call( request, reply );
+    if ( nRet != hoxAI_RC_OK ) return nRet;
+
+    AIHostReader reader( reply.data(), reply.size() );
+    return _GetSearchInfo( reader, info );
+}
+
+int
+hoxAIHostEngine::benchSearch( int           depth,
+                              AIMove&       move,
+                              AISearchInfo& info )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_BENCH, HOST_SLOT );
+    request.put32( depth );
+    const int nRet = _Call( request, reply );
+    if ( nRet != hoxAI_RC_OK ) return nRet;
+
+    AIHostReader reader( reply.data(), reply.size() );
+    move = (AIMove) reader.get16();
+    return _GetSearchInfo( reader, info );
+}
+
+int
+hoxAIHostEngine::setSearchListener( AISearchListener* listener )
+{
+    std::string reply;
+    AIHostWriter request( AI_HOST_SET_LISTENER, HOST_SLOT );
+    request.put8( listener ? 1 : 0 );
+    const int nRet = _Call( request, reply );
+    m_listener = ( nRet == hoxAI_RC_OK ? listener : NULL );
+    return nRet;
+}
+
+int
+hoxAIHostEngine::_GetSearchInfo( AIHostReader& reader,
+                                 AISearchInfo& info )
+{
+    info.depth       = reader.get32();
+    info.nodes       = (unsigned int) reader.get32();
+    info.hashProbes  = (unsigned int) reader.get32();
+    info.hashHits    = (unsigned int) reader.get32();
+    info.hashCutoffs = (unsigned int) reader.get32();
+    info.betaCutoffs = (unsigned int) reader.get32();
+    info.nullCutoffs = (unsigned int) reader.get32();
+    return reader.ok() ? hoxAI_RC_OK : hoxAI_RC_ERR;
+}
+
+int
+hoxAIHostEngine::_Call( AIHostWriter& request,
+                        std::string&  reply )
+{
+    wxMutexLocker lock( m_mutex );
+
+    if ( m_process == NULL ) return hoxAI_RC_ERR;
+
+    const std::string& data = request.data();
+    wxOutputStream* out = m_process->GetOutputStream();
+    out->Write( data.data(), data.size() );
+    if ( out->LastWrite() != data.size() )
+    {
+        wxLogWarning("%s: The Engine Host is gone.", __FUNCTION__);
+        _Kill();
+        return hoxAI_RC_ERR;
+    }
+
+    for (;;)  // ... until the reply, after the PROGRESS of a search.
+    {
+        unsigned char header[4];
+        size_t length = 0;
+        if ( _Read( (char*) header, sizeof(header) ) )
+        {
+            length = AIHostFrameLength( header );
+        }
+        if ( length < 6 || length > AI_HOST_MAX_FRAME )
+        {
+            wxLogWarning("%s: The Engine Host is gone or confused.", __FUNCTION__);
+            _Kill();
+            return hoxAI_RC_ERR;
+        }
+
+        std::string frame( length, '\0' );
+        if ( ! _Read( &frame[0], length ) )
+        {
+            wxLogWarning("%s: The Engine Host is gone.", __FUNCTION__);
+            _Kill();
+            return hoxAI_RC_ERR;
+        }
+
+        _DrainErrors();
+
+        AIHostReader reader( frame.data(), frame.size() );
+        const int command = reader.get8();
+        const int slot    = reader.get8();
+        const int nRet    = reader.get32();
+        if ( command == AI_HOST_PROGRESS )
+        {
+            _OnProgress( reader );
+            continue;
+        }
+        wxCHECK_MSG( command == (unsigned char) data[4] && slot == HOST_SLOT,
+                     hoxAI_RC_ERR, "The reply does not match the request" );
+
+        reply.assign( frame, 6, std::string::npos );
+        return nRet;
+    }
+}
+
+void
+hoxAIHostEngine::_OnProgress( AIHostReader& reader )
+{
+    AISearchProgress progress;
+    progress.depth    = reader.get32();
+    progress.selDepth = reader.get32();
+    progress.score    = reader.get32();
+    progress.nodes    = (unsigned int) reader.get32();
+    progress.msecs    = (unsigned int) reader.get32();
+    progress.hashFull = reader.get32();
+    const int nPV     = reader.get16();
+    for ( int i = 0; i < nPV && i < hoxAI_MAX_PV; ++i )
+    {
+        progress.pv[progress.pvLength++] = (AIMove) reader.get16();
+    }
+
+    if ( reader.ok() && m_listener != NULL )
+    {
+        m_listener->onSearchProgress( progress );
+    }
+}
+
+bool
+hoxAIHostEngine::_Read( char* buf, size_t n )
+{
+    wxInputStream* in = m_process->GetInputStream();
+    while ( n > 0 )
+    {
+        /* Keep reading the engines' traces while waiting: a long search
+         * writing much to stderr would otherwise fill the pipe and block
+         * the host before it replies.
+         */
+        while ( ! in->CanRead() )
+        {
+            _DrainErrors();
+            if ( in->Eof() || ! wxProcess::Exists( m_pid ) ) return false;
+            wxMilliSleep( 5 );
+        }
+
+        in->Read( buf, n );
+        const size_t got = in->LastRead();
+        if ( got == 0 ) return false;  // EOF or error.
+        buf += got;
+        n   -= got;
+    }
+    return true;
+}
+
+void
+hoxAIHostEngine::_DrainErrors()
+{
+    /* The engines' traces come on the host's stderr.  They must be read
+     * or the host would block once the pipe is full.
+     */
+    wxInputStream* err = m_process->GetErrorStream();
+    char buf[512];
+    while ( err && err->CanRead() )
+    {
+        err->Read( buf, sizeof(buf) - 1 );
+        const size_t got = err->LastRead();
+        if ( got == 0 ) break;
+        buf[got] = '\0';
+        wxLogDebug("%s: [AI_host] %s", __FUNCTION__, buf);
+    }
+}
+
+void
+hoxAIHostEngine::_Kill()
+{
+    if ( m_process == NULL ) return;
+
+    if ( wxProcess::Exists( m_pid ) )
+    {
+        wxProcess::Kill( m_pid, wxSIGKILL );
+        m_process->Detach();  // wx deletes it when the host terminates.
+    }
+    else
+    {
+        delete m_process;
+    }
+    m_process = NULL;
+}
+
+/************************* END OF FILE ***************************************/
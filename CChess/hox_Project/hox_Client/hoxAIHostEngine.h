@@ -0,0 +1,106 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxAIHostEngine.h
+// Created:         10/19/2026
+//
+// Description:     An AI Engine running out of process, in the Engine Host.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_HOX_AI_HOST_ENGINE_H__
+#define __INCLUDED_HOX_AI_HOST_ENGINE_H__
+
+#include <wx/wx.h>
+#include <wx/process.h>
+#include "../plugins/common/AIEngineLib.h"
+#include "../plugins/common/DefaultDelete.h"
+
+/* Forward declarations */
+class AIHostWriter;
+class AIHostReader;
+
+/**
+ * An AI Engine Plugin loaded by the Engine Host (AI_host) instead of the
+ * client.  Every call is forwarded over the pipes of the host (see
+ * AIHostProtocol.h), so the AI Player and its thread use it like any
+ * other plugin.  If the host dies, the calls fail (no move is generated)
+ * but the client keeps running.
+ */
+class hoxAIHostEngine : public DefaultDelete<AIEngineLib>
+{
+public:
+    /**
+     * @param sHostCommand The host and its options, e.g. "AI_host -c 2 -m 512".
+     * @param sPluginPath  The plugin to be loaded by the host.
+     */
+    hoxAIHostEngine( const wxString& sHostCommand,
+                     const wxString& sPluginPath );
+    virtual ~hoxAIHostEngine();
+
+    bool IsAlive() const { return m_process != NULL; }
+
+    // **** Override the parent's API ****
+    virtual void        destroy() { delete this; }
+    virtual void        initEngine( int nAILevel = 0 );
+    virtual int         initGame( const std::string& fen,
+                                  const MoveList&    moves );
+    virtual std::string generateMove();
+    virtual void        onHumanMove( const std::string& sMove );
+    virtual int         setDifficultyLevel( int nAILevel );
+    virtual std::string getInfo();
+    virtual int         listOptions( AIOptionList& options );
+    virtual int         setOption( const std::string& name,
+                                   const std::string& value );
+    virtual int         initGameBinary( const AIPosition* position,
+                                        const AIMove*     moves,
+                                        int               nMoves );
+    virtual AIMove      generateMoveBinary();
+    virtual void        onHumanMoveBinary( AIMove move );
+    virtual int         getSearchInfo( AISearchInfo& info );
+    virtual int         benchSearch( int           depth,
+                                     AIMove&       move,
+                                     AISearchInfo& info );
+    virtual int         setSearchListener( AISearchListener* listener );
+
+private:
+    int  _Call( AIHostWriter& request, std::string& reply );
+        /* Sends a request and waits for its reply.  Returns the
+         * return-code of the reply, or hoxAI_RC_ERR if the host is gone.
+         * The reply is given without its command, slot and return-code. */
+
+    int  _GetSearchInfo( AIHostReader& reader, AISearchInfo& info );
+        /* Reads the SEARCH_INFO part of a reply. */
+
+    void _OnProgress( AIHostReader& reader );
+        /* Passes a PROGRESS frame on to the listener. */
+
+    bool _Read( char* buf, size_t n );
+    void _DrainErrors();
+    void _Kill();
+
+private:
+    wxProcess*       m_process;  // NULL if the host is not running.
+    long             m_pid;
+    wxMutex          m_mutex;    // One request at a time.
+    AISearchListener* m_listener; // NULL if none.
+};
+
+#endif /* __INCLUDED_HOX_AI_HOST_ENGINE_H__ */
@@ -29,14 +29,46 @@
 #include "hoxUtil.h"
 #include "hoxReferee.h"
 #include "hoxTable.h"
-#include "../plugins/common/AIEngineLib.h"
+
+/* The least time (in milliseconds) between two hoxEVT_AI_SEARCH_INFO. */
+#define hoxAI_SEARCH_INFO_INTERVAL  250
+
+wxDEFINE_EVENT(hoxEVT_AI_SEARCH_INFO, wxCommandEvent);
 
 IMPLEMENT_DYNAMIC_CLASS(hoxAIPlayer, hoxPlayer)
 
 BEGIN_EVENT_TABLE(hoxAIPlayer, hoxPlayer)
     EVT_COMMAND(wxID_ANY, hoxEVT_CONNECTION_RESPONSE, hoxAIPlayer::OnConnectionResponse)
+    EVT_COMMAND(wxID_ANY, hoxEVT_AI_SEARCH_INFO, hoxAIPlayer::OnAISearchInfo)
 END_EVENT_TABLE()
 
+//-----------------------------------------------------------------------------
+// hoxAISearchInfo
+//-----------------------------------------------------------------------------
+
+hoxAISearchInfo::hoxAISearchInfo( const AISearchProgress& progress )
+            : depth( progress.depth )
+            , selDepth( progress.selDepth )
+            , score( progress.score )
+            , nodes( progress.nodes )
+            , msecs( progress.msecs )
+            , nps( 0 )
+            , hashFull( progress.hashFull )
+{
+    if ( msecs > 0 )
+    {
+        nps = (unsigned long) ( (double) nodes * 1000 / msecs );
+    }
+
+    char szMove[5];
+    for ( int i = 0; i < progress.pvLength; ++i )
+    {
+        AIMoveToString( progress.pv[i], szMove );
+        if ( i > 0 ) pv += " ";
+        pv += szMove;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // hoxAIPlayer
 //-----------------------------------------------------------------------------
@@ -61,7 +93,7 @@ hoxAIPlayer::Start()
     hoxAIConnection* conn = new hoxAIConnection( this );
     hoxConnection_APtr connection( conn );
     this->SetConnection( connection ); // Release control.
-    conn->StartAIEngine( m_engineAPI );
+    conn->StartAIEngine( m_engineAPI, m_sStatsFile );
 }
 
 void 
@@ -92,6 +124,20 @@ hoxAIPlayer::OnConnectionResponse( wxCommandEvent& event )
     }
 }
 
+void
+hoxAIPlayer::OnAISearchInfo( wxCommandEvent& event )
+{
+    const std::auto_ptr<hoxAISearchInfo> apInfo(
+                wxDynamicCast(event.GetEventObject(), hoxAISearchInfo) );
+
+    hoxTable_SPtr pTable = this->GetFrontTable();
+    hoxPracticeTable* practiceTable( wxDynamicCast(pTable.get(), hoxPracticeTable) );
+    if ( practiceTable )  // ... else the table is being closed.
+    {
+        practiceTable->OnAISearchInfo( event );
+    }
+}
+
 wxString
 hoxAIPlayer::GetInfo() const
 {
@@ -108,12 +154,16 @@ hoxAIPlayer::GetInfo() const
 // hoxAIEngine
 // ----------------------------------------------------------------------------
 
-hoxAIEngine::hoxAIEngine( wxEvtHandler* player,
-                          AIEngineLib*  engineAPI /* = NULL */ )
+hoxAIEngine::hoxAIEngine( wxEvtHandler*   player,
+                          AIEngineLib*    engineAPI /* = NULL */,
+                          const wxString& sStatsFile /* = "" */ )
         : wxThread( wxTHREAD_JOINABLE )
         , m_player( player )
         , m_shutdownRequested( false )
         , m_engineAPI( engineAPI )
+        , m_sStatsFile( sStatsFile )
+        , m_nMoves( 0 )
+        , m_lastPostTime( 0 )
 {
 }
 
@@ -139,6 +189,11 @@ hoxAIEngine::Entry()
 
     wxLogDebug("%s: ENTER.", __FUNCTION__);
 
+    if ( m_engineAPI )
+    {
+        m_engineAPI->setSearchListener( this );  // Not all engines support it.
+    }
+
     while (   !m_shutdownRequested
             && m_semRequests.Wait() == wxSEMA_NO_ERROR )
     {
@@ -154,6 +209,11 @@ hoxAIEngine::Entry()
         this->HandleRequest( apRequest );
     }
 
+    if ( m_engineAPI )
+    {
+        m_engineAPI->setSearchListener( NULL );
+    }
+
     wxLogDebug("%s: END.", __FUNCTION__);
     return NULL;
 }
@@ -179,6 +239,22 @@ hoxAIEngine::HandleRequest( hoxRequest_APtr apRequest )
             }
             break;
         }
+        case hoxREQUEST_AI_OPTION:
+        {
+            const wxString sName  = apRequest->parameters["name"];
+            const wxString sValue = apRequest->parameters["value"];
+            if ( m_engineAPI )
+            {
+                const int nRet = m_engineAPI->setOption( hoxUtil::wx2std( sName ),
+                                                         hoxUtil::wx2std( sValue ) );
+                if ( nRet != hoxAI_RC_OK )
+                {
+                    wxLogDebug("%s: *WARN* Failed to set option [%s] = [%s]. Error = [%d].",
+                        __FUNCTION__, sName.c_str(), sValue.c_str(), nRet);
+                }
+            }
+            break;
+        }
         default:
         {
             wxLogDebug("%s: *WARN* Unsupported Request [%s].", 
@@ -204,9 +280,19 @@ hoxAIEngine::_HandleRequest_MOVE( hoxRequest_APtr apRequest )
             return;
     }
 
+    ++m_nMoves;
+    m_lastPostTime = 0;
     const wxString sNextMove = this->GenerateNextMove();
     wxLogDebug("%s: Generated next Move = [%s].", __FUNCTION__, sNextMove.c_str());
 
+    /* The last iteration is always shown, before the move. */
+    if ( m_pending.depth > 0 )
+    {
+        _PostSearchInfo( m_pending );
+        m_pending.depth = 0;
+    }
+    if ( m_statsFile.IsOpened() ) m_statsFile.Flush();
+
     /* Notify the Player. */
     const hoxRequestType type = apRequest->type;
     hoxResponse_APtr apResponse( new hoxResponse(type) );
@@ -220,10 +306,15 @@ hoxAIEngine::_HandleRequest_MOVE( hoxRequest_APtr apRequest )
 void
 hoxAIEngine::OnOpponentMove( const wxString& sMove )
 {
-    if ( m_engineAPI )
+    if ( m_engineAPI && sMove.size() == 4 )
     {
-        const std::string stdMove = hoxUtil::wx2std( sMove );
-        m_engineAPI->onHumanMove( stdMove );
+        /* Hand the move over in binary form (no std::string). */
+        char szMove[5];
+        for ( int i = 0; i < 4; ++i ) szMove[i] = (char) sMove[i];
+        szMove[4] = '\0';
+
+        const AIMove move = AIMoveFromString( szMove );
+        if ( move != hoxAI_MOVE_NONE ) m_engineAPI->onHumanMoveBinary( move );
     }
 }
 
@@ -232,12 +323,64 @@ hoxAIEngine::GenerateNextMove()
 {
     if ( m_engineAPI )
     {
-        std::string stdMove = m_engineAPI->generateMove();
-        return hoxUtil::std2wx( stdMove );
+        const AIMove move = m_engineAPI->generateMoveBinary();
+        if ( move != hoxAI_MOVE_NONE )
+        {
+            char szMove[5];
+            AIMoveToString( move, szMove );
+            return szMove;
+        }
     }
     return ""; // NOTE: An invalid move;
 }
 
+void
+hoxAIEngine::onSearchProgress( const AISearchProgress& progress )
+{
+    _WriteStats( progress );
+
+    /* Throttle the events: the UI only needs a few per second. */
+    const wxLongLong now = ::wxGetLocalTimeMillis();
+    if ( now - m_lastPostTime < hoxAI_SEARCH_INFO_INTERVAL )
+    {
+        m_pending = progress;  // ... posted later unless a newer one comes.
+        return;
+    }
+    m_lastPostTime = now;
+    m_pending.depth = 0;
+    _PostSearchInfo( progress );
+}
+
+void
+hoxAIEngine::_PostSearchInfo( const AISearchProgress& progress )
+{
+    wxCommandEvent event( hoxEVT_AI_SEARCH_INFO );
+    event.SetEventObject( new hoxAISearchInfo( progress ) );  // Caller will de-allocate.
+    wxPostEvent( m_player, event );
+}
+
+void
+hoxAIEngine::_WriteStats( const AISearchProgress& progress )
+{
+    if ( m_sStatsFile.empty() ) return;
+
+    if ( ! m_statsFile.IsOpened() )
+    {
+        if ( ! m_statsFile.Open( m_sStatsFile, "a" ) )
+        {
+            wxLogDebug("%s: *WARN* Failed to open [%s].", __FUNCTION__, m_sStatsFile.c_str());
+            m_sStatsFile.clear();  // Do not try again.
+            return;
+        }
+        m_statsFile.Write( "# move\tdepth\tseldepth\tscore\tnodes\tmsecs\tnps\thashfull\tpv\n" );
+    }
+
+    const hoxAISearchInfo info( progress );
+    m_statsFile.Write( wxString::Format("%d\t%d\t%d\t%d\t%lu\t%lu\t%lu\t%d\t%s\n",
+        m_nMoves, info.depth, info.selDepth, info.score, info.nodes,
+        info.msecs, info.nps, info.hashFull, info.pv.c_str()) );
+}
+
 hoxRequest_APtr
 hoxAIEngine::_GetRequest()
 {
@@ -308,13 +451,15 @@ hoxAIConnection::AddRequest( hoxRequest_APtr apRequest )
 }
 
 void
-hoxAIConnection::CreateAIEngine( AIEngineLib* engineAPI )
+hoxAIConnection::CreateAIEngine( AIEngineLib*    engineAPI,
+                                 const wxString& sStatsFile )
 {
-    m_aiEngine.reset( new hoxAIEngine( this->GetPlayer(), engineAPI ) );
+    m_aiEngine.reset( new hoxAIEngine( this->GetPlayer(), engineAPI, sStatsFile ) );
 }
 
 void
-hoxAIConnection::StartAIEngine( AIEngineLib* engineAPI )
+hoxAIConnection::StartAIEngine( AIEngineLib*    engineAPI,
+                                const wxString& sStatsFile /* = "" */ )
 {
     if ( m_aiEngine && m_aiEngine->IsRunning() )
     {
@@ -323,7 +468,7 @@ hoxAIConnection::StartAIEngine( AIEngineLib* engineAPI )
     }
 
     wxLogDebug("%s: Create the AI Engine Thread...", __FUNCTION__);
-    this->CreateAIEngine( engineAPI);
+    this->CreateAIEngine( engineAPI, sStatsFile );
 
     if ( m_aiEngine->Create() != wxTHREAD_NO_ERROR )
     {
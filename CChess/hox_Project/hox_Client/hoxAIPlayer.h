@@ -31,9 +31,30 @@
 #include "hoxPlayer.h"
 #include "hoxTypes.h"
 #include "hoxConnection.h"
+#include "../plugins/common/AIEngineLib.h"
+#include <wx/ffile.h>
 
-/* Forward declaration */
-class AIEngineLib;
+/* The progress of the AI's search (see hoxAISearchInfo). */
+wxDECLARE_EVENT(hoxEVT_AI_SEARCH_INFO, wxCommandEvent);
+
+/**
+ * An iteration of a search of the AI, as the event-object of
+ * hoxEVT_AI_SEARCH_INFO.
+ */
+class hoxAISearchInfo : public wxObject
+{
+public:
+    int            depth;
+    int            selDepth;  // 0 if unknown.
+    int            score;     // For the AI, in the engine's own units.
+    unsigned long  nodes;
+    unsigned long  msecs;
+    unsigned long  nps;       // Nodes per second.
+    int            hashFull;  // Per mille, 0 if unknown.
+    wxString       pv;        // The best line, such as "7747 7062".
+
+    hoxAISearchInfo( const AISearchProgress& progress );
+};
 
 /**
  * The AI player.
@@ -56,16 +77,20 @@ public:
      *******************************/
 
     void OnConnectionResponse( wxCommandEvent& event ); 
+    void OnAISearchInfo( wxCommandEvent& event );
 
      /*******************************
      * Other API
      *******************************/
 
     void SetEngineAPI( AIEngineLib*  engineAPI ) { m_engineAPI = engineAPI; }
+    void SetStatsFile( const wxString& sFile ) { m_sStatsFile = sFile; }
+        /* Where to log the searches (before Start). */
     wxString GetInfo() const;
 
 protected:
     AIEngineLib*  m_engineAPI;
+    wxString      m_sStatsFile;
 
 private:
 
@@ -78,14 +103,19 @@ private:
 // ----------------------------------------------------------------------------
 
 class hoxAIEngine : public wxThread
+                  , public AISearchListener
 {
 public:
-    hoxAIEngine( wxEvtHandler* player,
-                 AIEngineLib*  engineAPI = NULL );
+    hoxAIEngine( wxEvtHandler*   player,
+                 AIEngineLib*    engineAPI = NULL,
+                 const wxString& sStatsFile = "" );
     virtual ~hoxAIEngine() {}
 
     bool AddRequest( hoxRequest_APtr apRequest );
 
+    // **** AISearchListener (on this thread) ****
+    virtual void onSearchProgress( const AISearchProgress& progress );
+
 protected:
     virtual void* Entry();  // Entry point for the thread
 
@@ -98,6 +128,9 @@ private:
     void            _HandleRequest_MOVE( hoxRequest_APtr apRequest );
     hoxRequest_APtr _GetRequest();
 
+    void            _PostSearchInfo( const AISearchProgress& progress );
+    void            _WriteStats( const AISearchProgress& progress );
+
 protected:
     wxEvtHandler*           m_player;
 
@@ -109,6 +142,14 @@ protected:
                 /* Has a shutdown-request been received? */
 
     AIEngineLib*             m_engineAPI;
+
+    wxString                m_sStatsFile;  // "" if the searches are not logged.
+    wxFFile                 m_statsFile;
+    int                     m_nMoves;      // The moves generated so far.
+
+    wxLongLong              m_lastPostTime;
+    AISearchProgress        m_pending;
+                /* The last iteration, if not posted yet (depth = 0 if none). */
 };
 
 // ----------------------------------------------------------------------------
@@ -135,10 +176,12 @@ public:
     virtual bool IsConnected() const { return true; }
 
     // *** My own.
-    virtual void StartAIEngine( AIEngineLib* engineAPI );
+    virtual void StartAIEngine( AIEngineLib*    engineAPI,
+                                const wxString& sStatsFile = "" );
 
 protected:
-    virtual void CreateAIEngine( AIEngineLib* engineAPI );
+    virtual void CreateAIEngine( AIEngineLib*    engineAPI,
+                                 const wxString& sStatsFile );
 
 protected:
     hoxAIEngine_SPtr  m_aiEngine; // The AI Engine thread.
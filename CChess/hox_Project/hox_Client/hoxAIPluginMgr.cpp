@@ -27,6 +27,7 @@
 
 #include "hoxAIPluginMgr.h"
 #include "hoxUtil.h"
+#include "hoxAIHostEngine.h"
 #include <wx/dir.h>
 
 // --------------------------------------------------------------------------
@@ -61,6 +62,22 @@ hoxAIPlugin::CreateAIEngineLib()
     return apEngine;
 }
 
+bool
+hoxAIPlugin::GetOptions( AIOptionList& options )
+{
+    if ( ! m_pCreateAIEngineLibFunc )
+    {
+        wxLogWarning("%s: There is no 'Create AI Engine' function.", __FUNCTION__);
+        return false;
+    }
+
+    /* NOTE: The engine is not initialized (no hash table allocated...)
+     *       since it is only asked for its options.
+     */
+    AIEngineLib_APtr apEngine( m_pCreateAIEngineLibFunc() );
+    return ( apEngine->listOptions( options ) == hoxAI_RC_OK );
+}
+
 bool
 hoxAIPlugin::IsLoaded() const
 {
@@ -126,6 +143,9 @@ hoxAIPluginMgr::m_instance = NULL;
 wxString
 hoxAIPluginMgr::m_defaultPluginName = "";
 
+wxString
+hoxAIPluginMgr::m_engineHost = "";
+
 /* static */
 hoxAIPluginMgr* 
 hoxAIPluginMgr::GetInstance()
@@ -150,6 +170,13 @@ hoxAIPluginMgr::SetDefaultPluginName( const wxString& sDefaultName )
     m_defaultPluginName = sDefaultName;
 }
 
+/* static */
+void
+hoxAIPluginMgr::SetEngineHost( const wxString& sHostCommand )
+{
+    m_engineHost = sHostCommand;
+}
+
 const wxString
 hoxAIPluginMgr::GetDefaultPluginName() const
 {
@@ -197,6 +224,24 @@ hoxAIPluginMgr::CreateDefaultAIEngineLib()
         return apEngine;
     }
 
+    // --- Run the engine out of process, if requested.
+    //     The plugin itself is not loaded by the client.
+
+    hoxAIPluginMap::const_iterator found_it = m_aiPlugins.find( sName );
+    if ( !m_engineHost.empty() && found_it != m_aiPlugins.end() )
+    {
+        hoxAIHostEngine* hostEngine =
+            new hoxAIHostEngine( m_engineHost, found_it->second->m_path );
+        apEngine.reset( hostEngine );
+        if ( hostEngine->IsAlive() )
+        {
+            apEngine->initEngine();
+            return apEngine;
+        }
+        wxLogWarning("%s: Run the AI Engine [%s] in process instead.", __FUNCTION__, sName.c_str());
+        apEngine.reset();
+    }
+
     hoxAIPlugin_SPtr pPlugin = _loadPlugin( sName );
 
     if ( !pPlugin || !pPlugin->IsLoaded() )
@@ -224,6 +269,21 @@ hoxAIPluginMgr::GetNamesOfAllAIPlugins() const
     return aiNames;
 }
 
+bool
+hoxAIPluginMgr::GetOptionsOfAIPlugin( const wxString& sName,
+                                      AIOptionList&   options )
+{
+    hoxAIPlugin_SPtr pPlugin = _loadPlugin( sName );
+
+    if ( !pPlugin || !pPlugin->IsLoaded() )
+    {
+        wxLogWarning("%s: The AI Engine [%s] could not be loaded.", __FUNCTION__, sName.c_str());
+        return false;
+    }
+
+    return pPlugin->GetOptions( options );
+}
+
 bool
 hoxAIPluginMgr::_loadAvailableAIPlugins()
 {
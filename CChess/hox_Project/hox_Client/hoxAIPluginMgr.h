@@ -50,6 +50,7 @@ public:
     const wxString GetName() const { return m_name; }
 
     AIEngineLib_APtr CreateAIEngineLib();
+    bool GetOptions( AIOptionList& options );
     bool IsLoaded() const;
     bool Load();
     bool Unload();
@@ -75,15 +76,21 @@ public:
 	static hoxAIPluginMgr* GetInstance();
     static void            DeleteInstance();
     static void SetDefaultPluginName( const wxString& sDefaultName );
+    static void SetEngineHost( const wxString& sHostCommand );
+        /* If set, the engines run out of process inside the Engine Host
+         * (e.g. "../AI_host/AI_host -c 1 -m 512"). */
     
     const wxString GetDefaultPluginName() const;
     AIEngineLib_APtr CreateDefaultAIEngineLib();
     wxArrayString GetNamesOfAllAIPlugins() const;
+    bool GetOptionsOfAIPlugin( const wxString& sName,
+                               AIOptionList&   options );
 
 private:
     hoxAIPluginMgr();
 	static hoxAIPluginMgr* m_instance;
     static wxString        m_defaultPluginName;
+    static wxString        m_engineHost;
 
     bool _loadAvailableAIPlugins();
     hoxAIPlugin_SPtr _loadPlugin( const wxString& sName );
@@ -34,55 +34,122 @@
 //
 // ----------------------------------------------------------------------------
 
-hoxAsyncSocket::hoxAsyncSocket( asio::io_service&       io_service,
-                                tcp::resolver::iterator endpoint_iter,
-                                wxEvtHandler*           evtHandler)
-        : _io_service( io_service )
+hoxAsyncSocket::hoxAsyncSocket( asio::io_service& io_service,
+                                wxEvtHandler*     evtHandler )
+        : m_strand( io_service )
+        , m_resolver( io_service )
         , m_socket( io_service )
-        , m_timer( io_service )
         , m_connectState( CONNECT_STATE_INIT )
         , m_evtHandler( evtHandler )
+        , m_bClosing( false )
 {
+}
+
+void
+hoxAsyncSocket::connect( const std::string& sHost,
+                         const std::string& sService )
+{
+    m_strand.post( boost::bind(&hoxAsyncSocket::_doConnect, shared_from_this(),
+                               sHost, sService) );
+}
+
+void
+hoxAsyncSocket::_doConnect( const std::string sHost,
+                            const std::string sService )
+{
+    if ( m_bClosing || m_connectState == CONNECT_STATE_CLOSED )
+    {
+        return;  // Closed before the connect started.
+    }
     m_connectState = CONNECT_STATE_CONNECTING;
-    tcp::endpoint endpoint = *endpoint_iter;
-    m_socket.async_connect( endpoint,
-                            boost::bind(&hoxAsyncSocket::handleConnect, this,
-                                        asio::placeholders::error, ++endpoint_iter));
+    tcp::resolver::query query( sHost, sService );
+    m_resolver.async_resolve( query,
+                              m_strand.wrap(
+                                  boost::bind(&hoxAsyncSocket::_handleResolve, shared_from_this(),
+                                              asio::placeholders::error,
+                                              asio::placeholders::iterator)));
 }
 
 void
 hoxAsyncSocket::write( const std::string& msg )
 {
-    out_tries_ = 0;
-    out_msg_   = msg;  // *** make a copy
-    _io_service.post( boost::bind(&hoxAsyncSocket::_doWrite, this, out_msg_) );
+    m_strand.post( boost::bind(&hoxAsyncSocket::_doWrite, shared_from_this(), msg) );
 }
 
 void
 hoxAsyncSocket::close()
 {
-    _io_service.post( boost::bind(&hoxAsyncSocket::closeSocket, this) );
+    m_strand.post( boost::bind(&hoxAsyncSocket::_doClose, shared_from_this()) );
+}
+
+void
+hoxAsyncSocket::_handleResolve( const asio::error_code& error,
+                                tcp::resolver::iterator endpoint_iter )
+{
+    if ( m_connectState == CONNECT_STATE_CLOSED )
+    {
+        return;  // Closed meanwhile.
+    }
+    if ( error || endpoint_iter == tcp::resolver::iterator() )
+    {
+        m_connectState = CONNECT_STATE_CLOSED;
+        wxLogDebug("%s: *WARN* Fail to resolve the host.", __FUNCTION__);
+        this->postEvent( hoxRC_CLOSED, "Fail to resolve the host", hoxREQUEST_LOGIN );
+        return;
+    }
+    asyncConnect( endpoint_iter );
+}
+
+void
+hoxAsyncSocket::asyncConnect( tcp::resolver::iterator endpoint_iter )
+{
+    tcp::endpoint endpoint = *endpoint_iter;
+    m_socket.async_connect( endpoint,
+                            m_strand.wrap(
+                                boost::bind(&hoxAsyncSocket::handleConnect, shared_from_this(),
+                                            asio::placeholders::error, ++endpoint_iter)));
+}
+
+bool
+hoxAsyncSocket::isConnectAborted( const asio::error_code& error ) const
+{
+    return (    error == asio::error::operation_aborted
+             || m_bClosing
+             || m_connectState == CONNECT_STATE_CLOSED );
+}
+
+void
+hoxAsyncSocket::onConnected()
+{
+    m_connectState = CONNECT_STATE_CONNECTED;
+    if ( !m_writeQueue.empty() && m_writingQueue.empty() )
+    {
+        _startWrite();
+    }
 }
 
 void
 hoxAsyncSocket::handleConnect( const asio::error_code& error,
                                tcp::resolver::iterator endpoint_iter)
 {
+    if ( isConnectAborted( error ) )
+    {
+        return;  // Closed meanwhile: do not try the next endpoint.
+    }
+
     if ( !error )
     {
-        m_connectState = CONNECT_STATE_CONNECTED;
+        onConnected();
         wxLogDebug("%s: Connection established.", __FUNCTION__);
         asio::async_read_until( m_socket, m_inBuffer, "\n\n",
-                                boost::bind(&hoxAsyncSocket::handleIncomingData, this,
-                                            asio::placeholders::error));
+                                m_strand.wrap(
+                                    boost::bind(&hoxAsyncSocket::handleIncomingData, shared_from_this(),
+                                                asio::placeholders::error)));
     }
     else if ( endpoint_iter != tcp::resolver::iterator() )
     {
         m_socket.close();
-        tcp::endpoint endpoint = *endpoint_iter;
-        m_socket.async_connect( endpoint,
-                                boost::bind(&hoxAsyncSocket::handleConnect, this,
-                                            asio::placeholders::error, ++endpoint_iter));
+        asyncConnect( endpoint_iter );
     }
     else  // Failed.
     {
@@ -130,8 +197,9 @@ hoxAsyncSocket::handleIncomingData( const asio::error_code& error )
 
     // Read incoming data (AGAIN!).
     asio::async_read_until( m_socket, m_inBuffer, "\n\n",
-                            boost::bind(&hoxAsyncSocket::handleIncomingData, this,
-                                        asio::placeholders::error));
+                            m_strand.wrap(
+                                boost::bind(&hoxAsyncSocket::handleIncomingData, shared_from_this(),
+                                            asio::placeholders::error)));
 }
 
 void
@@ -139,33 +207,47 @@ hoxAsyncSocket::_doWrite( const std::string msg )
 {
     if ( m_connectState == CONNECT_STATE_CLOSED )
     {
-        wxLogDebug("%s: Connection closed. Abort (tries = [%d]).", __FUNCTION__, out_tries_);
+        wxLogDebug("%s: Connection closed. Abort.", __FUNCTION__);
         return;
     }
-    else if ( m_connectState != CONNECT_STATE_CONNECTED )
+
+    m_writeQueue.push_back(msg);
+    if ( m_writingQueue.empty() && m_connectState == CONNECT_STATE_CONNECTED )
     {
-        const int WAIT_INTERVAL = 100; // in milliseconds.
-        const int MAX_TRIES     = 200; // a total of 20 seconds!!!
-        if ( ++out_tries_ > MAX_TRIES )   
-        {
-            wxLogDebug("%s: Timeout after [%d] tries.", __FUNCTION__, out_tries_);
-            return;
-        }
-        m_timer.expires_from_now(boost::posix_time::milliseconds(WAIT_INTERVAL));
-        m_timer.async_wait(boost::bind(&hoxAsyncSocket::_doWrite, this, msg));
-        return;
+        _startWrite();
     }
+    /* ... else, written with the next write, or once connected
+     *     (see onConnected).
+     */
+}
 
-    const bool write_in_progress = !m_writeQueue.empty();
-    m_writeQueue.push_back(msg);
-    if ( !write_in_progress )
+void
+hoxAsyncSocket::_startWrite()
+{
+    size_t nBytes = 0;
+    while (    !m_writeQueue.empty()
+            && m_writingQueue.size() < MAX_WRITE_MESSAGES
+            && ( m_writingQueue.empty()
+                 || nBytes + m_writeQueue.front().length() <= MAX_WRITE_BYTES ) )
     {
-        asio::async_write( m_socket,
-                           asio::buffer( m_writeQueue.front().data(),
-                                         m_writeQueue.front().length()),
-                           boost::bind( &hoxAsyncSocket::_handleWrite, this,
-                                        asio::placeholders::error));
+        m_writingQueue.push_back( std::string() );
+        m_writingQueue.back().swap( m_writeQueue.front() );  // No copy.
+        m_writeQueue.pop_front();
+        nBytes += m_writingQueue.back().length();
     }
+
+    m_writeBuffers.clear();
+    for ( MessageQueue::const_iterator it = m_writingQueue.begin();
+                                       it != m_writingQueue.end(); ++it )
+    {
+        m_writeBuffers.push_back( asio::buffer( it->data(), it->length() ) );
+    }
+
+    asio::async_write( m_socket,
+                       m_writeBuffers,
+                       m_strand.wrap(
+                           boost::bind( &hoxAsyncSocket::_handleWrite, shared_from_this(),
+                                        asio::placeholders::error)));
 }
 
 void
@@ -178,17 +260,32 @@ hoxAsyncSocket::_handleWrite( const asio::error_code& error )
         return;
     }
 
-    m_writeQueue.pop_front();
+    m_writingQueue.clear();
     if ( !m_writeQueue.empty() )
     {
-        asio::async_write( m_socket,
-                           asio::buffer( m_writeQueue.front().data(),
-                                         m_writeQueue.front().length()),
-                           boost::bind( &hoxAsyncSocket::_handleWrite, this,
-                                        asio::placeholders::error));
+        _startWrite();
+    }
+    else if ( m_bClosing )
+    {
+        closeSocket();  // The last write of close() is done.
     }
 }
 
+void
+hoxAsyncSocket::_doClose()
+{
+    m_bClosing = true;
+    if (    ( m_writeQueue.empty() && m_writingQueue.empty() )
+         || m_connectState == CONNECT_STATE_INIT
+         || m_connectState == CONNECT_STATE_CLOSED )
+    {
+        closeSocket();
+    }
+    /* ... else, closed by _handleWrite() once the writes are done
+     *     (the connection may still be in progress).
+     */
+}
+
 bool
 hoxAsyncSocket::checkAndCloseSocketIfError( const asio::error_code& error )
 {
@@ -217,6 +314,8 @@ hoxAsyncSocket::checkAndCloseSocketIfError( const asio::error_code& error )
 void
 hoxAsyncSocket::closeSocket()
 {
+    m_connectState = CONNECT_STATE_CLOSED;
+    m_resolver.cancel();
     m_socket.close();
 }
 
@@ -225,6 +324,11 @@ hoxAsyncSocket::postEvent( const hoxResult      result,
                            const std::string&   sEvent,
                            const hoxRequestType type /* = hoxREQUEST_PLAYER_DATA */ )
 {
+    if ( m_bClosing )
+    {
+        return;  // The event-handler may be gone.
+    }
+
     hoxResponse_APtr apResponse( new hoxResponse(type, result) );
 
     for ( std::string::const_iterator it = sEvent.begin(); it != sEvent.end(); ++it )
@@ -250,21 +354,24 @@ void
 hoxHttpSocket::handleConnect( const asio::error_code& error,
                               tcp::resolver::iterator endpoint_iter)
 {
+    if ( isConnectAborted( error ) )
+    {
+        return;  // Closed meanwhile: do not try the next endpoint.
+    }
+
     if ( !error )
     {
-        m_connectState = CONNECT_STATE_CONNECTED;
+        onConnected();
         wxLogDebug("%s: Connection established.", __FUNCTION__);
         asio::async_read_until( m_socket, m_inBuffer, "\r\n",
-                                boost::bind(&hoxHttpSocket::handleIncomingData, this,
-                                            asio::placeholders::error));
+                                m_strand.wrap(
+                                    boost::bind(&hoxAsyncSocket::handleIncomingData, shared_from_this(),
+                                                asio::placeholders::error)));
     }
     else if ( endpoint_iter != tcp::resolver::iterator() )
     {
         m_socket.close();
-        tcp::endpoint endpoint = *endpoint_iter;
-        m_socket.async_connect( endpoint,
-                                boost::bind(&hoxHttpSocket::handleConnect, this,
-                                            asio::placeholders::error, ++endpoint_iter));
+        asyncConnect( endpoint_iter );
     }
     else  // Failed.
     {
@@ -286,8 +393,9 @@ hoxHttpSocket::handleIncomingData( const asio::error_code& error )
     // Continue reading remaining data until EOF.
     asio::async_read( m_socket, m_inBuffer,
                       asio::transfer_at_least(1),
-                      boost::bind(&hoxHttpSocket::handleIncomingData, this,
-                                  asio::placeholders::error));
+                      m_strand.wrap(
+                          boost::bind(&hoxAsyncSocket::handleIncomingData, shared_from_this(),
+                                      asio::placeholders::error)));
 }
 
 std::string
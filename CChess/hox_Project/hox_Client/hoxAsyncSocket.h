@@ -31,15 +31,38 @@
 #include <asio.hpp>
 #include "hoxTypes.h"
 #include <deque>
+#include <vector>
 #include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
 
 using asio::ip::tcp;
 
+/* Forward declarations. */
+class hoxAsyncSocket;
+class hoxHttpSocket;
+
+/* Typedef(s) */
+typedef boost::shared_ptr<hoxAsyncSocket> hoxAsyncSocket_SPtr;
+typedef boost::shared_ptr<hoxHttpSocket>  hoxHttpSocket_SPtr;
+
 // ----------------------------------------------------------------------------
 // hoxAsyncSocket
 // ----------------------------------------------------------------------------
 
-class hoxAsyncSocket
+/**
+ * A Socket whose I/O is done by the threads of an I/O Service (usually the
+ * shared hoxIOService).  Its handlers run through a strand, so they never
+ * run concurrently, and write() and close() may be called from any thread.
+ *
+ * The Socket must be owned by a shared pointer: each pending handler holds
+ * one, so the Socket outlives its last handler.  Once close() is called,
+ * no more events are posted to the event-handler.
+ *
+ * The messages sent while a write is in progress are written together by
+ * the next one (a gather write), up to MAX_WRITE_MESSAGES messages or
+ * MAX_WRITE_BYTES bytes.
+ */
+class hoxAsyncSocket : public boost::enable_shared_from_this<hoxAsyncSocket>
 {
 protected:
     enum ConnectState
@@ -51,19 +74,28 @@ protected:
     };
 
 public:
-    hoxAsyncSocket( asio::io_service&       io_service,
-                    tcp::resolver::iterator endpoint_iter,
-                    wxEvtHandler*           evtHandler );
+    hoxAsyncSocket( asio::io_service& io_service,
+                    wxEvtHandler*     evtHandler );
     virtual ~hoxAsyncSocket() {}
 
+    void connect( const std::string& sHost,
+                  const std::string& sService );
+        /* Resolves the host (without blocking), then connects. */
+
     virtual void handleIncomingData( const asio::error_code& error );
 
     void write( const std::string& msg );
     void close();
+        /* Closes the Socket once the pending writes are done. */
 
 protected:
     virtual void handleConnect( const asio::error_code& error,
                                 tcp::resolver::iterator endpoint_iter );
+    void asyncConnect( tcp::resolver::iterator endpoint_iter );
+    bool isConnectAborted( const asio::error_code& error ) const;
+        /* Whether a connect attempt was cancelled by close(). */
+    void onConnected();
+        /* Marks the Socket connected, and writes what was sent so far. */
     // ----
     bool checkAndCloseSocketIfError( const asio::error_code& error );
     void closeSocket();
@@ -72,19 +104,36 @@ protected:
                     const hoxRequestType type = hoxREQUEST_PLAYER_DATA );
 
 private:
+    void _doConnect( const std::string sHost,
+                     const std::string sService );
+    void _handleResolve( const asio::error_code& error,
+                         tcp::resolver::iterator endpoint_iter );
     void _doWrite( const std::string msg );
+    void _startWrite();
+        /* Writes (at once) the oldest messages not written yet. */
     void _handleWrite( const asio::error_code& error );
+    void _doClose();
 
 protected:
-    asio::io_service&    _io_service; // A reference only!
+    asio::io_service::strand  m_strand;
+    tcp::resolver        m_resolver;
     tcp::socket          m_socket;
-    asio::deadline_timer m_timer;
- 
-    int                  out_tries_; // FIXME: Concurrency problem!
-    std::string          out_msg_;   // FIXME: Concurrency problem!
+
+    enum
+    {
+        MAX_WRITE_MESSAGES = 64,       // ... the buffers of one 'sendmsg'.
+        MAX_WRITE_BYTES    = 64 * 1024
+    };
 
     typedef std::deque<std::string> MessageQueue;
     MessageQueue         m_writeQueue;
+                /* The messages not written yet. */
+
+    MessageQueue         m_writingQueue;
+                /* The messages being written (empty if none). */
+
+    std::vector<asio::const_buffer> m_writeBuffers;
+                /* The buffers of the messages being written. */
 
     std::string          m_sCurrentEvent;
                 /* The incoming event (being accumulated so far). */
@@ -92,6 +141,9 @@ protected:
     asio::streambuf      m_inBuffer; // The buffer of incoming data.
     ConnectState         m_connectState;
     wxEvtHandler*        m_evtHandler;
+
+    bool                 m_bClosing;
+                /* Has close() been called (no more events then)? */
 };
 
 // ----------------------------------------------------------------------------
@@ -101,10 +153,9 @@ protected:
 class hoxHttpSocket : public hoxAsyncSocket
 {
 public:
-    hoxHttpSocket( asio::io_service&       io_service,
-                   tcp::resolver::iterator endpoint_iter,
-                   wxEvtHandler*           evtHandler )
-            : hoxAsyncSocket( io_service, endpoint_iter, evtHandler ) {}
+    hoxHttpSocket( asio::io_service& io_service,
+                   wxEvtHandler*     evtHandler )
+            : hoxAsyncSocket( io_service, evtHandler ) {}
     virtual ~hoxHttpSocket() {}
 
     std::string getResponse();
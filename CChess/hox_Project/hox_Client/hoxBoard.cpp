@@ -35,6 +35,7 @@
 #include "hoxTypes.h"
 #include "hoxTable.h"
 #include "hoxOptionDialog.h"
+#include "hoxAIPlayer.h"
 
 /* UI-related IDs. */
 enum
@@ -80,7 +81,6 @@ BEGIN_EVENT_TABLE(hoxBoard, wxPanel)
     EVT_UPDATE_UI(ID_ACTION_DRAW, hoxBoard::OnUpdateUI_ActionDraw)
     EVT_UPDATE_UI(ID_ACTION_RESET, hoxBoard::OnUpdateUI_ActionReset)
 
-    EVT_TIMER(wxID_ANY, hoxBoard::OnTimer)    
 END_EVENT_TABLE()
 
 // ----------------------------------------------------------------------------
@@ -97,6 +97,7 @@ public:
         , m_sCaption( sCaption )
         , m_nAILevel( nAILevel )
         , m_aiInfoText( NULL )
+        , m_searchInfoText( NULL )
         , m_playWithSelfCtrl( NULL )
     {
         _CreateUI();
@@ -107,6 +108,8 @@ public:
         if ( m_aiInfoText ) m_aiInfoText->SetLabel( sAIInfo );
     }
 
+    void SetSearchInfo( const hoxAISearchInfo& info );
+
     bool IsPlayWithSelf() const
     {
         return ( m_playWithSelfCtrl && m_playWithSelfCtrl->IsChecked() );
@@ -122,6 +125,7 @@ private:
     const wxString m_sCaption;
     int            m_nAILevel;
     wxStaticText*  m_aiInfoText; 
+    wxStaticText*  m_searchInfoText;
     wxCheckBox*    m_playWithSelfCtrl;
 
     DECLARE_EVENT_TABLE()
@@ -166,6 +170,10 @@ hoxAISettings::_CreateUI()
     aiSizer->AddSpacer(10);
     aiSizer->Add( infoSizer, wxSizerFlags().Expand().Border(wxALL,5) );
 
+    // The AI's search.
+    m_searchInfoText = new wxStaticText( this, wxID_ANY, "" );
+    aiSizer->Add( m_searchInfoText, wxSizerFlags().Expand().Border(wxALL,5) );
+
     mainSizer->Add( aiSizer, wxSizerFlags(1).Expand().Border(wxALL,1) );
 
     // ---
@@ -176,6 +184,28 @@ hoxAISettings::_CreateUI()
     mainSizer->AddStretchSpacer();
 }
 
+void
+hoxAISettings::SetSearchInfo( const hoxAISearchInfo& info )
+{
+    if ( m_searchInfoText == NULL ) return;
+
+    wxString sDepth = wxString::Format("%d", info.depth);
+    if ( info.selDepth > 0 ) sDepth += wxString::Format("/%d", info.selDepth);
+
+    wxString sInfo;
+    sInfo << _("Depth:") << " " << sDepth << "   "
+          << _("Score:") << wxString::Format(" %+d\n", info.score)
+          << _("Nodes:") << wxString::Format(" %lu   ", info.nodes)
+          << _("NPS:") << wxString::Format(" %lu", info.nps);
+    if ( info.hashFull > 0 )
+    {
+        sInfo << "   " << _("Hash:") << wxString::Format(" %d%%", info.hashFull / 10);
+    }
+    sInfo << "\n" << _("PV:") << " " << info.pv;
+
+    m_searchInfoText->SetLabel( sInfo );
+}
+
 void
 hoxAISettings::OnAISliderUpdate( wxScrollEvent& event )
 {
@@ -208,7 +238,8 @@ hoxBoard::hoxBoard( wxWindow*        parent,
         , m_ownerId( ownerId )
         , m_featureFlags( featureFlags )
         , m_bRated( true )
-		, m_timer( NULL )
+        , m_clockColor( hoxCOLOR_NONE )
+        , m_clockStart( 0 )
         , m_bUICreated( false )
         , m_playerListBox( NULL )
         , m_systemOutput( NULL )
@@ -229,10 +260,6 @@ hoxBoard::hoxBoard( wxWindow*        parent,
     /* Sync Info (Rated/Non-Rated + Timers) with Table's. */
     _SyncInfoWithTable();
 
-    /* A timer to keep track of the time. */
-    m_timer = new wxTimer( this );
-    m_timer->Start( hoxTIME_ONE_SECOND_INTERVAL );
-
     /* Prepare sounds. */
     const wxString soundFile( hoxUtil::GetPath(hoxRT_SOUND) + "move.wav" );
     m_soundMove.Create( soundFile );
@@ -243,14 +270,7 @@ hoxBoard::~hoxBoard()
 {
     wxLogDebug("%s: ENTER.", __FUNCTION__);
 
-    if ( m_timer != NULL )
-    {
-        if ( m_timer->IsRunning() )
-            m_timer->Stop();
-
-        delete m_timer;
-        m_timer = NULL;
-    }
+    _StopClock();
 
     if ( m_coreBoard != NULL )
     {
@@ -447,15 +467,16 @@ hoxBoard::OnNewMove( const wxString& sMove )
 }
 
 void
-hoxBoard::OnPastMoves( const hoxStringList& moves )
+hoxBoard::OnPastMoves( const hoxMoveHistory& moves )
 {
-    for ( hoxStringList::const_iterator it = moves.begin();
-                                        it != moves.end(); ++it )
+    for ( size_t i = 0; i < moves.size(); ++i )
     {
-        hoxMove move = m_referee->StringToMove( *it );
+        hoxMove move = m_referee->PositionsToMove( moves.GetFrom( i ),
+                                                   moves.GetTo( i ) );
         if ( ! move.IsValid() )
         {
-            wxLogError("%s: Failed to parse Move-string [%s].", __FUNCTION__, it->c_str());
+            wxLogError("%s: No Piece to make Move [%s].", __FUNCTION__,
+                moves.ToString( i ).c_str());
             return;
         }
 
@@ -504,7 +525,9 @@ hoxBoard::OnGameOver( const hoxGameStatus gameStatus,
     wxString boardMessage = _GetGameOverMessage( gameStatus );
     if ( !sReason.empty() ) boardMessage += " " + sReason;
 
+    _StopClock();
 	m_status = gameStatus;
+    _OnTimerUpdated();
 	this->OnBoardMsg( boardMessage );
 	m_coreBoard->SetGameOver( true );
     _UpdateActionButtons();
@@ -514,6 +537,7 @@ void
 hoxBoard::OnGameReset()
 {
     m_coreBoard->ResetBoard();
+    _StopClock();
     _SyncInfoWithTable();
 
     m_status = hoxGAME_STATUS_OPEN;
@@ -696,20 +720,14 @@ hoxBoard::OnUpdateUI_ActionReset( wxUpdateUIEvent& event )
 }
 
 void 
-hoxBoard::OnTimer( wxTimerEvent& event )
+hoxBoard::OnClockDue()
 {
     if ( m_status != hoxGAME_STATUS_IN_PROGRESS )
         return;
 
-    const hoxColor nextColor = m_referee->GetNextColor();
-    hoxTimeInfo* pNextTime = ( nextColor == hoxCOLOR_RED ? &m_redTime
-                                                         : &m_blackTime );
-	if ( pNextTime->nGame > 0 ) --pNextTime->nGame;
-	if ( pNextTime->nMove > 0 ) --pNextTime->nMove;
-    if ( pNextTime->nGame == 0
-      && pNextTime->nFree > 0 ) --pNextTime->nFree;
-
+    const long nElapsed = _UpdateClock( hoxClockService::Now() );
     _OnTimerUpdated();
+    _ScheduleClock( nElapsed );
 }
 
 void
@@ -1086,23 +1104,26 @@ void
 hoxBoard::OnValidMove( const hoxMove& move,
                        bool           bSetupMode /* = false */ )
 {
+    const hoxColor nextColor = ( move.piece.color == hoxCOLOR_RED ? hoxCOLOR_BLACK
+                                                                  : hoxCOLOR_RED );
+
     /* For the 1st move of BLACK, change the game-status to 'in-progress'. 
      */
     if ( m_status == hoxGAME_STATUS_READY
       && move.piece.color == hoxCOLOR_BLACK )
     {
         m_status = hoxGAME_STATUS_IN_PROGRESS;
-        /* NOTE: The above action is enough to trigger the timer which will
-         *       update the timer-related UI.
-         */
         _UpdateActionButtons();
     }
     /* If the game is in progress, reset the Move-time after each Move.
      */
     else if ( m_status == hoxGAME_STATUS_IN_PROGRESS )
     {
+        _StopClock();  // Count the time of the Move first.
+
 		if ( bSetupMode )
 		{
+            _StartClock( nextColor );
 			return;
 		}
 
@@ -1124,6 +1145,13 @@ hoxBoard::OnValidMove( const hoxMove& move,
         pNextTime->nMove = m_initialTime.nMove;
         pNextTime->nFree = m_initialTime.nFree;
 		if ( bIsChesscape ) pCurrTime->nGame += m_initialTime.nFree;
+        _OnTimerUpdated();
+    }
+
+    /* Now the clock of the other side is running. */
+    if ( m_status == hoxGAME_STATUS_IN_PROGRESS )
+    {
+        _StartClock( nextColor );
     }
 
     /* Play the sound for the MOVE. */
@@ -1199,6 +1227,9 @@ hoxBoard::_SyncInfoWithTable()
 	m_blackTime   = m_pTable->GetBlackTime();
 	m_redTime     = m_pTable->GetRedTime();
 
+    /* The running clock counts down from the new time. */
+    if ( m_clockColor != hoxCOLOR_NONE ) _StartClock( m_clockColor );
+
     _OnTimerUpdated();  // Update UI.
 }
 
@@ -1220,6 +1251,56 @@ hoxBoard::_OnTimerUpdated()
 	m_redFreeTime->SetLabel(   hoxUtil::FormatTime( m_redTime.nFree ) );
 }
 
+void
+hoxBoard::_StartClock( hoxColor color )
+{
+    hoxClockService::GetInstance()->Cancel( this );
+
+    m_clockColor = color;
+    m_clockBase  = ( color == hoxCOLOR_RED ? m_redTime : m_blackTime );
+    m_clockStart = hoxClockService::Now();
+    _ScheduleClock( 0 );
+}
+
+void
+hoxBoard::_StopClock()
+{
+    if ( m_clockColor == hoxCOLOR_NONE ) return;
+
+    _UpdateClock( hoxClockService::Now() );
+    m_clockColor = hoxCOLOR_NONE;
+    hoxClockService::GetInstance()->Cancel( this );
+}
+
+long
+hoxBoard::_UpdateClock( wxLongLong now )
+{
+    /* The time is computed from the start of the clock, not counted down
+     * by callbacks, which may be late.  As before, the Free time only
+     * starts with the last second of the Game time.
+     */
+    const long nElapsed = ( (now - m_clockStart) / hoxTIME_ONE_SECOND_INTERVAL ).ToLong();
+    const long nFreeElapsed = nElapsed - wxMax(m_clockBase.nGame - 1, 0);
+
+    hoxTimeInfo& time = ( m_clockColor == hoxCOLOR_RED ? m_redTime : m_blackTime );
+    time.nGame = (int) wxMax(m_clockBase.nGame - nElapsed, 0);
+    time.nMove = (int) wxMax(m_clockBase.nMove - nElapsed, 0);
+    time.nFree = (int) wxMax(m_clockBase.nFree - wxMax(nFreeElapsed, 0), 0);
+
+    return nElapsed;
+}
+
+void
+hoxBoard::_ScheduleClock( long nElapsed )
+{
+    const hoxTimeInfo& time = ( m_clockColor == hoxCOLOR_RED ? m_redTime : m_blackTime );
+    if ( time.nGame == 0 && time.nMove == 0 && time.nFree == 0 )
+        return;  // Nothing to display any more.
+
+    hoxClockService::GetInstance()->Schedule( this,
+        m_clockStart + (nElapsed + 1) * hoxTIME_ONE_SECOND_INTERVAL );
+}
+
 wxString
 hoxBoard::_GetGameOverMessage( const hoxGameStatus gameStatus ) const
 {
@@ -1268,6 +1349,7 @@ hoxBoard::_IsOwnerSeated() const
 
 BEGIN_EVENT_TABLE(hoxPracticeBoard, hoxBoard)
     EVT_COMMAND_SCROLL(wxID_ANY, hoxPracticeBoard::OnAISliderUpdate)
+    EVT_COMMAND(wxID_ANY, hoxEVT_AI_SEARCH_INFO, hoxPracticeBoard::OnAISearchInfo)
 END_EVENT_TABLE()
 
 bool
@@ -1360,4 +1442,14 @@ hoxPracticeBoard::OnAISliderUpdate( wxScrollEvent& event )
     }
 }
 
+void
+hoxPracticeBoard::OnAISearchInfo( wxCommandEvent& event )
+{
+    const hoxAISearchInfo* pInfo = wxDynamicCast(event.GetEventObject(), hoxAISearchInfo);
+    if ( pInfo && m_aiSettings )
+    {
+        m_aiSettings->SetSearchInfo( *pInfo );
+    }
+}
+
 /************************* END OF FILE ***************************************/
@@ -36,6 +36,7 @@
 #include "hoxCoreBoard.h"
 #include "hoxPlayersUI.h"
 #include "hoxChatPanel.h"
+#include "hoxClockService.h"
 #include <wx/sound.h>
 
 /* Forward declarations. */
@@ -66,6 +67,7 @@ class hoxAISettings;
 class hoxBoard : public wxPanel
                , public hoxCoreBoard::BoardOwner
                , public hoxPlayersUI::UIOwner
+               , public hoxClockService::Client
 {
 public:
     /**
@@ -133,6 +135,12 @@ public:
     virtual void OnPlayersUIEvent( hoxPlayersUI::EventType eventType,
                                    const wxString&         sPlayerId );
 
+    /*****************************************************
+     * Implement hoxClockService::Client 's interface.
+     *****************************************************/
+
+    virtual void OnClockDue();
+
     /*********************************
      * My custom event handler.
      *********************************/
@@ -147,7 +155,7 @@ public:
                        const wxString& sSenderId,
                        const bool      bPublic );
 	void OnNewMove( const wxString& sMove );
-    void OnPastMoves( const hoxStringList& moves );
+    void OnPastMoves( const hoxMoveHistory& moves );
 	void OnDrawRequest( const wxString& playerId,
                         const bool      bPopupRequest );
 	void OnGameOver( const hoxGameStatus gameStatus,
@@ -177,8 +185,6 @@ public:
     void OnUpdateUI_ActionDraw( wxUpdateUIEvent& event );
     void OnUpdateUI_ActionReset( wxUpdateUIEvent& event );
 
-    void OnTimer( wxTimerEvent& event );
-
     /*********************************
      * My MAIN public API
      *********************************/
@@ -252,6 +258,31 @@ private:
     void _SyncInfoWithTable();
     void _OnTimerUpdated();
 
+    /**
+     * Start the clock of a side (the other being stopped).
+     * Its current time is counted down from now.
+     * NOTE: The time of the clock running before is not brought up to date
+     *       (see _StopClock).
+     */
+    void _StartClock( hoxColor color );
+
+    /**
+     * Bring the time of the running clock up to date, and stop it.
+     */
+    void _StopClock();
+
+    /**
+     * Bring the time of the running clock up to date.
+     * @return The whole seconds elapsed since the clock was started.
+     */
+    long _UpdateClock( wxLongLong now );
+
+    /**
+     * Ask the Clock Service for a call when the running clock is to show
+     * a new second (unless all of its times are over).
+     */
+    void _ScheduleClock( long nElapsed );
+
     wxString _GetGameOverMessage( const hoxGameStatus gameStatus ) const;
 
     /**
@@ -287,11 +318,14 @@ protected:
 
     /* Timers */
 
-    wxTimer*          m_timer;       // To keep track of time.
 	hoxTimeInfo       m_initialTime; // *** Initial time.
 	hoxTimeInfo       m_blackTime;   // Black's time.
 	hoxTimeInfo       m_redTime;     // Red's time.
 
+    hoxColor          m_clockColor;  // The side running (NONE if stopped).
+    hoxTimeInfo       m_clockBase;   // Its time when it was started...
+    wxLongLong        m_clockStart;  // ... at this time (of the Clock Service).
+
     /* The flag to indicate whether all UI elements have been created.
      * NOTE: This flag is needed because we do not automatically create
      *       those elements in the constructor.
@@ -376,6 +410,7 @@ protected:
                                const hoxColor      playerColor );
     /* My own API */
     void OnAISliderUpdate( wxScrollEvent& event );
+    void OnAISearchInfo( wxCommandEvent& event );  // hoxEVT_AI_SEARCH_INFO
 
 private:
     hoxAISettings*    m_aiSettings;
@@ -26,6 +26,7 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "hoxCheckUpdatesUI.h"
+#include "hoxIOService.h"
 #include "hoxPlayer.h"   // just for hoxEVT_CONNECTION_RESPONSE
 #include <wx/hyperlink.h>
 
@@ -59,8 +60,6 @@ hoxCheckUpdatesUI::hoxCheckUpdatesUI( const wxString& title,
         , m_maximum( maximum )
         , m_timerValue( 0 )
         , m_timer( NULL )
-        , m_pHttpSocket( NULL )
-        , m_io_service_thread( NULL )
 {
     m_timer = new wxTimer( this );
     m_timer->Start( hoxTIME_ONE_SECOND_INTERVAL );
@@ -75,8 +74,10 @@ hoxCheckUpdatesUI::~hoxCheckUpdatesUI()
         m_timer = NULL;
     }
 
-    delete m_pHttpSocket;
-    delete m_io_service_thread;
+    if ( m_pHttpSocket )
+    {
+        m_pHttpSocket->close();  // ... freed after its last handler.
+    }
 }
 
 void
@@ -105,12 +106,9 @@ hoxCheckUpdatesUI::runCheck()
 
     try
     {
-        tcp::resolver resolver( m_io_service );
-        tcp::resolver::query query( sHost, sService );
-        tcp::resolver::iterator iterator = resolver.resolve(query);
-
-        m_pHttpSocket = new hoxHttpSocket( m_io_service, iterator,
-                                           this /* evtHandler */ );
+        m_pHttpSocket.reset( new hoxHttpSocket( hoxIOService::GetInstance()->GetService(),
+                                                this /* evtHandler */ ) );
+        m_pHttpSocket->connect( sHost, sService );
 
         // Send the HTTP GET request.
         std::string sRequest;
@@ -119,9 +117,6 @@ hoxCheckUpdatesUI::runCheck()
         sRequest += "Connection: close\r\n";
         sRequest += "\r\n";
         m_pHttpSocket->write( sRequest );
-
-        m_io_service_thread = new asio::thread( boost::bind(&asio::io_service::run,
-                                                            &m_io_service) );
     }
     catch (std::exception& e)
     {
@@ -135,16 +130,14 @@ void
 hoxCheckUpdatesUI::OnCheckUpdatesResponse( wxCommandEvent& event )
 {
     const hoxResponse_APtr apResponse( wxDynamicCast(event.GetEventObject(), hoxResponse) );
+    if ( ! m_pHttpSocket )
+    {
+        return;  // Already done.
+    }
     const std::string sResponse = m_pHttpSocket->getResponse();
 
     m_pHttpSocket->close();
-
-    m_io_service_thread->join();   // ************ WAIT HERE
-    delete m_io_service_thread;
-    m_io_service_thread = NULL;
-
-    delete m_pHttpSocket;
-    m_pHttpSocket = NULL;
+    m_pHttpSocket.reset();  // ... freed after its last handler.
 
     this->Stop();
 
@@ -61,9 +61,7 @@ private:
     int                m_timerValue;  // Timer's value.
     wxTimer*           m_timer;       // To keep track of time.
 
-    asio::io_service   m_io_service;
-    hoxHttpSocket*     m_pHttpSocket;
-    asio::thread*      m_io_service_thread;
+    hoxHttpSocket_SPtr m_pHttpSocket;
 
     DECLARE_EVENT_TABLE()
 };
@@ -82,12 +82,11 @@ hoxChesscapeWriter::HandleRequest( hoxRequest_APtr apRequest,
     return hoxRC_OK;
 }
 
-hoxAsyncSocket*
-hoxChesscapeWriter::CreateSocketAgent( asio::io_service&       io_service,
-                                       tcp::resolver::iterator endpoint_iter,
-                                       wxEvtHandler*           evtHandler)
+hoxAsyncSocket_SPtr
+hoxChesscapeWriter::CreateSocketAgent( asio::io_service& io_service,
+                                       wxEvtHandler*     evtHandler )
 {
-    return new hoxChesscapeSocket( io_service, endpoint_iter, evtHandler);
+    return hoxAsyncSocket_SPtr( new hoxChesscapeSocket( io_service, evtHandler ) );
 }
 
 hoxResult
@@ -362,20 +361,23 @@ void
 hoxChesscapeSocket::handleConnect( const asio::error_code& error,
                                         tcp::resolver::iterator endpoint_iter )
 {
+    if ( isConnectAborted( error ) )
+    {
+        return;  // Closed meanwhile: do not try the next endpoint.
+    }
+
     if (!error)
     {
-        m_connectState = CONNECT_STATE_CONNECTED;
+        onConnected();
         asio::async_read_until( m_socket, m_inBuffer, END_CHAR,
-                                boost::bind(&hoxChesscapeSocket::handleIncomingData, this,
-                                            asio::placeholders::error));
+                                m_strand.wrap(
+                                    boost::bind(&hoxAsyncSocket::handleIncomingData, shared_from_this(),
+                                                asio::placeholders::error)));
     }
     else if (endpoint_iter != tcp::resolver::iterator())
     {
         m_socket.close();
-        tcp::endpoint endpoint = *endpoint_iter;
-        m_socket.async_connect( endpoint,
-                                boost::bind(&hoxChesscapeSocket::handleConnect, this,
-                                            asio::placeholders::error, ++endpoint_iter));
+        asyncConnect( endpoint_iter );
     }
     else  // Failed.
     {
@@ -413,8 +415,9 @@ hoxChesscapeSocket::handleIncomingData( const asio::error_code& error )
 
     // Read the END token (AGAIN!).
     asio::async_read_until( m_socket, m_inBuffer, END_CHAR,
-                            boost::bind(&hoxChesscapeSocket::handleIncomingData, this,
-                                        asio::placeholders::error));
+                            m_strand.wrap(
+                                boost::bind(&hoxAsyncSocket::handleIncomingData, shared_from_this(),
+                                            asio::placeholders::error)));
 }
 
 //-----------------------------------------------------------------------------
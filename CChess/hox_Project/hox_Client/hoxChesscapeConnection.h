@@ -45,9 +45,8 @@ public:
 protected:
     virtual hoxResult HandleRequest( hoxRequest_APtr apRequest,
                                      wxString&       sError );
-    virtual hoxAsyncSocket* CreateSocketAgent( asio::io_service&       io_service,
-                                               tcp::resolver::iterator endpoint_iter,
-                                               wxEvtHandler*           evtHandler);
+    virtual hoxAsyncSocket_SPtr CreateSocketAgent( asio::io_service& io_service,
+                                                   wxEvtHandler*     evtHandler );
 
 private:
     // ------
@@ -76,10 +75,9 @@ private:
 class hoxChesscapeSocket : public hoxAsyncSocket
 {
 public:
-    hoxChesscapeSocket( asio::io_service&       io_service,
-                             tcp::resolver::iterator endpoint_iter,
-                             wxEvtHandler*           evtHandler )
-                : hoxAsyncSocket( io_service, endpoint_iter, evtHandler ) {}
+    hoxChesscapeSocket( asio::io_service& io_service,
+                        wxEvtHandler*     evtHandler )
+                : hoxAsyncSocket( io_service, evtHandler ) {}
     virtual ~hoxChesscapeSocket() {}
 
 protected:
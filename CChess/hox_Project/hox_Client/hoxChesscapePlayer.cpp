@@ -84,17 +84,7 @@ hoxChesscapePlayer::QueryForNetworkTables()
         return hoxRC_OK;
     }
 
-	/* Clone the "cache" list and return the cloned */
-    hoxNetworkTableInfoList tableList;
-
-	for ( hoxNetworkTableInfoList::const_iterator it = m_networkTables.begin();
-		                                          it != m_networkTables.end(); 
-												++it )
-	{
-		tableList.push_back( (*it) );
-	}
-	
-    m_site->OnListOfTablesReceived( tableList );
+    m_site->OnListOfTablesReceived( m_tables );
     return hoxRC_OK;
 }
 
@@ -422,57 +412,13 @@ hoxChesscapePlayer::_ParsePlayerStatsString( const wxString&  sStatsStr,
 bool 
 hoxChesscapePlayer::_DoesTableExist( const wxString& tableId ) const
 {
-	hoxNetworkTableInfo* pTableInfo = NULL;
-	return _FindTableById( tableId, pTableInfo );
-}
-
-bool
-hoxChesscapePlayer::_FindTableById( const wxString&       tableId,
-		                            hoxNetworkTableInfo*& pTableInfo ) const
-{
-	for ( hoxNetworkTableInfoList::iterator it = m_networkTables.begin();
-		                                    it != m_networkTables.end(); 
-								          ++it )
-	{
-		if ( it->id == tableId )
-		{
-			pTableInfo = &(*it);
-			return true;
-		}
-	}
-
-	return false; // not found.
+	return m_tables.HasTable( tableId );
 }
 
 bool 
-hoxChesscapePlayer::_AddTableToList( const wxString& tableStr ) const
+hoxChesscapePlayer::_RemoveTableFromList( const wxString& tableId )
 {
-	hoxNetworkTableInfo tableInfo;
-
-	_ParseTableInfoString( tableStr, tableInfo );
-    wxCHECK_MSG( tableInfo.IsValid(), false, "Failed to parse table-string: " + tableStr );
-
-	/* Insert into our list. */
-	m_networkTables.push_back( tableInfo );
-
-	return true;
-}
-
-bool 
-hoxChesscapePlayer::_RemoveTableFromList( const wxString& tableId ) const
-{
-	for ( hoxNetworkTableInfoList::iterator it = m_networkTables.begin();
-		                                    it != m_networkTables.end(); 
-										  ++it )
-	{
-		if ( it->id == tableId )
-		{
-			m_networkTables.erase( it );
-			return true;
-		}
-	}
-
-	return false; // not found.
+	return m_tables.RemoveTable( tableId );
 }
 
 bool 
@@ -489,26 +435,10 @@ hoxChesscapePlayer::_UpdateTableInList( const wxString&      tableStr,
 		*pTableInfo = tableInfo;  // Return a copy if requested.
 	}
 
-	/* Find the table from our list. */
-
-	hoxNetworkTableInfoList::iterator found_it = m_networkTables.end();
-
-	for ( hoxNetworkTableInfoList::iterator it = m_networkTables.begin();
-		                                    it != m_networkTables.end(); 
-								          ++it )
-	{
-		if ( it->id == tableInfo.id )
-		{
-			found_it = it;
-			break;
-		}
-	}
-
 	/* If the table is not found, insert into our list. */
-	if ( found_it == m_networkTables.end() ) // not found?
+	if ( m_tables.SetTable( tableInfo ) ) // inserted?
 	{
-		wxLogDebug("%s: Insert a new table [%s].", __FUNCTION__, tableInfo.id.c_str());
-		m_networkTables.push_back( tableInfo );
+		wxLogDebug("%s: Inserted a new table [%s].", __FUNCTION__, tableInfo.id.c_str());
         
         hoxTable_SPtr pTable = _GetMyTable();
         if ( pTable )
@@ -530,8 +460,7 @@ hoxChesscapePlayer::_UpdateTableInList( const wxString&      tableStr,
 	}
 	else // found?
 	{
-		wxLogDebug("%s: Update existing table [%s] with new info.", __FUNCTION__, tableInfo.id.c_str());
-		*found_it = tableInfo;
+		wxLogDebug("%s: Updated existing table [%s] with new info.", __FUNCTION__, tableInfo.id.c_str());
 	}
 
 	/* Trigger our own event-handler */ 
@@ -698,9 +627,10 @@ hoxChesscapePlayer::_HandleCmd_Clients( const wxString& cmdStr )
 void 
 hoxChesscapePlayer::_HandleCmd_Show(const wxString& cmdStr)
 {
-	m_networkTables.clear(); // Clear out the existing list.
+	/* Create a new table-list, which replaces the existing one. */
 
-	/* Create a new table-list. */
+	hoxNetworkTableInfoList tableList;
+	hoxNetworkTableInfo     tableInfo;
 
 	wxString delims;
 	delims += 0x11;   // table-delimiter
@@ -709,8 +639,15 @@ hoxChesscapePlayer::_HandleCmd_Show(const wxString& cmdStr)
 	while ( tkz.HasMoreTokens() )
 	{
 		token = tkz.GetNextToken();
-		_AddTableToList( token );
+		_ParseTableInfoString( token, tableInfo );
+		if ( ! tableInfo.IsValid() )
+		{
+			wxLogDebug("%s: *WARN* Failed to parse table-string [%s].", __FUNCTION__, token.c_str());
+			continue;
+		}
+		tableList.push_back( tableInfo );
 	}
+	m_tables.ResetTables( tableList );
 
     m_bListReceived = true;
     if ( m_bRequestingList )
@@ -876,8 +813,8 @@ hoxChesscapePlayer::_HandleTableCmd_Settings( const wxString& cmdStr )
 	 */
 	if (  ! m_pendingJoinTableId.empty() )
 	{
-		hoxNetworkTableInfo* pTableInfo = NULL;
-		if ( ! _FindTableById( m_pendingJoinTableId, pTableInfo ) ) // not found?
+		const hoxNetworkTableInfo* pFoundInfo = m_tables.FindTable( m_pendingJoinTableId );
+		if ( pFoundInfo == NULL ) // not found?
 		{
 			wxLogDebug("%s: *WARN* Table [%s] not found.", 
 				__FUNCTION__, m_pendingJoinTableId.c_str());
@@ -886,27 +823,31 @@ hoxChesscapePlayer::_HandleTableCmd_Settings( const wxString& cmdStr )
 
 		m_pendingJoinTableId = "";
 
-		pTableInfo->redId = redId;
-		pTableInfo->blackId = blackId;
-		if ( pTableInfo->gameType == hoxGAME_TYPE_SOLO )
+		hoxNetworkTableInfo tableInfo = *pFoundInfo;
+
+		tableInfo.redId = redId;
+		tableInfo.blackId = blackId;
+		if ( tableInfo.gameType == hoxGAME_TYPE_SOLO )
 		{
-			if ( pTableInfo->blackId.empty() ) pTableInfo->blackId = "COMPUTER";
-			if ( pTableInfo->redId.empty() )   pTableInfo->redId = "COMPUTER";
+			if ( tableInfo.blackId.empty() ) tableInfo.blackId = "COMPUTER";
+			if ( tableInfo.redId.empty() )   tableInfo.redId = "COMPUTER";
 		}
 
-        pTableInfo->gameType = gameType;
+        tableInfo.gameType = gameType;
 
-		pTableInfo->initialTime.nGame = (int) (nInitialGameTime / 1000 );
-		pTableInfo->initialTime.nFree = (int) (nInitialFreeTime / 1000);
+		tableInfo.initialTime.nGame = (int) (nInitialGameTime / 1000 );
+		tableInfo.initialTime.nFree = (int) (nInitialFreeTime / 1000);
 
-		pTableInfo->blackTime.nGame = (int) (nBlackGameTime / 1000); // convert to seconds
-		pTableInfo->redTime.nGame   = (int) (nRedGameTime / 1000);
+		tableInfo.blackTime.nGame = (int) (nBlackGameTime / 1000); // convert to seconds
+		tableInfo.redTime.nGame   = (int) (nRedGameTime / 1000);
 
-		pTableInfo->blackTime.nFree = pTableInfo->initialTime.nFree;
-		pTableInfo->redTime.nFree   = pTableInfo->initialTime.nFree;
+		tableInfo.blackTime.nFree = tableInfo.initialTime.nFree;
+		tableInfo.redTime.nFree   = tableInfo.initialTime.nFree;
+
+		m_tables.SetTable( tableInfo );
 
 		// Inform the site.
-		m_site->JoinLocalPlayerToTable( *pTableInfo );
+		m_site->JoinLocalPlayerToTable( tableInfo );
 	}
 }
 
@@ -947,20 +888,16 @@ void
 hoxChesscapePlayer::_HandleTableCmd_PastMoves( hoxTable_SPtr   pTable,
 	                                           const wxString& cmdStr )
 {
-    hoxStringList moves;
+    hoxMoveHistory moves;
 
     /* Get the list of Past Moves. */
 
 	wxString delims;
 	delims += 0x10;   // move-delimiter
-	wxStringTokenizer tkz( cmdStr, delims, wxTOKEN_STRTOK ); // No empty tokens
-	wxString moveStr;
-	while ( tkz.HasMoreTokens() )
-	{
-		moveStr = tkz.GetNextToken();
-		wxLogDebug("%s: .... move-str=[%s].", __FUNCTION__, moveStr.c_str());
-        moves.push_back( moveStr );
-	}
+    if ( ! moves.AppendStrings( cmdStr, delims ) )
+    {
+        wxLogDebug("%s: Invalid past Moves [%s].", __FUNCTION__, cmdStr.c_str());
+    }
 
     pTable->OnPastMoves( moves );
 }
@@ -77,10 +77,7 @@ private:
 		                          hoxPlayerStats&  playerStats ) const;
 
     bool _DoesTableExist( const wxString& tableId ) const;
-	bool _FindTableById( const wxString&      tableId,
-		                 hoxNetworkTableInfo*& pTableInfo ) const;
-	bool _AddTableToList( const wxString& tableStr ) const;
-	bool _RemoveTableFromList( const wxString& tableId ) const;
+	bool _RemoveTableFromList( const wxString& tableId );
 	bool _UpdateTableInList( const wxString& tableStr,
 		                     hoxNetworkTableInfo* pTableInfo = NULL );
 
@@ -136,11 +133,10 @@ private:
     hoxTable_SPtr _GetMyTable() const; // Chesscape only supports 1 Table.
 
 private:
-	/* Chesscape server sends a list of tables upon login.
-	 * After that, it only sends updates for each tables.
-	 * Thus, this player needs to maintain a "cache" list of tables.
+	/* NOTE: Chesscape server sends a list of tables upon login.
+	 *       After that, it only sends updates for each tables.
+	 *       Thus, this player keeps them in its Table-Registry.
 	 */
-	mutable hoxNetworkTableInfoList  m_networkTables;
 
 	/* NOTE: Chesscape server sends a list of players upon login.
 	 *       After that, it only sends updates for each player
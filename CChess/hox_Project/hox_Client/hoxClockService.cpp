@@ -0,0 +1,231 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxClockService.cpp
+// Created:         10/19/2026
+//
+// Description:     The Clock Service waking up the Boards of the process
+//                  when their clocks are to be displayed again.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "hoxClockService.h"
+#include <vector>
+
+#if defined(__WXMSW__)
+    #include <wx/msw/wrapwin.h>
+#elif defined(__WXMAC__)
+    #include <mach/mach_time.h>
+#else
+    #include <time.h>
+#endif
+
+/* Define (initialize) the single instance */
+hoxClockService*
+hoxClockService::m_instance = NULL;
+
+BEGIN_EVENT_TABLE(hoxClockService, wxEvtHandler)
+    EVT_TIMER(wxID_ANY, hoxClockService::OnTimer)
+END_EVENT_TABLE()
+
+/* static */
+hoxClockService*
+hoxClockService::GetInstance()
+{
+    if ( m_instance == NULL )
+        m_instance = new hoxClockService();
+
+    return m_instance;
+}
+
+/* static */
+void
+hoxClockService::DeleteInstance()
+{
+    delete m_instance;
+    m_instance = NULL;
+}
+
+/* static */
+wxLongLong
+hoxClockService::Now()
+{
+#if defined(__WXMSW__)
+    /* GetTickCount() wraps around every 49.7 days. */
+    static DWORD      s_lastTicks = 0;
+    static wxLongLong s_wraps     = 0;
+    const DWORD ticks = ::GetTickCount();
+    if ( ticks < s_lastTicks ) s_wraps += wxLongLong( 1, 0 );
+    s_lastTicks = ticks;
+    return s_wraps + wxLongLong( 0, ticks );
+#elif defined(__WXMAC__)
+    static mach_timebase_info_data_t s_timebase = { 0, 0 };
+    if ( s_timebase.denom == 0 ) ::mach_timebase_info( &s_timebase );
+    const uint64_t nanos =
+        ::mach_absolute_time() * s_timebase.numer / s_timebase.denom;
+    return wxLongLong( (wxLongLong_t) ( nanos / 1000000 ) );
+#else
+    struct timespec ts;
+    ::clock_gettime( CLOCK_MONOTONIC, &ts );
+    return wxLongLong( (wxLongLong_t) ts.tv_sec ) * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+/* private */
+hoxClockService::hoxClockService()
+        : m_lastTick( 0 )
+        , m_timer( this )
+{
+}
+
+hoxClockService::~hoxClockService()
+{
+    m_timer.Stop();
+}
+
+void
+hoxClockService::Schedule( Client*    client,
+                           wxLongLong dueTime )
+{
+    Cancel( client );
+
+    const wxLongLong now = Now();
+    if ( m_clientSlots.empty() )
+    {
+        m_lastTick = now / SLOT_MILLIS - 1;  // The wheel may have been idle.
+    }
+
+    wxLongLong tick = dueTime / SLOT_MILLIS;
+    if ( tick <= m_lastTick ) tick = m_lastTick + 1;  // Past: the next slot.
+    const int slot = (int) ( tick % WHEEL_SLOTS ).ToLong();
+
+    Request request;
+    request.client  = client;
+    request.dueTime = dueTime;
+    m_slots[slot].push_back( request );
+    m_clientSlots[client] = slot;
+
+    _Arm( now );
+}
+
+void
+hoxClockService::Cancel( Client* client )
+{
+    ClientSlotMap::iterator found = m_clientSlots.find( client );
+    if ( found == m_clientSlots.end() ) return;
+
+    RequestList& requests = m_slots[found->second];
+    for ( RequestList::iterator it = requests.begin(); it != requests.end(); ++it )
+    {
+        if ( it->client == client )
+        {
+            requests.erase( it );
+            break;
+        }
+    }
+    m_clientSlots.erase( found );
+
+    if ( m_clientSlots.empty() ) m_timer.Stop();
+}
+
+void
+hoxClockService::OnTimer( wxTimerEvent& event )
+{
+    const wxLongLong now     = Now();
+    const wxLongLong nowTick = now / SLOT_MILLIS;
+
+    /* Take the requests due from the slots passed since the last time
+     * (at most a turn of the wheel, if the timer was very late).
+     * The current slot is handled again next time, since the requests
+     * in it may not be all due yet.
+     */
+    wxLongLong nTicks = nowTick - m_lastTick;
+    if ( nTicks > WHEEL_SLOTS ) nTicks = WHEEL_SLOTS;
+
+    std::vector<Client*> dueClients;
+    for ( long i = 1; i <= nTicks.ToLong(); ++i )
+    {
+        RequestList& requests = m_slots[(int) ( (m_lastTick + i) % WHEEL_SLOTS ).ToLong()];
+        for ( RequestList::iterator it = requests.begin(); it != requests.end(); )
+        {
+            if ( it->dueTime <= now )
+            {
+                dueClients.push_back( it->client );
+                m_clientSlots.erase( it->client );
+                it = requests.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    m_lastTick = nowTick - 1;
+
+    /* NOTE: The clients may schedule themselves again from here. */
+    for ( size_t i = 0; i < dueClients.size(); ++i )
+    {
+        dueClients[i]->OnClockDue();
+    }
+
+    _Arm( Now() );
+}
+
+void
+hoxClockService::_Arm( wxLongLong now )
+{
+    if ( m_clientSlots.empty() )
+    {
+        m_timer.Stop();
+        return;
+    }
+
+    /* Wake up when the last request of the next slot in use is due, to
+     * call back all of them at once.
+     */
+    for ( long i = 1; i <= WHEEL_SLOTS; ++i )
+    {
+        const wxLongLong tick = m_lastTick + i;
+        const RequestList& requests = m_slots[(int) ( tick % WHEEL_SLOTS ).ToLong()];
+
+        bool       bFound = false;
+        wxLongLong wakeTime;
+        for ( RequestList::const_iterator it = requests.begin(); it != requests.end(); ++it )
+        {
+            if ( it->dueTime / SLOT_MILLIS > tick ) continue;  // A later turn.
+            if ( !bFound || it->dueTime > wakeTime ) wakeTime = it->dueTime;
+            bFound = true;
+        }
+
+        if ( bFound )
+        {
+            const long delay = ( wakeTime > now ? (wakeTime - now).ToLong() : 0 );
+            m_timer.Start( wxMax(delay, 1), wxTIMER_ONE_SHOT );
+            return;
+        }
+    }
+
+    /* All requests are a turn of the wheel or more ahead. */
+    const wxLongLong turnTime = ( m_lastTick + WHEEL_SLOTS ) * SLOT_MILLIS;
+    const long delay = ( turnTime > now ? (turnTime - now).ToLong() : 0 );
+    m_timer.Start( wxMax(delay, 1), wxTIMER_ONE_SHOT );
+}
+
+/************************* END OF FILE ***************************************/
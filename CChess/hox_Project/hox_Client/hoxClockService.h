@@ -0,0 +1,120 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxClockService.h
+// Created:         10/19/2026
+//
+// Description:     The Clock Service waking up the Boards of the process
+//                  when their clocks are to be displayed again.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_HOX_CLOCK_SERVICE_H__
+#define __INCLUDED_HOX_CLOCK_SERVICE_H__
+
+#include <wx/wx.h>
+#include <list>
+#include <map>
+
+/**
+ * A single timer for all the clocks of the process, instead of a timer
+ * per Board.  A client asks to be called back at a given time of Now();
+ * the requests are kept in a wheel of slots (a slot per SLOT_MILLIS), and
+ * the timer is armed once for the next slot in use.  The clients due in
+ * the same slot are called back together.
+ *
+ * The time is read from a monotonic clock, so a client computing its
+ * clock from Now() does not drift, even if a callback is late (the event
+ * loop being busy) or the system time is changed.
+ *
+ * This is implemented as a singleton, used by the GUI thread only.
+ */
+class hoxClockService : public wxEvtHandler
+{
+public:
+    /**
+     * The interface of a client of the service.
+     */
+    class Client
+    {
+    public:
+        virtual ~Client() {}
+        virtual void OnClockDue() = 0;
+            /* The time given to Schedule() has come.  The client is no
+             * longer scheduled, but may call Schedule() again. */
+    };
+
+public:
+    static hoxClockService* GetInstance();
+    static void             DeleteInstance();
+
+    static wxLongLong Now();
+        /* The milliseconds of a monotonic clock (from an unspecified start). */
+
+    void Schedule( Client* client, wxLongLong dueTime );
+        /* Calls back the client at 'dueTime' (of Now()), or as soon as
+         * possible if it is past.  It replaces the previous request of
+         * the client, if any. */
+
+    void Cancel( Client* client );
+        /* Forgets the request of the client, if any.  A client must call
+         * it before being deleted. */
+
+    void OnTimer( wxTimerEvent& event );
+
+private:
+    hoxClockService();
+    virtual ~hoxClockService();
+
+    void _Arm( wxLongLong now );
+        /* Arms the timer for the next slot in use, if any. */
+
+    static hoxClockService* m_instance;
+
+private:
+    enum
+    {
+        WHEEL_SLOTS = 32,  // The wheel covers WHEEL_SLOTS * SLOT_MILLIS.
+        SLOT_MILLIS = 50
+    };
+
+    struct Request
+    {
+        Client*     client;
+        wxLongLong  dueTime;
+    };
+    typedef std::list<Request>    RequestList;
+    typedef std::map<Client*, int> ClientSlotMap;
+
+    RequestList     m_slots[WHEEL_SLOTS];
+                /* The requests by the slot of their time.  Those more than
+                 * a turn of the wheel ahead wait in their slot for it. */
+
+    ClientSlotMap   m_clientSlots;  // The slot of each client scheduled.
+
+    wxLongLong      m_lastTick;
+                /* The last slot time (Now() / SLOT_MILLIS) handled. */
+
+    wxTimer         m_timer;   // One-shot, for the next slot in use.
+
+    DECLARE_EVENT_TABLE()
+};
+
+#endif /* __INCLUDED_HOX_CLOCK_SERVICE_H__ */
@@ -27,6 +27,7 @@
 
 #include "hoxCoreBoard.h"
 #include "hoxUtil.h"
+#include <algorithm>
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -82,6 +83,7 @@ hoxCoreBoard::hoxCoreBoard( wxWindow*        parent,
         , m_sImage( sBgImage )
         , m_background( NULL )
         , m_piecesPath( piecesPath )
+        , m_nPieceSize( 0 )
         , m_bViewInverted( false )  // Normal view: RED is at bottom of the screen
         , m_referee( referee )
         , m_owner( NULL )
@@ -90,6 +92,8 @@ hoxCoreBoard::hoxCoreBoard( wxWindow*        parent,
         , m_dragPiece( NULL )
         , m_dragImage( NULL )
         , m_latestPiece( NULL )
+        , m_bBgDirty( true )
+        , m_bPiecesDirty( true )
         , m_historyIndex( HISTORY_INDEX_END )
         , m_isGameOver( false )
 {
@@ -101,6 +105,10 @@ hoxCoreBoard::hoxCoreBoard( wxWindow*        parent,
     else  m_background = new hoxImageBackground( m_sImage );
     m_background->OnBgColor( bgColor );
     m_background->OnFgColor( fgColor );
+    m_nPieceSize = m_background->CellS();
+
+    /* Everything is painted from the back buffer. */
+    SetBackgroundStyle( wxBG_STYLE_CUSTOM );
 }
 
 hoxCoreBoard::~hoxCoreBoard()
@@ -119,18 +127,22 @@ hoxCoreBoard::SetBackgroundImage( const wxString& sImage )
     delete m_background;
     if ( m_sImage.empty() ) m_background = new hoxCustomBackground();
     else  m_background = new hoxImageBackground( m_sImage );
+    _ReloadAllPieceBitmaps();  // ... for the new cell size.
+    _RefreshAll( true );
 }
 
 void
 hoxCoreBoard::SetBgColor( wxColor color )
 {
     m_background->OnBgColor( color );
+    _RefreshAll( true );
 }
 
 void
 hoxCoreBoard::SetFgColor( wxColor color )
 {
     m_background->OnFgColor( color );
+    _RefreshAll( true );
 }
 
 void
@@ -142,9 +154,18 @@ hoxCoreBoard::SetMoveMode( const hoxMoveMode moveMode )
 void
 hoxCoreBoard::Repaint()
 {
-    wxClientDC dc(this);
-    m_background->OnPaint( dc );
-    _DrawAllPieces( dc );
+    _RefreshAll( true );
+}
+
+void
+hoxCoreBoard::DrawOn( wxDC& dc )
+{
+    _UpdateBuffers();
+    if ( ! m_backBuffer.Ok() ) return;
+
+    wxMemoryDC memDC( m_backBuffer );
+    dc.Blit( 0, 0, m_backBuffer.GetWidth(), m_backBuffer.GetHeight(),
+             &memDC, 0, 0 );
 }
 
 void 
@@ -153,34 +174,101 @@ hoxCoreBoard::OnPaint( wxPaintEvent& event )
     wxPaintDC dc(this);
     PrepareDC(dc);   // ... for drawing a scrolled image
 
-    _DoPaint(dc);
+    _UpdateBuffers();
+    if ( ! m_backBuffer.Ok() ) return;
+
+    /* Copy the damaged areas from the back buffer. */
+    wxMemoryDC memDC( m_backBuffer );
+    for ( wxRegionIterator it( GetUpdateRegion() ); it; ++it )
+    {
+        const wxRect rect = it.GetRect();
+        dc.Blit( rect.x, rect.y, rect.width, rect.height,
+                 &memDC, rect.x, rect.y );
+    }
 }
 
-void 
-hoxCoreBoard::_ErasePiece( hoxPiece* piece )
+void
+hoxCoreBoard::_UpdateBuffers()
 {
-    wxClientDC dc(this);
-    PrepareDC(dc);   // ... for drawing a scrolled image
+    const wxSize size = GetClientSize();
+    if ( size.x <= 0 || size.y <= 0 ) return;
 
-    /* Erase the piece by repainting the piece's area with
-     * the Board's background.
-     */
-    
-    const wxRect rect( _GetPieceRect(piece) );
+    if ( ! m_bgBuffer.Ok() || m_bgBuffer.GetSize() != size )
+    {
+        m_bgBuffer.Create( size.x, size.y );
+        m_backBuffer.Create( size.x, size.y );
+        m_bBgDirty = true;
+    }
 
-#ifdef __WXMAC__
-    // Extra code added to remove the 'highlight'.
-    dc.SetBrush( *wxTRANSPARENT_BRUSH );
-    dc.DrawRectangle( rect );
-#endif
+    if ( m_bBgDirty )
+    {
+        wxMemoryDC bgDC( m_bgBuffer );
+        bgDC.SetBackground( *hoxBOARD_WORKSPACE_BRUSH );
+        bgDC.Clear();  // ... in case the background is smaller.
+        m_background->OnPaint( bgDC );
+        m_bBgDirty     = false;
+        m_bPiecesDirty = true;
+    }
+
+    if ( m_bPiecesDirty )
+    {
+        wxMemoryDC memDC( m_backBuffer );
+        _ComposeRect( memDC, wxRect( size ) );
+        m_bPiecesDirty = false;
+    }
+}
+
+void
+hoxCoreBoard::_ComposeRect( wxDC&         dc,
+                            const wxRect& rect )
+{
+    wxMemoryDC bgDC( m_bgBuffer );
+    dc.Blit( rect.x, rect.y, rect.width, rect.height, &bgDC, rect.x, rect.y );
 
     dc.SetClippingRegion( rect );
+    for ( hoxPieceList::const_iterator it = m_pieces.begin();
+                                       it != m_pieces.end(); ++it )
     {
-        m_background->OnPaint(dc);
+        const hoxPiece* piece = *it;
+        if (   piece->IsActive() && piece->IsShown()
+            && _GetPieceRect( piece ).Intersects( rect ) )
+        {
+            _DrawPieceWithDC( dc, piece );
+        }
     }
+    if ( m_dragStartRect.Intersects( rect ) )
+        _DrawHighlight( dc, m_dragStartRect );
+    if ( m_dragHighlightRect.Intersects( rect ) )
+        _DrawHighlight( dc, m_dragHighlightRect );
     dc.DestroyClippingRegion();
 }
 
+void
+hoxCoreBoard::_RefreshRect( const wxRect& rect )
+{
+    if ( m_bBgDirty || m_bPiecesDirty || ! m_backBuffer.Ok() )
+        return;  // The whole Board is to be composed (and painted) anyway.
+
+    wxMemoryDC memDC( m_backBuffer );
+    _ComposeRect( memDC, rect );
+
+    if ( IsShownOnScreen() )
+    {
+        wxClientDC dc(this);
+        PrepareDC(dc);   // ... for drawing a scrolled image
+        dc.Blit( rect.x, rect.y, rect.width, rect.height,
+                 &memDC, rect.x, rect.y );
+    }
+}
+
+void
+hoxCoreBoard::_RefreshAll( bool bBackground /* = false */ )
+{
+    if ( bBackground ) m_bBgDirty = true;
+    m_bPiecesDirty = true;
+    this->Refresh( false /* eraseBackground */ );
+}
+
 void 
 hoxCoreBoard::_ClearPieces()
 {
@@ -191,17 +279,20 @@ hoxCoreBoard::_ClearPieces()
         m_pieces.pop_front();
         delete piece;
     }
+    m_keyPieces.clear();
 }
 
 void
 hoxCoreBoard::_ReloadAllPieceBitmaps()
 {
     // Reload the bitmaps of all Pieces, including inactive + hidden pieces.
+    m_nPieceSize = m_background->CellS();
     for (hoxPieceList::const_iterator it = m_pieces.begin();
                                       it != m_pieces.end(); ++it)
     {
-        (*it)->LoadBitmap( m_piecesPath );
+        (*it)->LoadBitmap( m_piecesPath, m_nPieceSize );
     }
+    _RefreshAll();
 }
 
 hoxPiece* 
@@ -221,28 +312,10 @@ hoxCoreBoard::_FindPiece( const wxPoint& point ) const
     return NULL;
 }
 
-void 
-hoxCoreBoard::_DoPaint( wxDC& dc )
-{
-#ifdef __WXGTK__
-    m_background->OnPaint( dc );
-#endif
-    _DrawAllPieces(dc);
-}
-
 void 
 hoxCoreBoard::OnEraseBackground( wxEraseEvent& event )
 {
-    // *** Paint the entire working space with a background's color.
-    if ( event.GetDC() )
-    {
-        m_background->OnPaint( *event.GetDC() );
-    }
-    else
-    {
-        wxClientDC dc(this);
-        m_background->OnPaint( dc );
-    }
+    // Do nothing: the whole Board is painted from the back buffer.
 }
 
 void 
@@ -256,11 +329,11 @@ hoxCoreBoard::OnSize( wxSizeEvent& event )
 {
     //wxLogDebug("%s: (%d, %d)", __FUNCTION__, event.GetSize().x, event.GetSize().y);
     m_background->OnResize( event.GetSize() );
-    wxClientDC dc(this);
-    m_background->OnPaint( dc );
-#ifdef __WXGTK__
-    _DrawAllPieces(dc);
-#endif
+    if ( m_background->CellS() != m_nPieceSize )
+    {
+        _ReloadAllPieceBitmaps();
+    }
+    _RefreshAll( true );
 }
 
 void
@@ -274,6 +347,7 @@ void
 hoxCoreBoard::LoadPiecesAndStatus()
 {
     _ClearPieces();  // Clear old pieces.
+    m_keyframes.clear();
 
     hoxGameState gameState;
     m_referee->GetGameState( gameState );
@@ -281,8 +355,16 @@ hoxCoreBoard::LoadPiecesAndStatus()
     for ( hoxPieceInfoList::const_iterator it = gameState.pieceList.begin();
                                            it != gameState.pieceList.end(); ++it )
     {
-        hoxPiece* piece = new hoxPiece(*it, m_piecesPath);
+        hoxPiece* piece = new hoxPiece(*it, m_piecesPath, m_nPieceSize);
         m_pieces.push_back( piece );
+        m_keyPieces.push_back( piece );
+    }
+
+    /* The keyframes start with the initial position.  Otherwise, there
+     * are none and the History is only reviewed Move by Move. */
+    if ( m_historyMoves.empty() )
+    {
+        _TakeKeyframe();
     }
 
     /* Display the game-status. */
@@ -290,6 +372,8 @@ hoxCoreBoard::LoadPiecesAndStatus()
     {
         SetGameOver( true );
     }
+
+    _RefreshAll();
 }
 
 void 
@@ -307,24 +391,7 @@ hoxCoreBoard::ResetBoard()
 
     /* Reload the Pieces according to the Referee. */
     this->LoadPiecesAndStatus();
-
-     wxClientDC dc(this);
-     m_background->OnPaint( dc );
-    _DrawAllPieces( dc );
-}
-
-void 
-hoxCoreBoard::_DrawAllPieces( wxDC& dc )
-{
-    for (hoxPieceList::const_iterator it = m_pieces.begin(); 
-                                      it != m_pieces.end(); ++it)
-    {
-        const hoxPiece* piece = *it;
-        if ( piece->IsActive() && piece->IsShown()) 
-        {
-            _DrawPieceWithDC( dc, piece );
-        }
-    }
+    _RefreshAll( true );
 }
 
 void
@@ -336,31 +403,13 @@ hoxCoreBoard::_DrawAndHighlightPiece( hoxPiece*  piece,
     {
         m_latestPiece->SetLatest(false);
 
-        /* Re-draw the "old" piece to undo the highlight.
-         * TODO: Is there a better way?
-         */
-        if ( bRefresh )
-        {
-            _ErasePiece( m_latestPiece );
-            _DrawPiece( m_latestPiece );
-        }
+        /* Re-draw the "old" piece to undo the highlight. */
+        if ( bRefresh ) _RefreshPiece( m_latestPiece );
     }
 
     piece->SetLatest( true );
     m_latestPiece = piece;
-    if ( bRefresh ) _DrawPiece( piece );
-}
-
-/**
- * Draw a given piece using THIS window's Device-Context.
- */
-void 
-hoxCoreBoard::_DrawPiece( const hoxPiece* piece )
-{
-    wxClientDC dc(this);
-    PrepareDC(dc);   // ... for drawing a scrolled image
-
-    _DrawPieceWithDC( dc, piece );
+    if ( bRefresh ) _RefreshPiece( piece );
 }
 
 void 
@@ -486,7 +535,7 @@ hoxCoreBoard::_MovePieceToPoint( hoxPiece*      piece,
     if ( ! m_referee->ValidateMove( move, gameStatus ) )
     {
         _PrintDebug( _("Move is not valid.") );
-        this->Refresh();
+        _RefreshAll();
         return;
     }
 
@@ -505,6 +554,7 @@ hoxCoreBoard::_MovePieceToPoint( hoxPiece*      piece,
 
     /* Keep track the list of all Moves. */
     _RecordMove( move );
+    _TakeKeyframe();
 
     /* Inform the Board's Owner of the new Move. */
     if ( m_owner != NULL )
@@ -571,6 +621,7 @@ hoxCoreBoard::DoMove( hoxMove&   move,
         _PrintDebug( wxString::Format("%s: Piece could not be moved.", __FUNCTION__) );
         return false;
     }
+    _TakeKeyframe();
 
     return true;
 }
@@ -590,13 +641,14 @@ hoxCoreBoard::_MovePieceTo( hoxPiece*          piece,
 
     _FindAndCapturePieceAt( newPosition, bRefresh );
 
-    if ( bRefresh && piece->IsShown() )
-        _ErasePiece( piece );
-
+    const wxRect oldRect = _GetPieceRect( piece );
     piece->SetPosition( newPosition ); // ... without validation.
 
+    if ( bRefresh && piece->IsShown() )
+        _RefreshRect( oldRect );  // Erase the piece.
+
     if ( hightlight )   _DrawAndHighlightPiece( piece, bRefresh );
-    else if( bRefresh ) _DrawPiece( piece );
+    else if( bRefresh ) _RefreshPiece( piece );
 
     return true;
 }
@@ -604,9 +656,7 @@ hoxCoreBoard::_MovePieceTo( hoxPiece*          piece,
 bool
 hoxCoreBoard::DoGameReview_BEGIN()
 {
-    while ( this->DoGameReview_PREV(false /* bRefresh */) ) { }
-    this->Refresh();
-    return true;
+    return this->DoGameReview_GOTO( 0 );
 }
 
 bool 
@@ -631,15 +681,16 @@ hoxCoreBoard::DoGameReview_PREV( const bool bRefresh /* = true */ )
 
     wxCHECK_MSG( m_historyIndex >= 0 && m_historyIndex < (int)m_historyMoves.size(), 
                  false, "Invalid index." );
-    const hoxMove move = m_historyMoves[m_historyIndex];
+    const hoxPosition fromPosition = m_historyMoves.GetFrom( m_historyIndex );
+    const hoxPosition toPosition   = m_historyMoves.GetTo( m_historyIndex );
 
     /* Move the piece back from NEW -> ORIGINAL position. */
 
-    hoxPiece* piece = _FindPieceAt( move.newPosition );
+    hoxPiece* piece = _FindPieceAt( toPosition );
     wxCHECK_MSG(piece, false, "No piece found at NEW position.");
 
     piece->SetLatest( false );
-    if ( ! _MovePieceTo( piece, move.piece.position, false /* no highlight */, bRefresh ) )
+    if ( ! _MovePieceTo( piece, fromPosition, false /* no highlight */, bRefresh ) )
     {
         wxLogDebug("%s: Failed to move Piece back to the ORIGINAL position.", __FUNCTION__);
         return false;
@@ -647,14 +698,14 @@ hoxCoreBoard::DoGameReview_PREV( const bool bRefresh /* = true */ )
 
     /* Putback the captured piece, if any. */
 
-    if ( move.IsAPieceCaptured() )
+    if ( m_historyMoves.IsCapture( m_historyIndex ) )
     {
-        hoxPiece* capturedPiece = _FindPieceAt( move.capturedPiece.position,
+        hoxPiece* capturedPiece = _FindPieceAt( toPosition,
                                                 true /* including Inactive pieces */ );
         wxCHECK_MSG(capturedPiece != NULL, false, "Unable to get the captured Piece.");
         wxCHECK_MSG(!capturedPiece->IsActive(), false, "Piece is already Active.");
         capturedPiece->SetActive( true );
-        if ( bRefresh ) _DrawPiece( capturedPiece );
+        if ( bRefresh ) _RefreshPiece( capturedPiece );
     }
 
     /* Highlight the Piece (if any) of the "next-PREV" Move. */
@@ -662,8 +713,7 @@ hoxCoreBoard::DoGameReview_PREV( const bool bRefresh /* = true */ )
     --m_historyIndex;
     if ( m_historyIndex >= 0 )
     {
-        const hoxMove prevMove = m_historyMoves[m_historyIndex];
-        hoxPiece* prevPiece = _FindPieceAt( prevMove.newPosition );
+        hoxPiece* prevPiece = _FindPieceAt( m_historyMoves.GetTo( m_historyIndex ) );
         wxCHECK_MSG(prevPiece, false, "No next-PREV Piece found.");
         _DrawAndHighlightPiece( prevPiece, bRefresh );
     }
@@ -690,7 +740,8 @@ hoxCoreBoard::DoGameReview_NEXT( const bool bRefresh /* = true */ )
 
     wxCHECK_MSG( m_historyIndex >= 0 && m_historyIndex < (int)m_historyMoves.size(), 
                  false, "Invalid index." );
-    const hoxMove move = m_historyMoves[m_historyIndex];
+    const hoxPosition fromPosition = m_historyMoves.GetFrom( m_historyIndex );
+    const hoxPosition toPosition   = m_historyMoves.GetTo( m_historyIndex );
 
     if ( m_historyIndex == (int)m_historyMoves.size() - 1 )
     {
@@ -699,10 +750,11 @@ hoxCoreBoard::DoGameReview_NEXT( const bool bRefresh /* = true */ )
 
     /* Move the piece from ORIGINAL --> NEW position. */
 
-    hoxPiece* piece = _FindPieceAt( move.piece.position );
+    hoxPiece* piece = _FindPieceAt( fromPosition );
     wxCHECK_MSG(piece, false, "No Piece found at the ORIGINAL position.");
 
-    _MovePieceTo( piece, move.newPosition, true /* hightlight */, bRefresh );
+    _MovePieceTo( piece, toPosition, true /* hightlight */, bRefresh );
+    _TakeKeyframe();
 
 	return true;
 }
@@ -710,8 +762,52 @@ hoxCoreBoard::DoGameReview_NEXT( const bool bRefresh /* = true */ )
 bool 
 hoxCoreBoard::DoGameReview_END()
 {
-    while ( this->DoGameReview_NEXT(false /* bRefresh */) ) { }
-    this->Refresh();
+    return this->DoGameReview_GOTO( (int) m_historyMoves.size() );
+}
+
+bool
+hoxCoreBoard::DoGameReview_GOTO( const int nPly )
+{
+    wxCHECK_MSG( nPly >= 0 && nPly <= (int)m_historyMoves.size(),
+                 false, "Invalid ply." );
+
+    int nCurrent = _GetReviewPly();
+
+    /* Start from the nearest keyframe before the target, unless the
+     * current position is closer. */
+    if ( ! m_keyframes.empty() )
+    {
+        const int nKeyframe = wxMin( nPly / KEYFRAME_PLIES,
+                                     (int) m_keyframes.size() - 1 );
+        const int nKeyPly = nKeyframe * KEYFRAME_PLIES;
+        if ( nPly - nKeyPly < abs( nPly - nCurrent ) )
+        {
+            _RestoreKeyframe( nKeyframe );
+            m_historyIndex = ( nKeyPly == (int)m_historyMoves.size()
+                              ? (int) HISTORY_INDEX_END
+                              : nKeyPly - 1 );
+            nCurrent = nKeyPly;
+
+            /* Highlight the Piece of the keyframe's last Move, if any. */
+            if ( nKeyPly > 0 )
+            {
+                hoxPiece* piece =
+                    _FindPieceAt( m_historyMoves.GetTo( nKeyPly - 1 ) );
+                if ( piece ) _DrawAndHighlightPiece( piece, false /* bRefresh */ );
+            }
+        }
+    }
+
+    for ( ; nCurrent > nPly; --nCurrent )
+    {
+        if ( ! this->DoGameReview_PREV( false /* bRefresh */ ) ) break;
+    }
+    for ( ; nCurrent < nPly; ++nCurrent )
+    {
+        if ( ! this->DoGameReview_NEXT( false /* bRefresh */ ) ) break;
+    }
+
+    _RefreshAll();
     return true;
 }
 
@@ -728,8 +824,6 @@ hoxCoreBoard::OnMouseEvent( wxMouseEvent& event )
 void 
 hoxCoreBoard::_OnMouseEvent_ClickNClick( wxMouseEvent& event )
 {
-    wxClientDC dc(this);
-
     if ( event.LeftDown() )
     {
         hoxPiece* piece = _FindPiece(event.GetPosition());
@@ -744,16 +838,16 @@ hoxCoreBoard::_OnMouseEvent_ClickNClick( wxMouseEvent& event )
             if ( piece && piece->GetColor() == m_dragPiece->GetColor() )
             {
                 // In this caes, stay in the same "START" mode!
-                _EraseHighlight(dc, m_dragStartRect, m_dragPiece->GetPosition());
             }
             else
             {
                 m_dragMode = DRAG_MODE_NONE;
+                _SetHighlight( m_dragStartRect, wxRect() );
+                _SetHighlight( m_dragHighlightRect, wxRect() );
                 const wxPoint newPoint = _GetPieceLocation(m_dragPiece) 
                                        + event.GetPosition() - m_dragStartPos;
                 _MovePieceToPoint( m_dragPiece, newPoint );
                 m_dragPiece = NULL;
-                m_dragHighlightRect = wxRect();
                 return;  // *** Done!
             }
         }
@@ -766,8 +860,7 @@ hoxCoreBoard::_OnMouseEvent_ClickNClick( wxMouseEvent& event )
         const hoxPosition newPos = _PointToPosition(m_dragPiece, newPoint);
         const wxSize pieceSize = m_dragPiece->GetBitmap().GetSize();
         const wxPoint newOrigin = _PositionToPieceOrigin(newPos, pieceSize);
-        m_dragStartRect = wxRect( newOrigin, pieceSize );
-        _DrawHighlight(dc, m_dragStartRect );
+        _SetHighlight( m_dragStartRect, wxRect( newOrigin, pieceSize ) );
     }
     else if ( event.Moving() && m_dragMode == DRAG_MODE_START )
     {
@@ -779,17 +872,7 @@ hoxCoreBoard::_OnMouseEvent_ClickNClick( wxMouseEvent& event )
         const wxRect rect( newOrigin, pieceSize );
         if ( rect != m_dragHighlightRect )
         {
-            if ( m_dragHighlightPos != m_dragPiece->GetPosition() )
-            {
-                _EraseHighlight(dc, m_dragHighlightRect, m_dragHighlightPos);
-            }
-            _DrawHighlight(dc, rect );
-            m_dragHighlightRect = rect;
-            m_dragHighlightPos = (m_bViewInverted ? hoxPosition(8 - newPos.x, 9 - newPos.y)
-                                                  : newPos);
-#ifdef __WXGTK__
-            _DrawAllPieces(dc);
-#endif
+            _SetHighlight( m_dragHighlightRect, rect );
         }
     }
 }
@@ -825,7 +908,7 @@ hoxCoreBoard::_OnMouseEvent_DragNDrop( wxMouseEvent& event )
 
         // Erase the dragged shape from the board
         m_dragPiece->SetShow(false);
-        _ErasePiece(m_dragPiece);
+        _RefreshPiece(m_dragPiece);
 
         m_dragImage = new wxDragImage( m_dragPiece->GetBitmap(), 
                                        wxCursor(wxCURSOR_HAND) );
@@ -862,15 +945,7 @@ hoxCoreBoard::_OnMouseEvent_DragNDrop( wxMouseEvent& event )
         const wxRect rect( newOrigin, bitmap.GetSize() );
         if ( rect != m_dragHighlightRect )
         {
-            wxClientDC dc(this);
-            _EraseHighlight(dc, m_dragHighlightRect, m_dragHighlightPos);
-            _DrawHighlight(dc, rect );
-            m_dragHighlightRect = rect;
-            m_dragHighlightPos = (m_bViewInverted ? hoxPosition(8 - newPos.x, 9 - newPos.y)
-                                                  : newPos);
-#ifdef __WXGTK__
-            _DrawAllPieces(dc);
-#endif
+            _SetHighlight( m_dragHighlightRect, rect );
         }
         m_dragImage->Move(event.GetPosition());
 #ifndef __WXMAC__
@@ -895,10 +970,10 @@ hoxCoreBoard::_OnMouseEvent_DragNDrop( wxMouseEvent& event )
         // Move the dragged piece to its new location.
         const wxPoint newPoint = _GetPieceLocation(m_dragPiece) 
                                + event.GetPosition() - m_dragStartPos;
+        _SetHighlight( m_dragHighlightRect, wxRect() );
         m_dragPiece->SetShow(true);
         _MovePieceToPoint( m_dragPiece, newPoint );
         m_dragPiece = NULL;
-        m_dragHighlightRect = wxRect();
     }
 }
 
@@ -914,26 +989,14 @@ hoxCoreBoard::_DrawHighlight( wxDC& dc,
 }
 
 void
-hoxCoreBoard::_EraseHighlight( wxDC& dc,
-                               const wxRect rect,
-                               const hoxPosition position )
+hoxCoreBoard::_SetHighlight( wxRect&       highlight,
+                             const wxRect& rect )
 {
-#ifdef __WXMAC__
-    // Extra code added to remove the 'highlight'.
-    dc.SetBrush( *wxTRANSPARENT_BRUSH );
-    dc.DrawRectangle( rect );
-#endif
-    dc.SetClippingRegion( rect );
-    m_background->OnPaint(dc);
-    dc.DestroyClippingRegion();
+    const wxRect oldRect = highlight;
+    highlight = rect;
 
-    hoxPiece* existPiece = _FindPieceAt( position );
-    if (   existPiece
-        && (    m_moveMode == hoxMOVE_MODE_CLICK_N_CLICK
-             || existPiece != m_dragPiece) )
-    {
-        _DrawPieceWithDC(dc, existPiece);
-    }
+    if ( ! oldRect.IsEmpty() ) _RefreshRect( oldRect );
+    if ( ! rect.IsEmpty() )    _RefreshRect( rect );
 }
 
 void 
@@ -997,7 +1060,7 @@ hoxCoreBoard::_FindAndCapturePieceAt( const hoxPosition& position,
         return NULL;
 
     capturedPiece->SetActive(false);
-    if ( bRefresh ) _ErasePiece( capturedPiece );
+    if ( bRefresh ) _RefreshPiece( capturedPiece );
 
     /* NOTE: To support GAME-REVIEW feature, use the following trick:
      *     + Make sure the "recent" captured Piece is near the top of
@@ -1014,12 +1077,8 @@ hoxCoreBoard::ReverseView()
 {
     m_bViewInverted = !m_bViewInverted;
 
-    wxClientDC dc(this);
     m_background->OnReverseView();
-    m_background->OnPaint( dc );
-
-    _DrawAllPieces( dc );
-    this->Refresh();  // Somehow this is needed to show the pieces.
+    _RefreshAll( true );
 
     return m_bViewInverted;
 }
@@ -1044,7 +1103,77 @@ hoxCoreBoard::DoGetBestSize() const
 void 
 hoxCoreBoard::_RecordMove( const hoxMove& move )
 {
-    m_historyMoves.push_back( move );
+    m_historyMoves.Append( move );
+}
+
+int
+hoxCoreBoard::_GetReviewPly() const
+{
+    return ( m_historyIndex == HISTORY_INDEX_END
+            ? (int) m_historyMoves.size()
+            : m_historyIndex + 1 );
+}
+
+void
+hoxCoreBoard::_TakeKeyframe()
+{
+    const int nPly = _GetReviewPly();
+    if (    nPly % KEYFRAME_PLIES != 0
+         || nPly / KEYFRAME_PLIES != (int) m_keyframes.size() )
+    {
+        return;  // Not a keyframe, or already taken.
+    }
+
+    m_keyframes.push_back( hoxKeyframe() );
+    hoxKeyframe& keyframe = m_keyframes.back();
+    keyframe.squares.reserve( m_keyPieces.size() );
+
+    for ( std::vector<hoxPiece*>::const_iterator it = m_keyPieces.begin(); 
+                                                 it != m_keyPieces.end(); ++it )
+    {
+        const hoxPosition& pos = (*it)->GetPosition();
+        unsigned char square = (unsigned char) ( pos.y * 9 + pos.x );
+        if ( (*it)->IsActive() ) square |= KEY_PIECE_ACTIVE;
+        keyframe.squares.push_back( square );
+    }
+
+    /* Only the order of the captured Pieces matters. */
+    for ( hoxPieceList::const_iterator it = m_pieces.begin(); 
+                                       it != m_pieces.end(); ++it )
+    {
+        if ( (*it)->IsActive() ) continue;
+        const size_t index = std::find( m_keyPieces.begin(), m_keyPieces.end(), *it )
+                           - m_keyPieces.begin();
+        keyframe.captured.push_back( (unsigned char) index );
+    }
+}
+
+void
+hoxCoreBoard::_RestoreKeyframe( const int nKeyframe )
+{
+    const hoxKeyframe& keyframe = m_keyframes[nKeyframe];
+
+    if ( m_latestPiece != NULL )
+    {
+        m_latestPiece->SetLatest( false );
+        m_latestPiece = NULL;
+    }
+
+    m_pieces.clear();
+    for ( size_t i = 0; i < keyframe.captured.size(); ++i )
+    {
+        m_pieces.push_back( m_keyPieces[ keyframe.captured[i] ] );
+    }
+
+    for ( size_t i = 0; i < m_keyPieces.size(); ++i )
+    {
+        hoxPiece* piece = m_keyPieces[i];
+        const int square = ( keyframe.squares[i] & ~KEY_PIECE_ACTIVE );
+        const bool bActive = ( keyframe.squares[i] & KEY_PIECE_ACTIVE ) != 0;
+        piece->SetPosition( hoxPosition( square % 9, square / 9 ) );
+        piece->SetActive( bActive );
+        if ( bActive ) m_pieces.push_back( piece );
+    }
 }
 
 void      
@@ -1052,7 +1181,7 @@ hoxCoreBoard::SetGameOver( bool isGameOver /* = true */ )
 {
     m_isGameOver = isGameOver;
     m_background->SetGameOver( isGameOver );
-    this->Refresh();
+    _RefreshAll( true );
 }
 
 /**
@@ -31,6 +31,7 @@
 #include <wx/wx.h>
 #include <wx/dragimag.h>
 #include <list>
+#include <vector>
 #include "hoxPiece.h"
 #include "hoxIReferee.h"
 
@@ -131,6 +132,13 @@ private:
 
 /**
  * The 'core' Board providing UI for the Board and Pieces.
+ *
+ * The Board is drawn in a back buffer: the background (at the current
+ * size) is kept in a bitmap of its own, and the Pieces are composed on a
+ * copy of it.  A change to some Pieces (a Move, a drag, a review step)
+ * only composes and copies to the screen the rectangles of these Pieces.
+ * The whole back buffer is only composed again when the background
+ * (size, colors, image, view, game-over) or all Pieces change.
  */
 class hoxCoreBoard : public wxPanel
 {
@@ -171,6 +179,12 @@ public:
     void SetMoveMode( const hoxMoveMode moveMode );
     void Repaint(); // Paint again using the current settings.
 
+    /**
+     * Draw the whole Board (Pieces included) on a given DC.
+     * It does not need the Board to be shown.
+     */
+    void DrawOn( wxDC& dc );
+
     /**
      * Load pieces according the Referee and set the
      * game-status accordingly (e.g. showing 'game-over' message).
@@ -205,6 +219,13 @@ public:
     bool DoGameReview_NEXT( const bool bRefresh = true );
     bool DoGameReview_END();
 
+    /**
+     * Show the position after a given number of Moves (0 for the initial
+     * one), from the nearest keyframe or the current position, whichever
+     * is closer.  The Board is painted once, at the end.
+     */
+    bool DoGameReview_GOTO( const int nPly );
+
     /*********************************
      * My event-handlers.
      *********************************/
@@ -264,15 +285,37 @@ private:
 
     bool _IsBoardInReviewMode() const;
 
-    void   _DrawAllPieces( wxDC& dc );
     void   _DrawAndHighlightPiece( hoxPiece*  piece,
                                    const bool bRefresh = true );
-    void   _DrawPiece( const hoxPiece* piece );
     void   _DrawPieceWithDC( wxDC& dc, const hoxPiece* piece );
     wxRect _GetPieceRect( const hoxPiece* piece ) const;
 
-    void      _DoPaint( wxDC& dc );
-    void      _ErasePiece( hoxPiece* piece );
+    /**
+     * Compose the Board (background, Pieces and highlights) within
+     * a given area of a DC.
+     */
+    void   _ComposeRect( wxDC& dc, const wxRect& rect );
+
+    /**
+     * Bring the back buffer up to date (after a change of size,
+     * background or Pieces).
+     */
+    void   _UpdateBuffers();
+
+    /**
+     * Compose a given area again, and copy it to the screen at once.
+     * It does nothing if the whole Board is to be composed again.
+     */
+    void   _RefreshRect( const wxRect& rect );
+    void   _RefreshPiece( const hoxPiece* piece )
+                { _RefreshRect( _GetPieceRect( piece ) ); }
+
+    /**
+     * Compose the whole Board again (with the background, if specified)
+     * at the next paint.
+     */
+    void   _RefreshAll( bool bBackground = false );
+
     void      _ClearPieces();
     void      _ReloadAllPieceBitmaps();
     hoxPiece* _FindPiece( const wxPoint& point ) const;
@@ -283,13 +326,35 @@ private:
     hoxPosition _PointToPosition( const hoxPiece* piece, const wxPoint& p ) const;
 
     void _DrawHighlight( wxDC& dc, const wxRect rect );
-    void _EraseHighlight( wxDC& dc, const wxRect rect, const hoxPosition position );
+
+    /**
+     * Move a highlight (m_dragStartRect or m_dragHighlightRect)
+     * to a new rectangle (empty to remove it).
+     */
+    void _SetHighlight( wxRect& highlight, const wxRect& rect );
 
     void _OnMouseEvent_ClickNClick( wxMouseEvent& event );
     void _OnMouseEvent_DragNDrop( wxMouseEvent& event );
 
     void      _RecordMove( const hoxMove& move );
 
+    /**
+     * The number of Moves played to reach the position on the Board.
+     */
+    int       _GetReviewPly() const;
+
+    /**
+     * Take a keyframe of the position on the Board, if it is the first
+     * one to reach the next multiple of KEYFRAME_PLIES.
+     */
+    void      _TakeKeyframe();
+
+    /**
+     * Put the Pieces back as they were in a keyframe.
+     * The Board is not refreshed.
+     */
+    void      _RestoreKeyframe( const int nKeyframe );
+
     /**
      * !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
      * TODO: This API exists ONLY to help printing debug-message related to
@@ -303,6 +368,7 @@ private:
     wxString           m_sImage;
     hoxCoreBackground* m_background;
     wxString           m_piecesPath; // The path of all Pieces' bitmaps.
+    int                m_nPieceSize; // The size limit of their bitmaps (a cell).
 
     /* Board's characteristics. */
     bool            m_bViewInverted; // true if Black is at the bottom
@@ -318,17 +384,22 @@ private:
     int             m_dragMode;
     hoxPiece*       m_dragPiece;
     wxPoint         m_dragStartPos;
-    wxRect          m_dragStartRect;
+    wxRect          m_dragStartRect;     // Highlight of the selected Piece.
     wxDragImage*    m_dragImage;
-    wxRect          m_dragHighlightRect;
-    hoxPosition     m_dragHighlightPos;
+    wxRect          m_dragHighlightRect; // Highlight of the target.
 
     hoxPiece*       m_latestPiece; // piece that last moved.
 
+    /* The back buffer. */
+    wxBitmap        m_bgBuffer;     // The background at the current size.
+    wxBitmap        m_backBuffer;   // The background with the Pieces.
+    bool            m_bBgDirty;     // The background is to be drawn again.
+    bool            m_bPiecesDirty; // All Pieces are to be composed again.
+
     /* The History of all Moves 
      * This list is maintained so that the players can review the game.
      */
-    hoxMoveVector   m_historyMoves; // All (past) Moves made so far.
+    hoxMoveHistory  m_historyMoves; // All (past) Moves made so far.
     enum HistoryIndex // NOTE: Do not change the constants 'values below.
     {
         HISTORY_INDEX_END   = -2,
@@ -336,6 +407,23 @@ private:
     };
     int             m_historyIndex; // Which Move the user is reviewing.
 
+    /* Keyframes of the History, to jump to any Move without replaying
+     * the whole game.  The N-th one is the position after
+     * N * KEYFRAME_PLIES Moves.  Each one keeps one byte per Piece,
+     * plus the captured Pieces in the order of m_pieces, so that they
+     * are found again in the right order (see _FindAndCapturePieceAt).
+     */
+    enum { KEYFRAME_PLIES = 16 };
+    enum { KEY_PIECE_ACTIVE = 0x80 };
+    struct hoxKeyframe
+    {
+        std::vector<unsigned char> squares;  // By index in m_keyPieces: y * 9 + x,
+                                             // plus KEY_PIECE_ACTIVE if active.
+        std::vector<unsigned char> captured; // Indexes of the inactive Pieces.
+    };
+    std::vector<hoxKeyframe> m_keyframes;
+    std::vector<hoxPiece*>   m_keyPieces; // All Pieces, in the order of creation.
+
     /* End-Game tracking */
     bool            m_isGameOver;
 
@@ -347,9 +347,12 @@ enum hoxRequestType
     /* -----------------------------*
      *     AI specific messages     *   
      * -----------------------------*/
-    hoxREQUEST_AI_LEVEL
+    hoxREQUEST_AI_LEVEL,
         /* AI's difficulty level */
 
+    hoxREQUEST_AI_OPTION
+        /* An AI engine's option (Hash size, opening Book, ...) */
+
 };
 
 /**
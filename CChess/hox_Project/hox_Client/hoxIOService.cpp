@@ -0,0 +1,129 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxIOService.cpp
+// Created:         10/19/2026
+//
+// Description:     The I/O Service shared by all Sockets of the process.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "hoxIOService.h"
+#include <wx/wx.h>
+#include <boost/bind.hpp>
+
+/* Define (initialize) the single instance */
+hoxIOService*
+hoxIOService::m_instance = NULL;
+
+int
+hoxIOService::m_nThreads = 0;
+
+/* static */
+hoxIOService*
+hoxIOService::GetInstance()
+{
+    if ( m_instance == NULL )
+        m_instance = new hoxIOService( m_nThreads );
+
+    return m_instance;
+}
+
+/* static */
+void
+hoxIOService::DeleteInstance()
+{
+    delete m_instance;
+    m_instance = NULL;
+}
+
+/* static */
+void
+hoxIOService::SetThreadCount( int nThreads )
+{
+    m_nThreads = ( nThreads > 0 ? nThreads : 0 );
+}
+
+/* private */
+hoxIOService::hoxIOService( int nThreads )
+        : m_work( new asio::io_service::work( m_io_service ) )
+        , m_threadEnded( m_mutex )
+        , m_nEnded( 0 )
+{
+    if ( nThreads <= 0 )
+    {
+        nThreads = wxThread::GetCPUCount();
+        if ( nThreads <= 0 ) nThreads = 1;  // ... if unknown.
+    }
+
+    wxLogDebug("%s: Start [%d] I/O threads.", __FUNCTION__, nThreads);
+    for ( int i = 0; i < nThreads; ++i )
+    {
+        m_threads.push_back(
+            new asio::thread( boost::bind(&hoxIOService::_Run, this) ) );
+    }
+}
+
+hoxIOService::~hoxIOService()
+{
+    const long CLOSE_TIMEOUT = 3000; // in milliseconds.
+
+    /* The threads end by themselves once the Sockets are all closed.
+     * Those still open after the timeout are abandoned: their handlers
+     * are destroyed with the service, which also frees the Sockets.
+     */
+    delete m_work;
+    m_work = NULL;
+    {
+        wxMutexLocker lock( m_mutex );
+        const wxLongLong deadline = ::wxGetLocalTimeMillis() + CLOSE_TIMEOUT;
+        while ( m_nEnded < (int) m_threads.size() )
+        {
+            const wxLongLong now = ::wxGetLocalTimeMillis();
+            if (    now >= deadline
+                 || m_threadEnded.WaitTimeout( (deadline - now).ToLong() ) == wxCOND_TIMEOUT )
+            {
+                wxLogDebug("%s: *WARN* Abandon the Sockets still open.", __FUNCTION__);
+                break;
+            }
+        }
+    }
+    m_io_service.stop();
+
+    wxLogDebug("%s: Waiting for the I/O threads to end...", __FUNCTION__);
+    for ( ThreadList::iterator it = m_threads.begin(); it != m_threads.end(); ++it )
+    {
+        (*it)->join();   // ************ WAIT HERE
+        delete (*it);
+    }
+    m_threads.clear();
+}
+
+void
+hoxIOService::_Run()
+{
+    m_io_service.run();
+
+    wxMutexLocker lock( m_mutex );
+    ++m_nEnded;
+    m_threadEnded.Signal();
+}
+
+/************************* END OF FILE ***************************************/
@@ -0,0 +1,79 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxIOService.h
+// Created:         10/19/2026
+//
+// Description:     The I/O Service shared by all Sockets of the process.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_HOX_IO_SERVICE_H__
+#define __INCLUDED_HOX_IO_SERVICE_H__
+
+#include <asio.hpp>
+#include <wx/thread.h>
+#include <vector>
+
+/**
+ * The I/O Service (the asio reactor) with its pool of threads, serving
+ * every Socket (hoxAsyncSocket) of the process.  A Socket keeps its own
+ * handlers in order with a strand, so any thread of the pool may run them.
+ *
+ * This is implemented as a singleton.  The threads are started with the
+ * first Socket, and stopped by DeleteInstance(), which gives the Sockets
+ * being closed a few seconds to finish (to send a LOGOUT, for example).
+ */
+class hoxIOService
+{
+public:
+    static hoxIOService* GetInstance();
+    static void          DeleteInstance();
+
+    static void SetThreadCount( int nThreads );
+        /* The threads of the pool, 0 for one per CPU (the default).
+         * It takes effect with the next GetInstance() creating the pool. */
+
+    ~hoxIOService();
+
+    asio::io_service& GetService() { return m_io_service; }
+    int GetThreadCount() const { return (int) m_threads.size(); }
+
+private:
+    hoxIOService( int nThreads );
+    void _Run();
+
+    static hoxIOService* m_instance;
+    static int           m_nThreads;
+
+private:
+    asio::io_service          m_io_service;
+    asio::io_service::work*   m_work;
+                /* Keeps the threads running while no Socket is open. */
+
+    typedef std::vector<asio::thread*> ThreadList;
+    ThreadList                m_threads;
+
+    wxMutex                   m_mutex;
+    wxCondition               m_threadEnded;
+    int                       m_nEnded;  // The threads out of run().
+};
+
+#endif /* __INCLUDED_HOX_IO_SERVICE_H__ */
@@ -64,7 +64,7 @@ public:
     /**
      * Get the list of (past) Moves made so far.
      */
-    virtual void GetHistoryMoves( hoxMoveList& moveList ) const = 0;
+    virtual void GetHistoryMoves( hoxMoveHistory& moves ) const = 0;
 
     /**
      * Get the NEXT color, which specifies who (RED or BLACK) should
@@ -78,6 +78,13 @@ public:
      */
     virtual hoxMove StringToMove( const wxString& sMove ) const = 0;
 
+    /**
+     * Convert a pair of positions (FROM and TO) into a Move.
+     * @return an invalid Move if there is no Piece at FROM.
+     */
+    virtual hoxMove PositionsToMove( const hoxPosition& from,
+                                     const hoxPosition& to ) const = 0;
+
     /**
      * Get all available Moves of the NEXT color.
      * @param moves The [OUT] returned vector containing the list of
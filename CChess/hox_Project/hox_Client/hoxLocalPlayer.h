@@ -30,6 +30,7 @@
 
 #include "hoxPlayer.h"
 #include "hoxTypes.h"
+#include "hoxTableRegistry.h"
 
 class hoxChatWindow;
 
@@ -78,6 +79,12 @@ public:
                                            const wxString& message );
     virtual void OnPrivateChatWindowClosed();
 
+    hoxTableRegistry& GetTableRegistry() { return m_tables; }
+
+protected:
+    hoxTableRegistry  m_tables;
+            /* The network Tables, as last received from the server. */
+
 private:
 	bool            m_bRequestingLogout;
 			/* Whether this Player is LOGOUT-ing from the server.
@@ -315,7 +315,8 @@ hoxMyPlayer::_HandleEvent_LIST( const wxString& sContent )
 		tableList.push_back( tableInfo );
     }
 
-    m_site->OnListOfTablesReceived( tableList );
+    m_tables.ResetTables( tableList );
+    m_site->OnListOfTablesReceived( m_tables );
 }
 
 void
@@ -602,8 +603,11 @@ hoxMyPlayer::_HandleEvent_I_MOVES( const wxString& sContent )
         return;
     }
 
-    hoxStringList moves;
-    _ParseMovesString( sMoves, moves );
+    hoxMoveHistory moves;
+    if ( _ParseMovesString( sMoves, moves ) != hoxRC_OK )
+    {
+        wxLogDebug("%s: Invalid past Moves [%s].", __FUNCTION__, sMoves.c_str());
+    }
 
     pTable->OnPastMoves( moves );
 }
@@ -711,18 +715,9 @@ hoxMyPlayer::_ParseNetworkTable( const wxString&      sTable,
 
 hoxResult
 hoxMyPlayer::_ParseMovesString( const wxString& sMoves,
-                                hoxStringList&  moves )
+                                hoxMoveHistory& moves )
 {
-	wxStringTokenizer tkz( sMoves, "/", wxTOKEN_STRTOK /* no emtpy token */ );
-	wxString token;
-
-	while ( tkz.HasMoreTokens() )
-	{
-		token = tkz.GetNextToken();
-        moves.push_back( token );
-	}		
-
-	return hoxRC_OK;
+    return ( moves.AppendStrings( sMoves, "/" ) ? hoxRC_OK : hoxRC_ERR );
 }
 
 /************************* END OF FILE ***************************************/
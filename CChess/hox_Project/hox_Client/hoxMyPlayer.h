@@ -93,7 +93,7 @@ private:
                              hoxStringList*       pObservers = NULL );
 
     hoxResult _ParseMovesString( const wxString& sMoves,
-                                 hoxStringList&  moves );
+                                 hoxMoveHistory& moves );
 
 private:
     bool      m_bLoginSuccess;  /* Has this Player logged in successfully? */ 
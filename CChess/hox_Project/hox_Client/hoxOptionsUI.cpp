@@ -25,7 +25,9 @@
 #include "hoxOptionsUI.h"
 #include "hoxAIPluginMgr.h"
 #include "hoxUtil.h"
+#include "hoxPieceAtlas.h"
 #include <wx/dir.h>
+#include <wx/spinctrl.h>
 
 ////@begin XPM images
 ////@end XPM images
@@ -135,6 +137,7 @@ void hoxOptionsUI::Init()
 
     m_bAlreadySetSelectedPage = false;
     m_selectedPage = 0;
+    m_panelAIOptions = NULL;
 }
 
 
@@ -273,6 +276,14 @@ void hoxOptionsUI::CreateControls()
     GetBookCtrl()->SetPageImage(1, 1);
     GetBookCtrl()->SetPageImage(2, 2);
 
+    // The options of the selected AI engine (see _ShowAIOptions()).
+    wxWindow* aiPage = FindWindow( ID_OPTIONS_AI );
+    wxStaticBox* aiOptionsBox = new wxStaticBox( aiPage, wxID_ANY, _("Engine Options") );
+    wxStaticBoxSizer* aiOptionsSizer = new wxStaticBoxSizer( aiOptionsBox, wxVERTICAL );
+    aiPage->GetSizer()->Add( aiOptionsSizer, 1, wxGROW|wxALL, 5 );
+    m_panelAIOptions = new wxPanel( aiPage, wxID_ANY );
+    aiOptionsSizer->Add( m_panelAIOptions, 1, wxGROW|wxALL, 5 );
+
     _InitLanguageChoices();
     _InitBoardImageChoices();
     m_colorPickerBackground->SetColour( m_sBgColor );
@@ -384,6 +395,85 @@ void hoxOptionsUI::_InitAIChoices()
     
     m_listBoxEngines->InsertItems( aiNames, 0 );
     m_listBoxEngines->SetStringSelection( m_sDefaultAI );
+    _ShowAIOptions( m_sDefaultAI );
+}
+
+void hoxOptionsUI::_ShowAIOptions( const wxString& sPlugin )
+{
+    m_sAIOptionsPlugin = sPlugin;
+    m_panelAIOptions->DestroyChildren();
+
+    wxFlexGridSizer* sizer = new wxFlexGridSizer( 0 /* rows */, 2 /* cols */, 0, 0 );
+    sizer->AddGrowableCol( 1 );
+
+    AIOptionList options;
+    if ( ! sPlugin.empty() )
+    {
+        hoxAIPluginMgr::GetInstance()->GetOptionsOfAIPlugin( sPlugin, options );
+    }
+
+    const hoxParameters& edited = m_aiOptions[sPlugin];
+
+    for ( AIOptionList::const_iterator it = options.begin();
+                                       it != options.end(); ++it )
+    {
+        /* Show the edited value, else the saved one, else the engine's. */
+        const wxString sName = hoxUtil::std2wx( it->name );
+        wxString sValue = hoxUtil::std2wx( it->value );
+        hoxParameters::const_iterator found_it = edited.find( sName );
+        if ( found_it != edited.end() )
+        {
+            sValue = found_it->second;
+        }
+        else if ( ! wxGetApp().GetAIOption( sPlugin, sName ).empty() )
+        {
+            sValue = wxGetApp().GetAIOption( sPlugin, sName );
+        }
+
+        wxWindow* control = NULL;
+        switch ( it->type )
+        {
+            case AIOption::AI_OPTION_SPIN:
+            {
+                control = new wxSpinCtrl( m_panelAIOptions, wxID_ANY, sValue,
+                                          wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS,
+                                          it->minValue, it->maxValue, ::atoi( sValue.c_str() ) );
+                control->Connect( wxEVT_COMMAND_SPINCTRL_UPDATED,
+                                  wxCommandEventHandler(hoxOptionsUI::OnAIOptionChanged), NULL, this );
+                break;
+            }
+            case AIOption::AI_OPTION_CHECK:
+            {
+                wxCheckBox* checkBox = new wxCheckBox( m_panelAIOptions, wxID_ANY, wxEmptyString );
+                checkBox->SetValue( sValue == "true" );
+                control = checkBox;
+                control->Connect( wxEVT_COMMAND_CHECKBOX_CLICKED,
+                                  wxCommandEventHandler(hoxOptionsUI::OnAIOptionChanged), NULL, this );
+                break;
+            }
+            default: /* AIOption::AI_OPTION_STRING */
+            {
+                control = new wxTextCtrl( m_panelAIOptions, wxID_ANY, sValue );
+                control->Connect( wxEVT_COMMAND_TEXT_UPDATED,
+                                  wxCommandEventHandler(hoxOptionsUI::OnAIOptionChanged), NULL, this );
+                break;
+            }
+        }
+        control->SetName( sName );
+
+        sizer->Add( new wxStaticText( m_panelAIOptions, wxID_ANY, sName + ":" ),
+                    0, wxALIGN_CENTER_VERTICAL|wxALL, 5 );
+        sizer->Add( control, 1, wxGROW|wxALL, 5 );
+    }
+
+    if ( options.empty() )
+    {
+        sizer->Add( new wxStaticText( m_panelAIOptions, wxID_ANY, _("(No options)") ),
+                    0, wxALIGN_LEFT|wxALL, 5 );
+    }
+
+    m_panelAIOptions->SetSizer( sizer );  // The old sizer is deleted.
+    m_panelAIOptions->GetParent()->Layout();
 }
 
 wxArrayString
@@ -458,12 +548,7 @@ hoxOptionsUI::_DrawOnePieceAt( wxDC&          dc,
                                hoxColor       pieceColor,
                                const wxPoint& pos )
 {
-    wxImage  image;
-    wxBitmap bitmap;
-    if ( hoxRC_OK == hoxUtil::LoadPieceImage( m_sPiece, pieceType, pieceColor, image ) )
-    {
-        bitmap = wxBitmap(image);
-    }
+    wxBitmap bitmap = hoxPieceAtlas::GetInstance()->GetBitmap( m_sPiece, pieceType, pieceColor );
 
     const wxCoord x = pos.x - (bitmap.GetWidth() / 2);
     const wxCoord y = pos.y - (bitmap.GetHeight() / 2);
@@ -528,6 +613,34 @@ void hoxOptionsUI::OnColorForegroundColourPickerChanged( wxColourPickerEvent& ev
 void hoxOptionsUI::OnListboxEnginesSelected( wxCommandEvent& event )
 {
     m_sDefaultAI = event.GetString();
+    _ShowAIOptions( m_sDefaultAI );
+}
+
+
+/*!
+ * Events from the controls created by _ShowAIOptions()
+ */
+
+void hoxOptionsUI::OnAIOptionChanged( wxCommandEvent& event )
+{
+    wxWindow* control = wxDynamicCast(event.GetEventObject(), wxWindow);
+    wxCHECK_RET( control, "The control must not be NULL" );
+
+    wxString sValue;
+    if ( wxSpinCtrl* spinCtrl = wxDynamicCast(control, wxSpinCtrl) )
+    {
+        sValue = wxString::Format("%d", spinCtrl->GetValue());
+    }
+    else if ( wxCheckBox* checkBox = wxDynamicCast(control, wxCheckBox) )
+    {
+        sValue = checkBox->GetValue() ? "true" : "false";
+    }
+    else if ( wxTextCtrl* textCtrl = wxDynamicCast(control, wxTextCtrl) )
+    {
+        sValue = textCtrl->GetValue();
+    }
+
+    m_aiOptions[m_sAIOptionsPlugin][control->GetName()] = sValue;
 }
 
 
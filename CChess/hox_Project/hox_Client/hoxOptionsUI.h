@@ -81,6 +81,10 @@ public:
     wxString     m_sPiece;
     wxString     m_sDefaultAI;
 
+    /* The AI options edited by the user: plugin -> (option -> value). */
+    typedef std::map<const wxString, hoxParameters> AIOptionsMap;
+    AIOptionsMap m_aiOptions;
+
     bool         m_bAlreadySetSelectedPage;
     size_t   	 m_selectedPage;
 
@@ -126,6 +130,7 @@ public:
 ////@end hoxOptionsUI event handler declarations
 
     void OnPageChanged( wxBookCtrlEvent& event );
+    void OnAIOptionChanged( wxCommandEvent& event );
 
 ////@begin hoxOptionsUI member function declarations
 
@@ -161,6 +166,7 @@ private:
     void _InitBoardImageChoices();
     void _InitPieceSetChoices();
     void _InitAIChoices();
+    void _ShowAIOptions( const wxString& sPlugin );
     wxArrayString _loadAvailableBoardImages() const;
     wxArrayString _loadAvailablePieceSets() const;
     void _DrawPiecePreview( wxPanel*      panel,
@@ -175,6 +181,9 @@ private:
 private:
     wxBitmap          m_boardBitmap;
     hoxBoardImageInfo m_boardInfo;
+
+    wxPanel*          m_panelAIOptions;  // The options of an AI engine...
+    wxString          m_sAIOptionsPlugin;  // ... of this plugin.
 };
 
 #endif
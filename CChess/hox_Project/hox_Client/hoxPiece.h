@@ -29,30 +29,32 @@
 #define __INCLUDED_HOX_PIECE_H__
 
 #include "hoxTypes.h"
-#include "hoxUtil.h"
+#include "hoxPieceAtlas.h"
 
 class hoxPiece : public wxObject
 {
 public:
     hoxPiece( const hoxPieceInfo& info,
-              const wxString&     bitmapPath )
+              const wxString&     bitmapPath,
+              int                 nMaxSize = 0 )
             : m_info( info )
             , m_active( true )
             , m_show( true )
             , m_latest( false )
     {
-        this->LoadBitmap( bitmapPath );
+        this->LoadBitmap( bitmapPath, nMaxSize );
     }
 
-    void LoadBitmap( const wxString& bitmapPath )
+    /**
+     * Take the bitmap (shared by all Boards) of this Piece in a given set,
+     * scaled down to 'nMaxSize' if larger (0 for its own size).
+     */
+    void LoadBitmap( const wxString& bitmapPath,
+                     int             nMaxSize = 0 )
     {
-        wxImage image;
-        if ( hoxRC_OK == hoxUtil::LoadPieceImage( bitmapPath,
-                                                  m_info.type, m_info.color,
-                                                  image ) )
-        {
-            m_bitmap = wxBitmap(image);
-        }
+        m_bitmap = hoxPieceAtlas::GetInstance()->GetBitmap( bitmapPath,
+                                                            m_info.type, m_info.color,
+                                                            nMaxSize );
     }
     const wxBitmap& GetBitmap() const { return m_bitmap; }
 
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxPieceAtlas.cpp
+// Created:         10/19/2026
+//
+// Description:     The bitmaps of the Pieces, shared by all Boards.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "hoxPieceAtlas.h"
+#include "hoxUtil.h"
+
+/* Define (initialize) the single instance */
+hoxPieceAtlas*
+hoxPieceAtlas::m_instance = NULL;
+
+/* static */
+hoxPieceAtlas*
+hoxPieceAtlas::GetInstance()
+{
+    if ( m_instance == NULL )
+        m_instance = new hoxPieceAtlas();
+
+    return m_instance;
+}
+
+/* static */
+void
+hoxPieceAtlas::DeleteInstance()
+{
+    delete m_instance;
+    m_instance = NULL;
+}
+
+wxBitmap
+hoxPieceAtlas::GetBitmap( const wxString& sPieceSet,
+                          hoxPieceType    type,
+                          hoxColor        color,
+                          int             nMaxSize /* = 0 */ )
+{
+    const wxString sImageKey =
+        wxString::Format("%s|%d|%d", sPieceSet.c_str(), (int) type, (int) color);
+    const wxString sBitmapKey = wxString::Format("%s|%d", sImageKey.c_str(), nMaxSize);
+
+    hoxPieceBitmapMap::const_iterator found_it = m_bitmaps.find( sBitmapKey );
+    if ( found_it != m_bitmaps.end() ) // found?
+    {
+        return found_it->second;
+    }
+
+    const wxImage& image = _GetImage( sImageKey, sPieceSet, type, color );
+    if ( ! image.Ok() )
+    {
+        return wxBitmap();  // *** Empty bitmap.
+    }
+
+    wxBitmap bitmap;
+    const int nSize = wxMax( image.GetWidth(), image.GetHeight() );
+    if ( nMaxSize > 0 && nSize > nMaxSize )
+    {
+        const int width  = wxMax( image.GetWidth()  * nMaxSize / nSize, 1 );
+        const int height = wxMax( image.GetHeight() * nMaxSize / nSize, 1 );
+        bitmap = wxBitmap( image.Scale( width, height, wxIMAGE_QUALITY_HIGH ) );
+    }
+    else
+    {
+        bitmap = wxBitmap( image );
+    }
+
+    if ( m_bitmaps.size() >= MAX_BITMAPS ) _DropUnusedBitmaps();
+    m_bitmaps[sBitmapKey] = bitmap;
+    return bitmap;
+}
+
+const wxImage&
+hoxPieceAtlas::_GetImage( const wxString& sKey,
+                          const wxString& sPieceSet,
+                          hoxPieceType    type,
+                          hoxColor        color )
+{
+    hoxPieceImageMap::iterator found_it = m_images.find( sKey );
+    if ( found_it != m_images.end() ) // found?
+    {
+        return found_it->second;
+    }
+
+    /* NOTE: An image that cannot be read is kept (invalid) as well,
+     *       so that the error is reported once.
+     */
+    wxImage& image = m_images[sKey];
+    hoxUtil::LoadPieceImage( sPieceSet, type, color, image );
+    return image;
+}
+
+void
+hoxPieceAtlas::_DropUnusedBitmaps()
+{
+    /* A bitmap is unused if the atlas holds the only reference to it. */
+    hoxPieceBitmapMap::iterator it = m_bitmaps.begin();
+    while ( it != m_bitmaps.end() )
+    {
+        const wxObjectRefData* data = it->second.GetRefData();
+        if ( data == NULL || data->GetRefCount() == 1 )
+        {
+            hoxPieceBitmapMap::iterator unused_it = it++;
+            m_bitmaps.erase( unused_it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/************************* END OF FILE ***************************************/
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxPieceAtlas.h
+// Created:         10/19/2026
+//
+// Description:     The bitmaps of the Pieces, shared by all Boards.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_HOX_PIECE_ATLAS_H__
+#define __INCLUDED_HOX_PIECE_ATLAS_H__
+
+#include <wx/wx.h>
+#include <wx/hashmap.h>
+#include "hoxTypes.h"
+
+WX_DECLARE_STRING_HASH_MAP( wxImage, hoxPieceImageMap );
+WX_DECLARE_STRING_HASH_MAP( wxBitmap, hoxPieceBitmapMap );
+
+/**
+ * The bitmaps of the Pieces of all piece sets, shared by all Boards of
+ * the process.  The image of a Piece (a piece set, type and color) is
+ * read from its PNG file once; each size of it is scaled and converted to
+ * the platform's bitmap (with its alpha premultiplied, under Windows)
+ * once.  A bitmap being reference-counted, the Pieces given one share it.
+ *
+ * The bitmaps of the sizes no longer used (after a resize of the Boards)
+ * are dropped as the atlas grows.
+ *
+ * This is implemented as a singleton, used by the GUI thread only.
+ */
+class hoxPieceAtlas
+{
+public:
+    static hoxPieceAtlas* GetInstance();
+    static void           DeleteInstance();
+
+    /**
+     * Get the bitmap of a Piece, scaled down to fit in a square of
+     * 'nMaxSize' pixels if it is larger (0 for its own size).
+     *
+     * @return An invalid bitmap if the image cannot be read.
+     */
+    wxBitmap GetBitmap( const wxString& sPieceSet,
+                        hoxPieceType    type,
+                        hoxColor        color,
+                        int             nMaxSize = 0 );
+
+private:
+    hoxPieceAtlas() {}
+
+    const wxImage& _GetImage( const wxString& sKey,
+                              const wxString& sPieceSet,
+                              hoxPieceType    type,
+                              hoxColor        color );
+    void _DropUnusedBitmaps();
+
+    static hoxPieceAtlas* m_instance;
+
+private:
+    enum { MAX_BITMAPS = 256 };  // Before the unused ones are dropped.
+
+    hoxPieceImageMap   m_images;   // By piece set, type and color.
+    hoxPieceBitmapMap  m_bitmaps;  // ... and size.
+};
+
+#endif /* __INCLUDED_HOX_PIECE_ATLAS_H__ */
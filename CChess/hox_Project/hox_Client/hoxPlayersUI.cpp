@@ -28,6 +28,7 @@
 #include "hoxPlayersUI.h"
 #include "MyApp.h"    // wxGetApp()
 #include "hoxUtil.h"
+#include <algorithm>
 
 /* Menu Items IDs. */
 enum hoxPLAYERS_Menu_Id
@@ -86,18 +87,44 @@ BEGIN_EVENT_TABLE(hoxPlayersUI, wxListCtrl)
 END_EVENT_TABLE()
 
 // ---------------------------------------------------------------------------
-// CallBack function to sort Players in the list.
+// The record of a Player in the list, and the order of the rows.
 // ---------------------------------------------------------------------------
 
-int wxCALLBACK
-_ComparePlayersCallBack( long item1, 
-                         long item2, 
-                         long sortOrder )
+struct hoxPlayerRecord
 {
-    if (item1 < item2)  return sortOrder == hoxPlayersUI::PLAYERS_SORT_ASCENDING ? -1 : 1;
-    if (item1 > item2)  return sortOrder == hoxPlayersUI::PLAYERS_SORT_ASCENDING ? 1 : -1;
-    return 0;
-}
+    wxString         id;
+    int              score;
+    hoxPlayerStatus  status;
+
+    hoxPlayerRecord( const wxString& a_id, int a_score, hoxPlayerStatus a_status )
+        : id( a_id ), score( a_score ), status( a_status ) {}
+};
+
+/**
+ * By Rating if sorted so, and then by Id.
+ */
+class hoxPlayerRecordLess
+{
+public:
+    hoxPlayerRecordLess( hoxPlayersUI::SortOrder sortOrder )
+        : m_sortOrder( sortOrder ) {}
+
+    bool operator()( const hoxPlayerRecord* r1,
+                     const hoxPlayerRecord* r2 ) const
+    {
+        if ( r1->score != r2->score )
+        {
+            if ( m_sortOrder == hoxPlayersUI::PLAYERS_SORT_ASCENDING )
+                return r1->score < r2->score;
+            if ( m_sortOrder == hoxPlayersUI::PLAYERS_SORT_DESCENDING )
+                return r1->score > r2->score;
+        }
+        return r1->id < r2->id;
+    }
+
+private:
+    hoxPlayersUI::SortOrder  m_sortOrder;
+};
 
 // ---------------------------------------------------------------------------
 // hoxPlayersUI class
@@ -107,7 +134,7 @@ hoxPlayersUI::hoxPlayersUI( wxWindow* parent,
                             UIType    uiType )
             : wxListCtrl( parent, wxID_ANY,
                           wxDefaultPosition, wxDefaultSize,
-                          wxLC_REPORT | wxLC_SINGLE_SEL )
+                          wxLC_REPORT | wxLC_SINGLE_SEL | wxLC_VIRTUAL )
             , m_uiType( uiType )
             , m_owner( NULL )
             , m_sortOrderByRating( PLAYERS_SORT_NONE )
@@ -129,6 +156,12 @@ hoxPlayersUI::~hoxPlayersUI()
     const int wId     = GetColumnWidth( hoxPLAYERS_UI_COLUMN_ID );
     const int wRating = GetColumnWidth( hoxPLAYERS_UI_COLUMN_RATING );
     _SaveDefaultLayout( wId, wRating );
+
+    for ( hoxPlayerRecordMap::iterator it = m_records.begin();
+                                       it != m_records.end(); ++it )
+    {
+        delete it->second;
+    }
 }
 
 bool
@@ -136,61 +169,70 @@ hoxPlayersUI::AddPlayer( const wxString&       sPlayerId,
                          const int             nPlayerScore,
                          const hoxPlayerStatus playerStatus /* = hoxPLAYER_STATUS_UNKNOWN */ )
 {
-    /* Remove the old item, if any. */
-    bool bRemoved = this->RemovePlayer( sPlayerId );
-
-    const long itemIndex = this->InsertItem( 0 /* Front of the list */, 
-                                             sPlayerId );
+    const wxString sSelectedId = this->GetSelectedPlayer();
 
-    this->SetItem( itemIndex, hoxPLAYERS_UI_COLUMN_RATING,
-                   wxString::Format("%d", nPlayerScore));
-
-    /* Set the item-date for sorting purpose (sort-by-score). */
-	this->SetItemData( itemIndex, nPlayerScore);
-
-    const int imageIndex = _StatusToImageIndex( playerStatus );
-    this->SetItemImage( itemIndex, imageIndex );
+    /* Update the old record, if any. */
+    hoxPlayerRecord* record = _FindPlayer( sPlayerId );
+    if ( record != NULL ) // found?
+    {
+        _RemoveRow( record );
+        record->score  = nPlayerScore;
+        record->status = playerStatus;
+        _InsertRow( record );
+        _SelectPlayer( sSelectedId );
+        return false;
+    }
 
-    /* If the Player was NOT found (to be removed) before being inserted,
+    /* If the Player was NOT found before being inserted,
      * then he has just joined this Board.
      */
-    return ( ! bRemoved );
+    record = new hoxPlayerRecord( sPlayerId, nPlayerScore, playerStatus );
+    m_records[sPlayerId] = record;
+    _InsertRow( record );
+    _SelectPlayer( sSelectedId );
+    return true;
 }
 
 bool
 hoxPlayersUI::RemovePlayer( const wxString& sPlayerId )
 {
-    const long playerIndex = _FindPlayerIndex( sPlayerId );
-    if ( playerIndex != -1 ) // found?
+    hoxPlayerRecord* record = _FindPlayer( sPlayerId );
+    if ( record == NULL ) // not found?
     {
-        this->DeleteItem( playerIndex );
-        return true;
+        return false;
     }
-    return false;
+
+    const wxString sSelectedId = this->GetSelectedPlayer();
+    _RemoveRow( record );
+    m_records.erase( sPlayerId );
+    delete record;
+    _SelectPlayer( sSelectedId );
+    return true;
 }
 
 bool
 hoxPlayersUI::UpdateScore( const wxString& sPlayerId,
                            const int       nPlayerScore )
 {
-    const long playerIndex = _FindPlayerIndex( sPlayerId );
-    if ( playerIndex == -1 ) // not found?
+    hoxPlayerRecord* record = _FindPlayer( sPlayerId );
+    if ( record == NULL ) // not found?
     {
         wxLogDebug("%s: Player [%s] not found.", __FUNCTION__, sPlayerId.c_str());
         return false;
     }
 
-    wxListItem     row_info;  
-
-    // Set what row it is (m_itemId is a member of the regular wxListCtrl class)
-    row_info.m_itemId = playerIndex;
-    // Set what column of that row we want to query for information.
-    row_info.m_col = hoxPLAYERS_UI_COLUMN_RATING;
-    row_info.m_mask = wxLIST_MASK_TEXT; // Set text mask
-
-    row_info.m_text = wxString::Format("%d", nPlayerScore);
-    SetItem( row_info );
+    if ( m_sortOrderByRating == PLAYERS_SORT_NONE ) // The row stays?
+    {
+        record->score = nPlayerScore;
+        this->RefreshItem( _FindRow( record ) );
+        return true;
+    }
 
+    const wxString sSelectedId = this->GetSelectedPlayer();
+    _RemoveRow( record );
+    record->score = nPlayerScore;
+    _InsertRow( record );
+    _SelectPlayer( sSelectedId );
     return true;
 }
 
@@ -198,42 +240,43 @@ bool
 hoxPlayersUI::UpdateStatus( const wxString&       sPlayerId,
                             const hoxPlayerStatus playerStatus )
 {
-    const long playerIndex = _FindPlayerIndex( sPlayerId );
-    if ( playerIndex == -1 ) // notfound?
+    hoxPlayerRecord* record = _FindPlayer( sPlayerId );
+    if ( record == NULL ) // notfound?
     {
         wxLogDebug("%s: Player [%s] not found.", __FUNCTION__, sPlayerId.c_str());
         return false;
     }
 
-    const int imageIndex = _StatusToImageIndex( playerStatus );
-    this->SetItemImage( playerIndex, imageIndex );
+    record->status = playerStatus;
+    this->RefreshItem( _FindRow( record ) );
     return true;
 }
 
 bool
 hoxPlayersUI::HasPlayer( const wxString& sPlayerId ) const
 {
-    const long playerIndex = _FindPlayerIndex( sPlayerId );
-    return ( playerIndex != -1 );
+    return ( _FindPlayer( sPlayerId ) != NULL );
 }
 
 int
 hoxPlayersUI::GetPlayerScore( const wxString& sPlayerId ) const
 {
-    const long playerIndex = _FindPlayerIndex( sPlayerId );
-    if ( playerIndex != -1 ) // found?
-    {
-        const wxString sScore = _GetCellContent( playerIndex,
-                                                 hoxPLAYERS_UI_COLUMN_RATING );
-        return ::atoi( sScore.c_str() );
-    }
-    return hoxSCORE_UNKNOWN;
+    const hoxPlayerRecord* record = _FindPlayer( sPlayerId );
+    return ( record != NULL ? record->score : hoxSCORE_UNKNOWN );
 }
 
 void
 hoxPlayersUI::RemoveAllPlayers()
 {
-    this->DeleteAllItems();
+    for ( hoxPlayerRecordMap::iterator it = m_records.begin();
+                                       it != m_records.end(); ++it )
+    {
+        delete it->second;
+    }
+    m_records.clear();
+    m_rows.clear();
+    this->SetItemCount( 0 );
+    this->Refresh();
 }
 
 wxString
@@ -244,9 +287,9 @@ hoxPlayersUI::GetSelectedPlayer() const
     long nSelectedItem = this->GetNextItem( -1,
                                             wxLIST_NEXT_ALL,
                                             wxLIST_STATE_SELECTED );
-    if ( nSelectedItem != -1 ) // Got a selected item?
+    if ( nSelectedItem >= 0 && nSelectedItem < (long) m_rows.size() ) // Got a selected item?
     {
-        sPlayerId = _GetCellContent( nSelectedItem, hoxPLAYERS_UI_COLUMN_ID );
+        sPlayerId = m_rows[nSelectedItem]->id;
     }
     return sPlayerId;
 }
@@ -322,7 +365,14 @@ hoxPlayersUI::OnColumnClick( wxListEvent& event )
                                ? PLAYERS_SORT_DESCENDING
                                : PLAYERS_SORT_ASCENDING  );
 
-        this->SortItems( _ComparePlayersCallBack, m_sortOrderByRating );
+        const wxString sSelectedId = this->GetSelectedPlayer();
+        std::sort( m_rows.begin(), m_rows.end(),
+                   hoxPlayerRecordLess( m_sortOrderByRating ) );
+        if ( ! m_rows.empty() )
+        {
+            this->RefreshItems( 0, (long) m_rows.size() - 1 );
+        }
+        _SelectPlayer( sSelectedId );
 
         wxListItem item;
         item.SetMask(wxLIST_MASK_IMAGE);
@@ -333,46 +383,93 @@ hoxPlayersUI::OnColumnClick( wxListEvent& event )
     }
 }
 
-long
-hoxPlayersUI::_FindPlayerIndex( const wxString& sPlayerId ) const
+wxString
+hoxPlayersUI::OnGetItemText( long item, long column ) const
 {
-    const int nCount = this->GetItemCount();
-    for ( int iRow = 0; iRow < nCount; ++iRow )
+    if ( item < 0 || item >= (long) m_rows.size() ) return "";
+
+    const hoxPlayerRecord* record = m_rows[item];
+    switch ( column )
     {
-        if ( sPlayerId == _GetCellContent( iRow,
-                                           hoxPLAYERS_UI_COLUMN_ID ) ) // matched?
-        {
-            return iRow;  // Found the index.
-        }
+        case hoxPLAYERS_UI_COLUMN_ID:     return record->id;
+        case hoxPLAYERS_UI_COLUMN_RATING: return wxString::Format("%d", record->score);
+        default:                          return "";
     }
-    return -1;   // Not found.
 }
 
-/**
- * CREDITS: The following code was extracted from this site:
- * http://wiki.wxwidgets.org/WxListCtrl#Get_the_string_contents_of_a_.22cell.22_in_a_LC_REPORT_wxListCtrl
- */
-wxString
-hoxPlayersUI::_GetCellContent( const long row_number,
-                               const int  column ) const
+int
+hoxPlayersUI::OnGetItemImage( long item ) const
+{
+    if ( item < 0 || item >= (long) m_rows.size() ) return -1;
+
+    return _StatusToImageIndex( m_rows[item]->status );
+}
+
+hoxPlayerRecord*
+hoxPlayersUI::_FindPlayer( const wxString& sPlayerId ) const
+{
+    hoxPlayerRecordMap::const_iterator found_it = m_records.find( sPlayerId );
+    return ( found_it != m_records.end() ? found_it->second : NULL );
+}
+
+long
+hoxPlayersUI::_FindRow( const hoxPlayerRecord* record ) const
 {
-    wxListItem     row_info;  
-    wxString       cell_contents_string;
+    PlayerRows::const_iterator pos =
+        std::lower_bound( m_rows.begin(), m_rows.end(), record,
+                          hoxPlayerRecordLess( m_sortOrderByRating ) );
+    if ( pos == m_rows.end() || *pos != record ) return -1;
+    return (long) ( pos - m_rows.begin() );
+}
 
-    // Set what row it is (m_itemId is a member of the regular wxListCtrl class)
-    row_info.m_itemId = row_number;
-    // Set what column of that row we want to query for information.
-    row_info.m_col = column;
-    // Set text mask
-    row_info.m_mask = wxLIST_MASK_TEXT;
+void
+hoxPlayersUI::_InsertRow( hoxPlayerRecord* record )
+{
+    PlayerRows::iterator pos =
+        std::lower_bound( m_rows.begin(), m_rows.end(), record,
+                          hoxPlayerRecordLess( m_sortOrderByRating ) );
+    const long row = (long) ( pos - m_rows.begin() );
+    m_rows.insert( pos, record );
+
+    /* The rows from this one down have moved. */
+    this->SetItemCount( (long) m_rows.size() );
+    this->RefreshItems( row, (long) m_rows.size() - 1 );
+}
+
+void
+hoxPlayersUI::_RemoveRow( const hoxPlayerRecord* record )
+{
+    const long row = _FindRow( record );
+    if ( row == -1 ) return;
 
-    // Get the info and store it in row_info variable.   
-    GetItem( row_info );
+    m_rows.erase( m_rows.begin() + row );
 
-    // Extract the text out that cell
-    cell_contents_string = row_info.m_text; 
+    /* The rows from this one down have moved. */
+    this->SetItemCount( (long) m_rows.size() );
+    if ( row < (long) m_rows.size() )
+    {
+        this->RefreshItems( row, (long) m_rows.size() - 1 );
+    }
+}
 
-    return cell_contents_string;
+void
+hoxPlayersUI::_SelectPlayer( const wxString& sPlayerId )
+{
+    const long selectedRow = this->GetNextItem( -1,
+                                                wxLIST_NEXT_ALL,
+                                                wxLIST_STATE_SELECTED );
+    const hoxPlayerRecord* record = _FindPlayer( sPlayerId );
+    const long row = ( record != NULL ? _FindRow( record ) : -1 );
+    if ( row == selectedRow ) return;
+
+    if ( selectedRow != -1 )
+    {
+        this->SetItemState( selectedRow, 0, wxLIST_STATE_SELECTED );
+    }
+    if ( row != -1 )
+    {
+        this->SetItemState( row, wxLIST_STATE_SELECTED, wxLIST_STATE_SELECTED );
+    }
 }
 
 void
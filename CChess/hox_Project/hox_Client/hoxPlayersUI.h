@@ -30,12 +30,25 @@
 
 #include <wx/listctrl.h>
 #include <wx/imaglist.h>
+#include <wx/hashmap.h>
+#include <vector>
 #include "hoxTypes.h"
 
+/* Forward declarations */
+struct hoxPlayerRecord;
+
+WX_DECLARE_STRING_HASH_MAP( hoxPlayerRecord*, hoxPlayerRecordMap );
+
 // ---------------------------------------------------------------------------
 // hoxPlayersUI class
 // ---------------------------------------------------------------------------
 
+/**
+ * A (virtual) list of Players.  The Players are kept in records, indexed by
+ * their Ids, and the rows are a sorted vector of these records: a change
+ * is a lookup, a binary search, and the refresh of the rows that moved.
+ * Nothing is read back from the control.
+ */
 class hoxPlayersUI : public wxListCtrl
 {
 public:
@@ -116,11 +129,19 @@ public:
     void OnPlayerMsg( wxCommandEvent& event );
     void OnColumnClick( wxListEvent& event );
 
+    // **** Override the parent's API ****
+    virtual wxString OnGetItemText( long item, long column ) const;
+    virtual int      OnGetItemImage( long item ) const;
+
 private:
-    long _FindPlayerIndex( const wxString& sPlayerId ) const;
+    hoxPlayerRecord* _FindPlayer( const wxString& sPlayerId ) const;
+        /* Returns NULL if the Player is not in the list. */
 
-    wxString _GetCellContent( const long row_number,
-                              const int  column ) const;
+    long _FindRow( const hoxPlayerRecord* record ) const;
+    void _InsertRow( hoxPlayerRecord* record );
+    void _RemoveRow( const hoxPlayerRecord* record );
+    void _SelectPlayer( const wxString& sPlayerId );
+        /* Select the row of a Player (none if the Player is not found). */
 
     void _InitializeImageList();
     int  _StatusToImageIndex( const hoxPlayerStatus playerStatus ) const;
@@ -139,6 +160,11 @@ private:
 
     wxImageList*      m_imageList;
 
+    typedef std::vector<hoxPlayerRecord*> PlayerRows;
+
+    hoxPlayerRecordMap  m_records;  // The records (owned) by Player-Id.
+    PlayerRows          m_rows;     // The records in the order of the rows.
+
     DECLARE_EVENT_TABLE()
 
 }; // END of hoxPlayersUI
@@ -237,8 +237,10 @@ namespace BoardInfoAPI
         void GetGameState( hoxGameState& gameState ) const;
 
         hoxMove StringToMove( const wxString& sMove ) const;
+        hoxMove PositionsToMove( const hoxPosition& from,
+                                 const hoxPosition& to ) const;
 
-        void GetHistoryMoves( hoxMoveList& moveList ) const;
+        void GetHistoryMoves( hoxMoveHistory& moves ) const;
 
         hoxColor GetNextColor() const { return m_nextColor; }
 
@@ -284,7 +286,7 @@ namespace BoardInfoAPI
 
         hoxGameStatus  m_gameStatus;
 
-        hoxMoveList    m_historyMoves;  // All (past) Moves made so far.
+        hoxMoveHistory m_historyMoves;  // All (past) Moves made so far.
     };
 
     /*********************
@@ -421,8 +423,6 @@ Board::GetGameState( hoxGameState& gameState ) const
 hoxMove
 Board::StringToMove( const wxString& sMove ) const
 {
-    hoxMove move;
-
     /* NOTE: Move-string has the format of "xyXY" */
 
     if ( sMove.size() != 4 )
@@ -430,10 +430,18 @@ Board::StringToMove( const wxString& sMove ) const
         return hoxMove();  // Error: return an invalid Move.
     }
 
-    move.piece.position.x = sMove[0] - '0';
-    move.piece.position.y = sMove[1] - '0';
-    move.newPosition.x    = sMove[2] - '0';
-    move.newPosition.y    = sMove[3] - '0';
+    return this->PositionsToMove( hoxPosition( sMove[0] - '0', sMove[1] - '0' ),
+                                  hoxPosition( sMove[2] - '0', sMove[3] - '0' ) );
+}
+
+hoxMove
+Board::PositionsToMove( const hoxPosition& from,
+                        const hoxPosition& to ) const
+{
+    hoxMove move;
+
+    move.piece.position = from;
+    move.newPosition    = to;
 
     /* Lookup a Piece based on "fromPosition". */
 
@@ -448,9 +456,9 @@ Board::StringToMove( const wxString& sMove ) const
 }
 
 void
-Board::GetHistoryMoves( hoxMoveList& moveList ) const
+Board::GetHistoryMoves( hoxMoveHistory& moves ) const
 {
-    moveList = m_historyMoves;
+    moves = m_historyMoves;
 }
 
 bool 
@@ -775,13 +783,13 @@ Board::ValidateMove( hoxMove&       move,
     move.SetCapturedPiece( pCaptured ? pCaptured->GetInfo() 
                                      : hoxPieceInfo() /* 'Empty' piece */ );
 
-    /* Save the Move for future reference. */
-    m_historyMoves.push_back( move );
-
     /* Set the next-turn. */
     m_nextColor = ( m_nextColor == hoxCOLOR_RED ? hoxCOLOR_BLACK
                                                 : hoxCOLOR_RED );
 
+    /* Save the Move for future reference. */
+    m_historyMoves.Append( move );
+
     /* Check for end game:
      * ------------------
      *   Checking if this Move makes the Move's Player
@@ -1516,9 +1524,9 @@ hoxReferee::GetGameState( hoxGameState& gameState ) const
 }
 
 void
-hoxReferee::GetHistoryMoves( hoxMoveList& moveList ) const
+hoxReferee::GetHistoryMoves( hoxMoveHistory& moves ) const
 {
-    m_board->GetHistoryMoves( moveList );
+    m_board->GetHistoryMoves( moves );
 }
 
 hoxColor 
@@ -1533,6 +1541,13 @@ hoxReferee::StringToMove( const wxString& sMove ) const
     return m_board->StringToMove( sMove );
 }
 
+hoxMove
+hoxReferee::PositionsToMove( const hoxPosition& from,
+                             const hoxPosition& to ) const
+{
+    return m_board->PositionsToMove( from, to );
+}
+
 void
 hoxReferee::GetAvailableNextMoves( hoxMoveVector& moves ) const
 {
@@ -52,9 +52,11 @@ public:
     virtual bool ValidateMove( hoxMove&       move,
                                hoxGameStatus& status );
     virtual void GetGameState( hoxGameState& gameState ) const;
-    virtual void GetHistoryMoves( hoxMoveList& moveList ) const;
+    virtual void GetHistoryMoves( hoxMoveHistory& moves ) const;
     virtual hoxColor GetNextColor() const;
     virtual hoxMove StringToMove( const wxString& sMove ) const;
+    virtual hoxMove PositionsToMove( const hoxPosition& from,
+                                     const hoxPosition& to ) const;
     virtual void GetAvailableNextMoves( hoxMoveVector& moves ) const;
 
 private:
@@ -28,7 +28,6 @@
 
 #include "hoxSavedTable.h"
 #include "hoxUtil.h"
-#include <wx/tokenzr.h>
 
 hoxSavedTable::hoxSavedTable( const wxString& fileName )
         : m_fileName( fileName )
@@ -38,7 +37,7 @@ hoxSavedTable::hoxSavedTable( const wxString& fileName )
 
 bool
 hoxSavedTable::SaveGameState( const wxString&         tableId,
-                              const hoxMoveList&      moveList, 
+                              const hoxMoveHistory&   pastMoves, 
                               const hoxPieceInfoList& pieceInfoList,
                               const hoxColor          nextColor )
 {
@@ -48,15 +47,8 @@ hoxSavedTable::SaveGameState( const wxString&         tableId,
 	m_doc.SetRoot(root);
 
     /* Save the 'past' Moves. */
-    wxString sMoves;
-    for ( hoxMoveList::const_iterator it = moveList.begin();
-                                      it != moveList.end(); ++it )
-    {
-        if ( !sMoves.empty() ) sMoves += '/';
-        sMoves += it->ToString();
-    }
     wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, "Moves" );
-    node->AddAttribute("value", sMoves);
+    node->AddAttribute("value", pastMoves.ToString("/"));
 	root->AddChild( node );
 
     /* Save the 'next' color. */
@@ -84,7 +76,7 @@ hoxSavedTable::SaveGameState( const wxString&         tableId,
 }
 
 bool
-hoxSavedTable::LoadGameState( hoxStringList&    pastMoves,
+hoxSavedTable::LoadGameState( hoxMoveHistory&   pastMoves,
                               hoxPieceInfoList& pieceInfoList,
                               hoxColor&         nextColor )
 {
@@ -162,15 +154,14 @@ hoxSavedTable::_LoadPieces( const wxXmlNode*  parentNode,
 
 bool
 hoxSavedTable::_LoadMoves( const wxXmlNode* parentNode,
-                           hoxStringList&   pastMoves )
+                           hoxMoveHistory&  pastMoves )
 {
     const wxString sMoves = parentNode->GetAttribute("value");
 
-	wxStringTokenizer tkz( sMoves, "/", wxTOKEN_STRTOK );
-	while ( tkz.HasMoreTokens() )
-	{
-        pastMoves.push_back( tkz.GetNextToken() );
-	}		
+    if ( ! pastMoves.AppendStrings( sMoves, "/" ) )
+    {
+        wxLogWarning("%s: Invalid Moves skipped [%s].", __FUNCTION__, sMoves.c_str());
+    }
 
     return true; // success.
 }
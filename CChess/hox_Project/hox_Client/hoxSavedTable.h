@@ -48,11 +48,11 @@ public:
     virtual ~hoxSavedTable() {}
 
     bool SaveGameState( const wxString&         tableId,
-                        const hoxMoveList&      moveList,
+                        const hoxMoveHistory&   pastMoves,
                         const hoxPieceInfoList& pieceInfoList,
                         const hoxColor          nextColor );
 
-    bool LoadGameState( hoxStringList&    pastMoves,
+    bool LoadGameState( hoxMoveHistory&   pastMoves,
                         hoxPieceInfoList& pieceInfoList,
                         hoxColor&         nextColor );
 
@@ -60,7 +60,7 @@ private:
     bool _LoadPieces( const wxXmlNode*  parentNode,
                       hoxPieceInfoList& pieceInfoList );
     bool _LoadMoves( const wxXmlNode* parentNode,
-                     hoxStringList&   pastMoves );
+                     hoxMoveHistory&  pastMoves );
 
 private:
     const wxString  m_fileName;
@@ -39,6 +39,8 @@
 #include "hoxAIPluginMgr.h"
 #include "hoxSavedTable.h"
 #include <wx/progdlg.h>
+#include <wx/filename.h>
+#include <wx/datetime.h>
 
 
 /**
@@ -390,9 +392,10 @@ hoxLocalSite::OnLocalRequest_PRACTICE( const wxString& sSavedFile /* = "" */ )
 
     /* Load the saved game from disk, if requested. */
 
-    std::string            fen; // Forsyth-Edwards Notation (FEN)
+    AIPosition             position;  // The binary form of FEN.
+    bool                   bResumed = false;
     hoxGameStatus          gameStatus = hoxGAME_STATUS_READY;
-    std::list<std::string> stdMoves;
+    std::vector<AIMove>    aiMoves;
 
     if ( ! sSavedFile.empty() )
     {
@@ -403,7 +406,7 @@ hoxLocalSite::OnLocalRequest_PRACTICE( const wxString& sSavedFile /* = "" */ )
          *       The 'past' Moves are enough to re-create the last game.
          * !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
 
-        hoxStringList    pastMoves;
+        hoxMoveHistory   pastMoves;
         hoxPieceInfoList pieceInfoList; // Not really needed!
         hoxColor         nextColor;     // Not really needed!
 
@@ -417,18 +420,22 @@ hoxLocalSite::OnLocalRequest_PRACTICE( const wxString& sSavedFile /* = "" */ )
 
         hoxGameState gameState;
         pReferee->GetGameState( gameState );
-        fen = hoxUtil::hoxGameStateToFEN( gameState );
+        hoxUtil::hoxGameStateToAIPosition( gameState, position );
+        bResumed = true;
         gameStatus = gameState.gameStatus;
 
-        for ( hoxStringList::const_iterator it = pastMoves.begin();
-                                            it != pastMoves.end(); ++it )
+        aiMoves.reserve( pastMoves.size() );
+        for ( size_t i = 0; i < pastMoves.size(); ++i )
         {
-            stdMoves.push_back( std::string( it->c_str() ) );
+            aiMoves.push_back( pastMoves.GetBinary( i ) );
         }
     }
 
     /* Initialize the AI engine's game. */
-    const int nRet = apAIEngineLib->initGame( fen, stdMoves );
+    const int nRet = apAIEngineLib->initGameBinary(
+                                bResumed ? &position : NULL,
+                                aiMoves.empty() ? NULL : &aiMoves[0],
+                                (int) aiMoves.size() );
     if ( nRet == hoxAI_RC_NOT_SUPPORTED && !sSavedFile.empty() )
     {
         ::wxMessageBox( "The AI Plugin does not support the 'resume game' feature.",
@@ -442,12 +449,40 @@ hoxLocalSite::OnLocalRequest_PRACTICE( const wxString& sSavedFile /* = "" */ )
         return;
     }
 
+    AIOptionList aiOptions;
+    apAIEngineLib->listOptions( aiOptions );
+
     hoxAIPlayer* pAIPlayer = new hoxAIPlayer( sAIId, hoxPLAYER_TYPE_AI, 1500 );
     pAIPlayer->SetEngineAPI( apAIEngineLib.release() ); // Caller will de-allocate.
+
+    /* Log the searches of the engine, one file per game, if asked to. */
+    const wxString sStatsDir = wxGetApp().GetOption("aiStatsDir");
+    if ( ! sStatsDir.empty() )
+    {
+        const wxString sName = sAIId + wxDateTime::Now().Format("-%Y%m%d-%H%M%S.txt");
+        pAIPlayer->SetStatsFile( wxFileName( sStatsDir, sName ).GetFullPath() );
+    }
+
     result = pAIPlayer->JoinTableAs( pTable, hoxCOLOR_BLACK );
     wxASSERT( result == hoxRC_OK );
     pAIPlayer->Start();
 
+    /* Apply the saved options of the engine (Hash size, Book, ...).
+     * They are handled by the AI thread before any Move request.
+     */
+    for ( AIOptionList::const_iterator it = aiOptions.begin();
+                                       it != aiOptions.end(); ++it )
+    {
+        const wxString sName  = hoxUtil::std2wx( it->name );
+        const wxString sValue = wxGetApp().GetAIOption( sAIId, sName );
+        if ( sValue.empty() || sValue == hoxUtil::std2wx( it->value ) ) continue;
+
+        hoxRequest_APtr apRequest( new hoxRequest( hoxREQUEST_AI_OPTION ) );
+        apRequest->parameters["name"]  = sName;
+        apRequest->parameters["value"] = sValue;
+        pAIPlayer->OnRequest_FromTable( apRequest );
+    }
+
     /* Request a Move from AI if the "next" turn is BLACK. */
     if (    !( hoxIReferee::IsGameOverStatus( gameStatus ) )
          && pReferee->GetNextColor() == hoxCOLOR_BLACK )
@@ -525,7 +560,7 @@ hoxRemoteSite::OnResponse_LOGIN( const hoxResponse_APtr& response )
 }
 
 void
-hoxRemoteSite::OnListOfTablesReceived( const hoxNetworkTableInfoList& tableList )
+hoxRemoteSite::OnListOfTablesReceived( hoxTableRegistry& tables )
 {
     /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
      * NOTE: Implement a temporary ("better-than-none") solution that show
@@ -539,18 +574,19 @@ hoxRemoteSite::OnListOfTablesReceived( const hoxNetworkTableInfoList& tableList
         observers.insert(it->first);
     }
 
-    for ( hoxNetworkTableInfoList::const_iterator it = tableList.begin(); 
-                                                  it != tableList.end(); ++it )
+    for ( hoxTableRegistry::const_iterator it = tables.begin(); 
+                                           it != tables.end(); ++it )
     {
-        if ( ! it->redId.empty() )
+        const hoxNetworkTableInfo& tableInfo = it->second;
+        if ( ! tableInfo.redId.empty() )
         {
-            m_playersUI->UpdateStatus( it->redId, hoxPLAYER_STATUS_PLAYING );
-            observers.erase(it->redId);
+            m_playersUI->UpdateStatus( tableInfo.redId, hoxPLAYER_STATUS_PLAYING );
+            observers.erase(tableInfo.redId);
         }
-        if ( ! it->blackId.empty() )
+        if ( ! tableInfo.blackId.empty() )
         {
-            m_playersUI->UpdateStatus( it->blackId, hoxPLAYER_STATUS_PLAYING );
-            observers.erase(it->blackId);
+            m_playersUI->UpdateStatus( tableInfo.blackId, hoxPLAYER_STATUS_PLAYING );
+            observers.erase(tableInfo.blackId);
         }
     }
 
@@ -560,7 +596,7 @@ hoxRemoteSite::OnListOfTablesReceived( const hoxNetworkTableInfoList& tableList
         m_playersUI->UpdateStatus( *it, hoxPLAYER_STATUS_OBSERVING );
     }
 
-    this->DisplayListOfTables(tableList);
+    this->DisplayListOfTables(tables);
 }
 
 void
@@ -680,13 +716,13 @@ hoxRemoteSite::JoinLocalPlayerToTable( const hoxNetworkTableInfo& tableInfo )
 }
 
 void
-hoxRemoteSite::DisplayListOfTables( const hoxNetworkTableInfoList& tableList )
+hoxRemoteSite::DisplayListOfTables( hoxTableRegistry& tables )
 {
     MyFrame* frame = wxGetApp().GetFrame();
 	const unsigned int actionFlags = this->GetCurrentActionFlags();
     
     hoxTablesDialog* pTablesDlg = new hoxTablesDialog( frame, wxID_ANY, _("List of Tables"),
-                                                       tableList, actionFlags );
+                                                       tables, actionFlags );
     m_pTablesDlg = pTablesDlg;  // Register for site-deleted-event callback.
     const int nCommandId = pTablesDlg->ShowModal();
     if ( nCommandId == hoxTablesDialog::COMMAND_ID_SITE_DELETED )
@@ -976,9 +1012,9 @@ hoxChesscapeSite::OnLocalRequest_NEW()
 }
 
 void
-hoxChesscapeSite::OnListOfTablesReceived( const hoxNetworkTableInfoList& tableList )
+hoxChesscapeSite::OnListOfTablesReceived( hoxTableRegistry& tables )
 {
-    this->DisplayListOfTables(tableList);
+    this->DisplayListOfTables(tables);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -38,6 +38,7 @@
 /* Forward declarations. */
 class hoxProgressDialog;
 class hoxTablesDialog;
+class hoxTableRegistry;
 
 /**
  * The Site's Actions that are enabled at a given time.
@@ -122,7 +123,7 @@ public:
                                    const hoxPlayerStatus playerStatus = hoxPLAYER_STATUS_UNKNOWN );
     virtual void OnPlayerLoggedOut( const wxString& sPlayerId );
 
-    virtual void OnListOfTablesReceived(const hoxNetworkTableInfoList& tableList) {}
+    virtual void OnListOfTablesReceived(hoxTableRegistry& tables) {}
 
     /**
      * Update the score of an ONLINE Player.
@@ -263,7 +264,7 @@ public:
 
     virtual void OnResponse_LOGIN( const hoxResponse_APtr& response );
 
-    virtual void OnListOfTablesReceived(const hoxNetworkTableInfoList& tableList);
+    virtual void OnListOfTablesReceived(hoxTableRegistry& tables);
 
     /*************************************************
      * Implement hoxPlayersUI::UIOwner 's interface.
@@ -276,7 +277,7 @@ public:
     virtual void OnLocalRequest_NEW();
 
 protected:
-    virtual void DisplayListOfTables(const hoxNetworkTableInfoList& tableList);
+    virtual void DisplayListOfTables(hoxTableRegistry& tables);
 
 private:
     /* This pointer exists solely for the purpose of handling the case
@@ -302,7 +303,7 @@ public:
     virtual void OnLocalRequest_JOIN( const wxString& sTableId );
     virtual void OnLocalRequest_NEW();
 
-    virtual void OnListOfTablesReceived(const hoxNetworkTableInfoList& tableList);
+    virtual void OnListOfTablesReceived(hoxTableRegistry& tables);
 
 protected:
     virtual unsigned int GetBoardFeatureFlags() const;
@@ -22,10 +22,11 @@
 // Name:            hoxSocketConnection.cpp
 // Created:         10/28/2007
 //
-// Description:     The Socket-Connection Thread to help MY player.
+// Description:     The Socket-Connection to help MY player.
 /////////////////////////////////////////////////////////////////////////////
 
 #include "hoxSocketConnection.h"
+#include "hoxIOService.h"
 #include "hoxPlayer.h"
 #include "hoxUtil.h"
 
@@ -37,41 +38,72 @@ IMPLEMENT_DYNAMIC_CLASS(hoxSocketConnection, hoxConnection)
 
 hoxSocketWriter::hoxSocketWriter( wxEvtHandler*           evtHandler,
                                   const hoxServerAddress& serverAddress )
-        : wxThread( wxTHREAD_JOINABLE )
-        , m_evtHandler( evtHandler )
+        : m_evtHandler( evtHandler )
         , m_serverAddress( serverAddress )
         , m_shutdownRequested( false )
         , m_bConnected( false )
-        , m_pSocketAgent( NULL )
-        , m_io_service_thread( NULL )
 {
 }
 
 hoxSocketWriter::~hoxSocketWriter()
 {
+    this->CloseSocketAgent();
 }
 
 bool
 hoxSocketWriter::AddRequest( hoxRequest_APtr apRequest )
 {
+    wxMutexLocker lock( m_mutex ); // Gain exclusive access.
+
     if ( m_shutdownRequested )
     {
-        wxLogDebug("%s: *WARN* Deny request [%s]. The thread is shutdowning.", 
+        wxLogDebug("%s: *WARN* Deny request [%s]. The connection is shutdowning.", 
             __FUNCTION__, hoxUtil::RequestTypeToString(apRequest->type).c_str());
         return false;
     }
 
-    m_requests.PushBack( apRequest );
-    m_semRequests.Post();  // Notify...
-	return true;
+    const hoxRequestType requestType = apRequest->type;
+    wxLogDebug("%s: Processing request = [%s]...", 
+        __FUNCTION__, hoxUtil::RequestTypeToString(requestType).c_str());
+
+    if ( requestType == hoxREQUEST_SHUTDOWN )
+    {
+        wxLogDebug("%s: A SHUTDOWN request just received.", __FUNCTION__);
+        m_shutdownRequested = true;
+    }
+    else
+    {
+        wxString sError;
+        const hoxResult result = this->HandleRequest( apRequest, sError );
+        if ( result != hoxRC_OK )
+        {
+            _postEventToHandler( result, sError, requestType );
+        }
+
+        if ( requestType == hoxREQUEST_LOGOUT )
+        {
+            m_shutdownRequested = true; // !!! Force to close !!!
+        }
+    }
+
+    if ( m_shutdownRequested )
+    {
+        /* Close the socket-connection. */
+        this->CloseSocketAgent();
+
+        /* Notify the Player. */
+        wxLogDebug("%s: Notify event-handler of connection CLOSED.", __FUNCTION__);
+        _postEventToHandler( hoxRC_CLOSED, "Connection CLOSED", hoxREQUEST_PLAYER_DATA );
+    }
+
+    return true;
 }
 
-hoxAsyncSocket*
-hoxSocketWriter::CreateSocketAgent( asio::io_service&       io_service,
-                                    tcp::resolver::iterator endpoint_iterator,
-                                    wxEvtHandler*           evtHandler)
+hoxAsyncSocket_SPtr
+hoxSocketWriter::CreateSocketAgent( asio::io_service& io_service,
+                                    wxEvtHandler*     evtHandler )
 {
-    return new hoxAsyncSocket( io_service, endpoint_iterator, evtHandler);
+    return hoxAsyncSocket_SPtr( new hoxAsyncSocket( io_service, evtHandler ) );
 }
 
 void
@@ -90,107 +122,18 @@ hoxSocketWriter::AskSocketAgentToWrite( const wxString& sRawMsg )
 void
 hoxSocketWriter::CloseSocketAgent()
 {
-    if ( m_io_service_thread )
+    if ( m_pSocketAgent )
     {
         m_pSocketAgent->close();
                 /* Need to call since some server does NOT
                  * auto-close the connection upon receiving LOGOUT.
                  */
 
-        wxLogDebug("%s: Waiting for IO-Service Thread to end...", __FUNCTION__);
-        m_io_service_thread->join();   // ************ WAIT HERE
-        wxLogDebug("%s: IO-Service Thread ended.", __FUNCTION__);
-        delete m_pSocketAgent;
-        m_pSocketAgent = NULL;
-        delete m_io_service_thread;
-        m_io_service_thread = NULL;
+        m_pSocketAgent.reset(); // ... deleted after its last handler.
         //m_bConnected = false;
     }
 }
 
-hoxRequest_APtr
-hoxSocketWriter::_GetRequest()
-{
-    hoxRequest_APtr apRequest = m_requests.PopFront();
-    wxCHECK_MSG(apRequest.get() != NULL, apRequest, "At least one request must exist");
-
-    /* Handle SHUTDOWN request here to avoid the possible memory leaks.
-     * The reason is that others (timers, for example) may continue to 
-     * send requests to this thread while this thread is shutdowning it self. 
-     *
-     * NOTE: The SHUTDOWN request is (purposely) handled here inside this function 
-     *       because the "mutex-lock" is still being held.
-     */
-
-    if ( apRequest->type == hoxREQUEST_SHUTDOWN )
-    {
-        wxLogDebug("%s: A SHUTDOWN request just received.", __FUNCTION__);
-        m_shutdownRequested = true;
-    }
-
-    /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-     * NOTE: The shutdown-request can come from:
-     *       (1) The code segment ABOVE, or
-     *       (2) It can be triggered from the outside callers
-     *           who could invoke this->Shutdown() to this Thread.
-     * !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-     */
-
-    if ( m_shutdownRequested )
-    {
-        wxLogDebug("%s: Shutting down this thread...", __FUNCTION__);
-        apRequest.reset(); /* Release memory and signal "no more request" ...
-                            * ... to the caller!
-                            */
-    }
-
-    return apRequest;
-}
-
-void*
-hoxSocketWriter::Entry()
-{
-    hoxRequest_APtr apRequest;
-    hoxResult       result = hoxRC_OK;
-    wxString        sError;
-
-    wxLogDebug("%s: ENTER.", __FUNCTION__);
-
-    while (   !m_shutdownRequested
-            && m_semRequests.Wait() == wxSEMA_NO_ERROR )
-    {
-        apRequest = _GetRequest();
-        if ( apRequest.get() == NULL )
-        {
-            wxASSERT_MSG( m_shutdownRequested, "This thread must be shutdowning." );
-            break;  // Exit the thread.
-        }
-        const hoxRequestType requestType = apRequest->type;
-        wxLogDebug("%s: Processing request = [%s]...", 
-            __FUNCTION__, hoxUtil::RequestTypeToString(requestType).c_str());
-
-        result = this->HandleRequest( apRequest, sError );
-        if ( result != hoxRC_OK )
-        {
-            _postEventToHandler( result, sError, requestType );
-        }
-
-        if ( requestType == hoxREQUEST_LOGOUT )
-        {
-            break; // !!! Force to close !!!
-        }
-    }
-
-    /* Close the socket-connection. */
-    this->CloseSocketAgent();
-
-    /* Notify the Player. */
-    wxLogDebug("%s: Notify event-handler of connection CLOSED.", __FUNCTION__);
-    _postEventToHandler( hoxRC_CLOSED, "Connection CLOSED", hoxREQUEST_PLAYER_DATA );
-
-    return NULL;
-}
-
 hoxResult
 hoxSocketWriter::HandleRequest( hoxRequest_APtr apRequest,
                                 wxString&       sError )
@@ -232,17 +175,12 @@ hoxSocketWriter::Connect( wxString& sError )
         const wxString sPort = wxString::Format("%d", m_serverAddress.port ); 
         const std::string sService = hoxUtil::wx2std( sPort );
 
-        tcp::resolver resolver( m_io_service );
-        tcp::resolver::query query( sHost, sService );
-        tcp::resolver::iterator iterator = resolver.resolve(query);
-
-        m_pSocketAgent = this->CreateSocketAgent( m_io_service, iterator, m_evtHandler);
+        m_pSocketAgent = this->CreateSocketAgent( hoxIOService::GetInstance()->GetService(),
+                                                  m_evtHandler );
+        m_pSocketAgent->connect( sHost, sService );
     
         // TODO: Set timeout = hoxSOCKET_CLIENT_SOCKET_TIMEOUT.
 
-        m_io_service_thread =
-            new asio::thread( boost::bind(&asio::io_service::run, &m_io_service) );
-
         // TODO: Not really have enough info to declare a 'success' connection!
         m_bConnected = true;
     }
@@ -306,33 +244,14 @@ hoxSocketConnection::Start()
 {
     wxLogDebug("%s: ENTER.", __FUNCTION__);
 
-    _StartWriter();
-    // *** This thread will also create and manage the Reader thread.
-}
-
-void
-hoxSocketConnection::_StartWriter()
-{
-    wxLogDebug("%s: ENTER.", __FUNCTION__);
-
-    if ( m_writer && m_writer->IsRunning() )
+    if ( m_writer )
     {
         wxLogDebug("%s: The Writer has already been started. END.", __FUNCTION__);
         return;
     }
 
-    wxLogDebug("%s: Create the Writer Thread...", __FUNCTION__);
     m_writer = this->CreateWriter( this->GetPlayer(), 
                                    m_serverAddress );
-    if ( m_writer->Create() != wxTHREAD_NO_ERROR )
-    {
-        wxLogDebug("%s: *WARN* Failed to create the Writer thread.", __FUNCTION__);
-        m_writer.reset();
-        return;
-    }
-    wxASSERT_MSG(!m_writer->IsDetached(), "The Writer thread must be joinable");
-
-    m_writer->Run();
 }
 
 hoxSocketWriter_SPtr
@@ -349,9 +268,7 @@ hoxSocketConnection::Shutdown()
 {
     if ( m_writer )
     {
-        wxLogDebug("%s: Request the Writer thread to shutdown...", __FUNCTION__);
-        wxThread::ExitCode exitCode = m_writer->Wait();
-        wxLogDebug("%s: The Writer thread shutdowned with exit-code = [%d].", __FUNCTION__, exitCode);
+        wxLogDebug("%s: Release the Writer...", __FUNCTION__);
         m_writer.reset();
     }
 }
@@ -359,7 +276,7 @@ hoxSocketConnection::Shutdown()
 bool
 hoxSocketConnection::AddRequest( hoxRequest_APtr apRequest )
 {
-    wxCHECK_MSG(m_writer, false, "The Writer thread not yet created");
+    wxCHECK_MSG(m_writer, false, "The Writer not yet created");
     return m_writer->AddRequest( apRequest );
 }
 
@@ -22,7 +22,7 @@
 // Name:            hoxSocketConnection.h
 // Created:         10/28/2007
 //
-// Description:     The Socket-Connection Thread to help MY player.
+// Description:     The Socket-Connection to help MY player.
 /////////////////////////////////////////////////////////////////////////////
 
 #ifndef __INCLUDED_HOX_SOCKET_CONNECTION_H__
@@ -45,7 +45,12 @@ typedef boost::shared_ptr<hoxSocketWriter> hoxSocketWriter_SPtr;
 // hoxSocketWriter
 // ----------------------------------------------------------------------------
 
-class hoxSocketWriter : public wxThread
+/**
+ * Turns the requests of the player into messages, and writes them to the
+ * Socket.  The requests are handled on the caller's thread, one at a time:
+ * the writing itself is done by the shared I/O Service (hoxIOService).
+ */
+class hoxSocketWriter
 {
 public:
     hoxSocketWriter( wxEvtHandler*           evtHandler,
@@ -56,21 +61,17 @@ public:
     bool IsConnected() const { return m_bConnected; }
 
 protected:
-    virtual void* Entry(); // Entry point for the thread.
-
     virtual hoxResult HandleRequest( hoxRequest_APtr apRequest,
                                      wxString&       sError );
     virtual hoxResult Connect( wxString& sError );
 
-    virtual hoxAsyncSocket* CreateSocketAgent( asio::io_service&       io_service,
-                                               tcp::resolver::iterator endpoint_iterator,
-                                               wxEvtHandler*           evtHandler );
+    virtual hoxAsyncSocket_SPtr CreateSocketAgent( asio::io_service& io_service,
+                                                   wxEvtHandler*     evtHandler );
     // ----
     void AskSocketAgentToWrite( const wxString& sRawMsg );
     void CloseSocketAgent();
 
 private:
-    hoxRequest_APtr _GetRequest();
     hoxResult       _WriteLine( const wxString& sContent );
 
     void _postEventToHandler( const hoxResult      result,
@@ -81,9 +82,8 @@ protected:
     wxEvtHandler*           m_evtHandler;
     const hoxServerAddress  m_serverAddress;
 
-    // Storage to hold pending outgoing requests.
-    wxSemaphore             m_semRequests;
-    hoxRequestQueue         m_requests;
+    wxMutex                 m_mutex;
+                /* One request at a time (to keep the messages in order). */
 
     bool                    m_shutdownRequested;
                 /* Has a shutdown-request been received? */
@@ -92,9 +92,7 @@ protected:
                 /* Has the connection been established with the server */
 
 private:
-    asio::io_service        m_io_service;
-    hoxAsyncSocket*         m_pSocketAgent;
-    asio::thread*           m_io_service_thread;
+    hoxAsyncSocket_SPtr     m_pSocketAgent;
 };
 
 // ----------------------------------------------------------------------------
@@ -122,16 +120,10 @@ protected:
     virtual hoxSocketWriter_SPtr CreateWriter( wxEvtHandler*           evtHandler,
                                                const hoxServerAddress& serverAddress );
 
-private:
-    void _StartWriter();
-
 private:
     const hoxServerAddress   m_serverAddress;
 
     hoxSocketWriter_SPtr     m_writer;
-                /* The Write Thread. 
-                 * This Thread also creates and manages the Reader Thread.
-                 */
 
     DECLARE_DYNAMIC_CLASS(hoxSocketConnection)
 };
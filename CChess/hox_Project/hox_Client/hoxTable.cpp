@@ -312,7 +312,7 @@ hoxTable::OnNewMove( const wxString& sMove )
 }
 
 void
-hoxTable::OnPastMoves( const hoxStringList& moves )
+hoxTable::OnPastMoves( const hoxMoveHistory& moves )
 {
     if ( m_board != NULL )
     {
@@ -668,6 +668,15 @@ hoxPracticeTable::GetAIInfo() const
     return "";
 }
 
+void
+hoxPracticeTable::OnAISearchInfo( wxCommandEvent& event )
+{
+    if ( m_board )
+    {
+        m_board->GetEventHandler()->ProcessEvent( event );
+    }
+}
+
 hoxAIPlayer*
 hoxPracticeTable::_GetAIPlayer() const
 {
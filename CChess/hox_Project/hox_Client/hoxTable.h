@@ -192,7 +192,7 @@ public:
      *
      * @param moves The list of past Moves.
      */
-    void OnPastMoves( const hoxStringList& moves );
+    void OnPastMoves( const hoxMoveHistory& moves );
 
     /**
      * Callback function from the NETWORK Player to let this Table know about
@@ -386,6 +386,8 @@ public:
     /* Practice-table specific API. */
     void OnAILevelUpdate( const int nAILevel );
     wxString GetAIInfo() const;
+    void OnAISearchInfo( wxCommandEvent& event );
+        /* Shows the progress of the AI (hoxEVT_AI_SEARCH_INFO) on the Board. */
 
 private:
     hoxAIPlayer* _GetAIPlayer() const;
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxTableRegistry.cpp
+// Created:         10/19/2026
+//
+// Description:     The network Tables known by a local Player.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "hoxTableRegistry.h"
+
+bool
+hoxTableRegistry::SetTable( const hoxNetworkTableInfo& tableInfo )
+{
+    hoxNetworkTableInfoMap::iterator found_it = m_tables.find( tableInfo.id );
+    if ( found_it == m_tables.end() ) // not found?
+    {
+        m_tables[tableInfo.id] = tableInfo;
+        _Notify( CHANGE_ADD, tableInfo );
+        return true;
+    }
+
+    if ( found_it->second != tableInfo ) // changed?
+    {
+        found_it->second = tableInfo;
+        _Notify( CHANGE_UPDATE, tableInfo );
+    }
+    return false;
+}
+
+bool
+hoxTableRegistry::RemoveTable( const wxString& tableId )
+{
+    hoxNetworkTableInfoMap::iterator found_it = m_tables.find( tableId );
+    if ( found_it == m_tables.end() ) // not found?
+    {
+        return false;
+    }
+
+    const hoxNetworkTableInfo tableInfo = found_it->second;
+    m_tables.erase( found_it );
+    _Notify( CHANGE_REMOVE, tableInfo );
+    return true;
+}
+
+void
+hoxTableRegistry::ResetTables( const hoxNetworkTableInfoList& tableList )
+{
+    /* Remove the Tables not in the new list. */
+
+    hoxNetworkTableInfoMap newTables;
+    for ( hoxNetworkTableInfoList::const_iterator it = tableList.begin();
+                                                  it != tableList.end(); ++it )
+    {
+        newTables[it->id] = (*it);
+    }
+
+    hoxStringList removedIds;
+    for ( const_iterator it = m_tables.begin(); it != m_tables.end(); ++it )
+    {
+        if ( newTables.find( it->first ) == newTables.end() )
+        {
+            removedIds.push_back( it->first );
+        }
+    }
+    for ( hoxStringList::const_iterator it = removedIds.begin();
+                                        it != removedIds.end(); ++it )
+    {
+        this->RemoveTable( *it );
+    }
+
+    /* Add or update the rest (SetTable skips the unchanged ones). */
+
+    for ( hoxNetworkTableInfoList::const_iterator it = tableList.begin();
+                                                  it != tableList.end(); ++it )
+    {
+        this->SetTable( *it );
+    }
+}
+
+const hoxNetworkTableInfo*
+hoxTableRegistry::FindTable( const wxString& tableId ) const
+{
+    const_iterator found_it = m_tables.find( tableId );
+    return ( found_it != m_tables.end() ? &(found_it->second) : NULL );
+}
+
+void
+hoxTableRegistry::_Notify( ChangeType                 changeType,
+                           const hoxNetworkTableInfo& tableInfo )
+{
+    if ( m_listener != NULL )
+    {
+        m_listener->OnTableChanged( changeType, tableInfo );
+    }
+}
+
+/************************* END OF FILE ***************************************/
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            hoxTableRegistry.h
+// Created:         10/19/2026
+//
+// Description:     The network Tables known by a local Player.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_HOX_TABLE_REGISTRY_H__
+#define __INCLUDED_HOX_TABLE_REGISTRY_H__
+
+#include <wx/hashmap.h>
+#include "hoxTypes.h"
+
+WX_DECLARE_STRING_HASH_MAP( hoxNetworkTableInfo, hoxNetworkTableInfoMap );
+
+/**
+ * The network Tables of a Site, keyed by their Ids, as last received by
+ * the local Player.  Each change is passed on to the Listener (if any),
+ * so a view (the Tables-Dialog) can be updated in place instead of
+ * being rebuilt.
+ */
+class hoxTableRegistry
+{
+public:
+    /**
+     * The types of change.
+     */
+    enum ChangeType
+    {
+        CHANGE_ADD,
+        CHANGE_UPDATE,
+        CHANGE_REMOVE
+    };
+
+    /**
+     * The Listener of the changes.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() {}
+        virtual void OnTableChanged( ChangeType                 changeType,
+                                     const hoxNetworkTableInfo& tableInfo ) = 0;
+    };
+
+    typedef hoxNetworkTableInfoMap::const_iterator const_iterator;
+
+public:
+    hoxTableRegistry() : m_listener( NULL ) {}
+
+    void SetListener( Listener* listener ) { m_listener = listener; }
+
+    /**
+     * Add a Table, or update it if it is already known and changed.
+     * @return true if the Table is added.
+     */
+    bool SetTable( const hoxNetworkTableInfo& tableInfo );
+
+    /**
+     * @return false if the Table is not found.
+     */
+    bool RemoveTable( const wxString& tableId );
+
+    /**
+     * Replace all the Tables with the ones of a (full) list.
+     * Only the differences are passed on to the Listener.
+     */
+    void ResetTables( const hoxNetworkTableInfoList& tableList );
+
+    /**
+     * @return NULL if the Table is not found.
+     */
+    const hoxNetworkTableInfo* FindTable( const wxString& tableId ) const;
+
+    bool HasTable( const wxString& tableId ) const
+        { return m_tables.find( tableId ) != m_tables.end(); }
+
+    size_t GetCount() const { return m_tables.size(); }
+
+    const_iterator begin() const { return m_tables.begin(); }
+    const_iterator end() const   { return m_tables.end(); }
+
+private:
+    void _Notify( ChangeType                 changeType,
+                  const hoxNetworkTableInfo& tableInfo );
+
+private:
+    hoxNetworkTableInfoMap  m_tables;
+    Listener*               m_listener;  // NULL if none.
+};
+
+#endif /* __INCLUDED_HOX_TABLE_REGISTRY_H__ */
@@ -28,6 +28,7 @@
 #include "hoxTablesDialog.h"
 #include "hoxUtil.h"
 #include "MyApp.h"    // wxGetApp()
+#include <algorithm>
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -53,36 +54,115 @@ BEGIN_EVENT_TABLE(hoxTablesDialog, wxDialog)
     EVT_LIST_ITEM_ACTIVATED(wxID_ANY, hoxTablesDialog::OnListItemDClick)
 END_EVENT_TABLE()
 
+//-----------------------------------------------------------------------------
+// hoxTablesListCtrl
+//-----------------------------------------------------------------------------
+
+/**
+ * The (virtual) List-Control of the Tables: a row is only drawn when it is
+ * visible, from the Registry.
+ */
+class hoxTablesListCtrl : public wxListCtrl
+{
+public:
+    hoxTablesListCtrl( wxWindow*                    parent,
+                       const hoxTableRegistry&      tables,
+                       const std::vector<wxString>& tableIds )
+            : wxListCtrl( parent, wxID_ANY,
+                          wxDefaultPosition, wxDefaultSize,
+                          wxLC_REPORT | wxLC_SINGLE_SEL | wxLC_VIRTUAL )
+            , m_tables( tables )
+            , m_tableIds( tableIds ) {}
+
+    virtual wxString OnGetItemText( long item, long column ) const;
+
+private:
+    const hoxTableRegistry&       m_tables;
+    const std::vector<wxString>&  m_tableIds;
+};
+
+wxString
+hoxTablesListCtrl::OnGetItemText( long item, long column ) const
+{
+    if ( item < 0 || item >= (long) m_tableIds.size() ) return "";
+
+    const hoxNetworkTableInfo* pTableInfo = m_tables.FindTable( m_tableIds[item] );
+    if ( pTableInfo == NULL ) return "";
+
+    const hoxNetworkTableInfo& tableInfo = *pTableInfo;
+    switch ( column )
+    {
+        case 0: return tableInfo.id;
+        case 1: return ( tableInfo.group == hoxGAME_GROUP_PUBLIC ? "Public" : "Private" );
+        case 2: return hoxUtil::GameTypeToString( tableInfo.gameType );
+        case 3: return   hoxUtil::FormatTime(tableInfo.initialTime.nGame) + " | " 
+                       + hoxUtil::FormatTime(tableInfo.initialTime.nMove) + " | " 
+                       + hoxUtil::FormatTime(tableInfo.initialTime.nFree);
+        case 4:
+            if ( tableInfo.redId.empty() ) return "*";
+            return tableInfo.redId + " (" << tableInfo.redScore << ")";
+        case 5:
+            if ( tableInfo.blackId.empty() ) return "*";
+            return tableInfo.blackId + " (" << tableInfo.blackScore << ")";
+        default: return "";
+    }
+}
+
 //-----------------------------------------------------------------------------
 // hoxTablesDialog
 //-----------------------------------------------------------------------------
 
-int wxCALLBACK
-_CompareTablesCallBack( long item1, 
-                        long item2, 
-                        long sortData /* not used */)
+/**
+ * The order of the Tables in the list: the numeric Ids by number, then
+ * the others as strings.
+ */
+static bool
+_IsTableIdLess( const wxString& id1,
+                const wxString& id2 )
 {
-    if (item1 < item2)  return -1;
-    if (item1 > item2)  return 1;
-    return 0;
+    long n1 = 0;
+    long n2 = 0;
+    const bool bNumber1 = id1.ToLong( &n1 );
+    const bool bNumber2 = id2.ToLong( &n2 );
+
+    /* NOTE: Keep a strict weak ordering (required by std::sort) when both
+     *       kinds are mixed. */
+    if ( bNumber1 != bNumber2 )
+    {
+        return bNumber1;
+    }
+    if ( bNumber1 && n1 != n2 )
+    {
+        return n1 < n2;
+    }
+    return id1 < id2;
 }
 
 hoxTablesDialog::hoxTablesDialog( wxWindow*                      parent, 
                                   wxWindowID                     id, 
                                   const wxString&                title,
-                                  const hoxNetworkTableInfoList& tableList,
+                                  hoxTableRegistry&              tables,
 								  unsigned int                   actionFlags )
         : wxDialog( parent, id, title, wxDefaultPosition, wxDefaultSize, 
 		            wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER )
+        , m_tables( &tables )
         , m_actionFlags( actionFlags )
 {
     wxBoxSizer* topSizer = new wxBoxSizer( wxVERTICAL );
 
+    /* Get the (sorted) Ids of the Tables. */
+
+    m_tableIds.reserve( tables.GetCount() );
+    for ( hoxTableRegistry::const_iterator it = tables.begin();
+                                           it != tables.end(); ++it )
+    {
+        m_tableIds.push_back( it->first );
+    }
+    std::sort( m_tableIds.begin(), m_tableIds.end(), _IsTableIdLess );
+
 	/* Create a List-Control to display the table-list. */
 
-	m_listCtrlTables = new wxListCtrl( this, wxID_ANY,
-		                               wxDefaultPosition, wxDefaultSize,
-		                               wxLC_REPORT | wxLC_SINGLE_SEL);
+	m_listCtrlTables = new hoxTablesListCtrl( this, tables, m_tableIds );
     long colIndex = 0;
     m_listCtrlTables->InsertColumn( colIndex++, _("Table") );
     m_listCtrlTables->InsertColumn( colIndex++, _("Group") );
@@ -93,53 +173,19 @@ hoxTablesDialog::hoxTablesDialog( wxWindow*                      parent,
 
     const int nColums = m_listCtrlTables->GetColumnCount();
 
-    long     itemIndex = 0;
-    wxString groupInfo;
-    wxString redInfo;
-    wxString blackInfo;
-
-    for ( hoxNetworkTableInfoList::const_iterator it = tableList.begin(); 
-											      it != tableList.end(); ++it )
-    {
-	    groupInfo = ( it->group == hoxGAME_GROUP_PUBLIC ? "Public" : "Private" );
-
-        if ( it->redId.empty() ) redInfo = "*";
-        else  redInfo = it->redId + " (" << it->redScore << ")";
-
-        if ( it->blackId.empty() ) blackInfo = "*";
-        else  blackInfo = it->blackId + " (" << it->blackScore << ")";
-
-	    colIndex = 0;
-	    itemIndex = m_listCtrlTables->InsertItem(itemIndex, it->id);
-	    m_listCtrlTables->SetItemData( itemIndex, ::atoi( it->id.c_str() ) );
-
-	    m_listCtrlTables->SetItem(itemIndex, ++colIndex, groupInfo);
-	    m_listCtrlTables->SetItem(itemIndex, ++colIndex, hoxUtil::GameTypeToString(it->gameType));
-
-        m_listCtrlTables->SetItem(itemIndex, ++colIndex,
-              hoxUtil::FormatTime(it->initialTime.nGame) + " | " 
-            + hoxUtil::FormatTime(it->initialTime.nMove) + " | " 
-            + hoxUtil::FormatTime(it->initialTime.nFree));
-
-	    m_listCtrlTables->SetItem(itemIndex, ++colIndex, redInfo );
-	    m_listCtrlTables->SetItem(itemIndex, ++colIndex, blackInfo );
+    m_listCtrlTables->SetItemCount( (long) m_tableIds.size() );
 
-	    ++itemIndex;
-    }
-
-	/* Set the columns' width. */
+	/* Set the columns' width.
+     * NOTE: A virtual list cannot be sized to its content.
+     */
 
     for ( colIndex = 0; colIndex < nColums; ++colIndex )
     {
         m_listCtrlTables->SetColumnWidth( colIndex, wxLIST_AUTOSIZE_USEHEADER );
     }
-    if ( m_listCtrlTables->GetItemCount() > 0 )
-    {
-        for ( colIndex = 2; colIndex < nColums; ++colIndex )
-        {
-            m_listCtrlTables->SetColumnWidth( colIndex, wxLIST_AUTOSIZE );
-        }
-    }
+    m_listCtrlTables->SetColumnWidth( 3, 150 );  // Timer
+    m_listCtrlTables->SetColumnWidth( 4, 120 );  // Red Player
+    m_listCtrlTables->SetColumnWidth( 5, 120 );  // Black Player
 
     /* Select the 1st table, if any. */
 
@@ -148,8 +194,8 @@ hoxTablesDialog::hoxTablesDialog( wxWindow*                      parent,
         m_listCtrlTables->SetItemState(0, wxLIST_STATE_SELECTED, wxLIST_STATE_SELECTED );
     }
 
-	/* Sort the list. */
-    m_listCtrlTables->SortItems( _CompareTablesCallBack, 0 /* sortData */ );
+    /* Keep up with the changes of the Tables. */
+    m_tables->SetListener( this );
 
     topSizer->Add( m_listCtrlTables,
 		           wxSizerFlags(1).Expand().Border(wxALL, 10));
@@ -205,8 +251,7 @@ hoxTablesDialog::OnButtonJoin( wxCommandEvent& event )
 		return;
 	}
 
-	const long selectedId = m_listCtrlTables->GetItemData( selectedIndex );
-	m_selectId.Printf("%ld", selectedId);
+	m_selectId = m_tableIds[selectedIndex];
 
     _OnDialogClosed( COMMAND_ID_JOIN );
 }
@@ -232,6 +277,7 @@ hoxTablesDialog::OnButtonClose( wxCommandEvent& event )
      *       (to trigger the 'Close' handler).
      */
 
+    _StopListening();
     _SaveDefaultLayout( this->GetPosition(), this->GetSize() );
     event.Skip(); // Let the search for the event handler should continue.
 }
@@ -249,9 +295,104 @@ hoxTablesDialog::OnListItemDClick( wxListEvent& event )
     this->OnButtonJoin( DUMMY_event );
 }
 
+void
+hoxTablesDialog::OnTableChanged( hoxTableRegistry::ChangeType changeType,
+                                 const hoxNetworkTableInfo&   tableInfo )
+{
+    if ( changeType == hoxTableRegistry::CHANGE_UPDATE )
+    {
+        const long index = _FindTableIndex( tableInfo.id );
+        if ( index != -1 ) m_listCtrlTables->RefreshItem( index );
+        return;
+    }
+
+    /* Adding or removing a row shifts the rows below it (and the
+     * selection). */
+
+    const wxString sSelectedId = _GetSelectedTableId();
+    TableIdVector::iterator pos = std::lower_bound( m_tableIds.begin(),
+                                                    m_tableIds.end(),
+                                                    tableInfo.id,
+                                                    _IsTableIdLess );
+    const bool bFound = ( pos != m_tableIds.end() && *pos == tableInfo.id );
+    const long index = (long) ( pos - m_tableIds.begin() );
+
+    if ( changeType == hoxTableRegistry::CHANGE_ADD )
+    {
+        if ( bFound ) return;
+        m_tableIds.insert( pos, tableInfo.id );
+    }
+    else // ... CHANGE_REMOVE
+    {
+        if ( ! bFound ) return;
+        m_tableIds.erase( pos );
+    }
+
+    m_listCtrlTables->SetItemCount( (long) m_tableIds.size() );
+    if ( index < (long) m_tableIds.size() )
+    {
+        m_listCtrlTables->RefreshItems( index, (long) m_tableIds.size() - 1 );
+    }
+    _SelectTable( sSelectedId );
+}
+
+long
+hoxTablesDialog::_FindTableIndex( const wxString& tableId ) const
+{
+    TableIdVector::const_iterator pos = std::lower_bound( m_tableIds.begin(),
+                                                          m_tableIds.end(),
+                                                          tableId,
+                                                          _IsTableIdLess );
+    if ( pos == m_tableIds.end() || *pos != tableId ) return -1;
+    return (long) ( pos - m_tableIds.begin() );
+}
+
+wxString
+hoxTablesDialog::_GetSelectedTableId() const
+{
+	const long selectedIndex = m_listCtrlTables->GetNextItem( -1, 
+		                                                      wxLIST_NEXT_ALL,
+                                                              wxLIST_STATE_SELECTED );
+    if ( selectedIndex < 0 || selectedIndex >= (long) m_tableIds.size() )
+    {
+        return "";
+    }
+    return m_tableIds[selectedIndex];
+}
+
+void
+hoxTablesDialog::_SelectTable( const wxString& tableId )
+{
+	const long selectedIndex = m_listCtrlTables->GetNextItem( -1, 
+		                                                      wxLIST_NEXT_ALL,
+                                                              wxLIST_STATE_SELECTED );
+    const long index = _FindTableIndex( tableId );
+    if ( index == selectedIndex ) return;
+
+    if ( selectedIndex != -1 )
+    {
+        m_listCtrlTables->SetItemState( selectedIndex, 0, wxLIST_STATE_SELECTED );
+    }
+    if ( index != -1 )
+    {
+        m_listCtrlTables->SetItemState( index, wxLIST_STATE_SELECTED, wxLIST_STATE_SELECTED );
+    }
+}
+
+void
+hoxTablesDialog::_StopListening()
+{
+    if ( m_tables != NULL )
+    {
+        m_tables->SetListener( NULL );
+        m_tables = NULL;
+    }
+}
+
 void
 hoxTablesDialog::_OnDialogClosed( int rc )
 {
+    _StopListening();
     _SaveDefaultLayout( this->GetPosition(), this->GetSize() );
     EndDialog( rc );
 }
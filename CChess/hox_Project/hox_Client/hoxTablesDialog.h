@@ -29,13 +29,24 @@
 #define __INCLUDED_HOX_TABLES_DIALOG_H__
 
 #include "hoxTypes.h"
+#include "hoxTableRegistry.h"
 #include <wx/listctrl.h>
+#include <vector>
+
+/* Forward declarations */
+class hoxTablesListCtrl;
 
 // ----------------------------------------------------------------------------
 // The Tables-Dialog class
 // ----------------------------------------------------------------------------
 
+/**
+ * The dialog showing the Tables of a Registry.  While it is open, it keeps
+ * up with the changes of the Registry: the rows are updated in place, and
+ * the list is never rebuilt.
+ */
 class hoxTablesDialog : public wxDialog
+                      , public hoxTableRegistry::Listener
 {
 public:
     enum CommandId
@@ -49,7 +60,7 @@ public:
     hoxTablesDialog( wxWindow*                      parent, 
                      wxWindowID                     id, 
                      const wxString&                title,
-                     const hoxNetworkTableInfoList& tableList,
+                     hoxTableRegistry&              tables,
 					 unsigned int                   actionFlags );
 
     void OnButtonJoin(wxCommandEvent& event);
@@ -65,15 +76,32 @@ public:
 
     wxString GetSelectedId() const { return m_selectId; }
 
+    // **** Override the parent's API ****
+    virtual void OnTableChanged( hoxTableRegistry::ChangeType changeType,
+                                 const hoxNetworkTableInfo&   tableInfo );
+
 private:
+    long _FindTableIndex( const wxString& tableId ) const;
+        /* Returns -1 if the Table is not in the list. */
+
+    wxString _GetSelectedTableId() const;
+    void _SelectTable( const wxString& tableId );
+
+    void _StopListening();
     void _OnDialogClosed( int rc );
 	bool _GetDefaultLayout( wxPoint& position, wxSize& size );
 	void _SaveDefaultLayout( const wxPoint& position, const wxSize& size );
 
 private:
-	wxListCtrl*   m_listCtrlTables;
-    wxString      m_selectId;
-    unsigned int  m_actionFlags;
+    typedef std::vector<wxString> TableIdVector;
+
+    hoxTableRegistry*   m_tables;   // NULL once the dialog is closed.
+    TableIdVector       m_tableIds;
+            /* The Ids of the rows, sorted by Table-Id. */
+
+	hoxTablesListCtrl*  m_listCtrlTables;
+    wxString            m_selectId;
+    unsigned int        m_actionFlags;
 
     DECLARE_EVENT_TABLE()
 };
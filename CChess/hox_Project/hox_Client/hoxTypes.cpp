@@ -28,6 +28,7 @@
 
 #include "hoxTypes.h"
 #include "hoxUtil.h"
+#include <wx/tokenzr.h>
 
 // ----------------------------------------------------------------------------
 // hoxPosition
@@ -65,6 +66,82 @@ hoxPosition::IsInsideCountry(hoxColor color) const
     else  /* Red? */             return (y >= 5 && y <= 9);
 }
 
+// ----------------------------------------------------------------------------
+// hoxMoveHistory
+// ----------------------------------------------------------------------------
+
+void
+hoxMoveHistory::Append( const hoxPosition& from,
+                        const hoxPosition& to,
+                        unsigned char      flags /* = MOVE_FLAG_NONE */ )
+{
+    m_moves.push_back( (unsigned short) ( ( 9 * from.y + from.x ) << 8
+                                        | ( 9 * to.y + to.x ) ) );
+    m_flags.push_back( flags );
+}
+
+void
+hoxMoveHistory::Append( const hoxMove& move,
+                        unsigned char  flags /* = MOVE_FLAG_NONE */ )
+{
+    if ( move.IsAPieceCaptured() ) flags |= MOVE_FLAG_CAPTURE;
+    this->Append( move.piece.position, move.newPosition, flags );
+}
+
+bool
+hoxMoveHistory::AppendString( const wxString& sMove )
+{
+    /* NOTE: Move-string has the format of "xyXY" */
+
+    if ( sMove.size() != 4 )
+        return false;
+
+    const hoxPosition from( sMove[0] - '0', sMove[1] - '0' );
+    const hoxPosition to( sMove[2] - '0', sMove[3] - '0' );
+    if ( ! from.IsValid() || ! to.IsValid() )
+        return false;
+
+    this->Append( from, to );
+    return true;
+}
+
+bool
+hoxMoveHistory::AppendStrings( const wxString& sMoves,
+                               const wxString& delims )
+{
+    bool bValid = true;
+    wxStringTokenizer tkz( sMoves, delims, wxTOKEN_STRTOK ); // No empty tokens
+    while ( tkz.HasMoreTokens() )
+    {
+        if ( ! this->AppendString( tkz.GetNextToken() ) )
+            bValid = false;  // Skip it, and keep going.
+    }
+    return bValid;
+}
+
+const wxString
+hoxMoveHistory::ToString( size_t index ) const
+{
+    const hoxPosition from = GetFrom( index );
+    const hoxPosition to   = GetTo( index );
+
+    wxString sMove;
+    sMove.Printf("%d%d%d%d", from.x, from.y, to.x, to.y);
+    return sMove;
+}
+
+const wxString
+hoxMoveHistory::ToString( const wxString& delim ) const
+{
+    wxString sMoves;
+    for ( size_t i = 0; i < m_moves.size(); ++i )
+    {
+        if ( i > 0 ) sMoves += delim;
+        sMoves += this->ToString( i );
+    }
+    return sMoves;
+}
+
 // ----------------------------------------------------------------------------
 // hoxRequest
 // ----------------------------------------------------------------------------
@@ -182,9 +182,83 @@ class hoxMove
     }
 };
 
-typedef std::list<hoxMove>    hoxMoveList;
 typedef std::vector<hoxMove>  hoxMoveVector;
 
+/**
+ * The (past) Moves of a game, in a contiguous array of 16 bits per Move:
+ * the FROM square in the high byte and the TO square in the low byte,
+ * each as (9 * y + x).  This is the binary form of the AI Engines
+ * (AIMove).  Whether a Move captured a Piece or checked the other King
+ * is kept alongside, as flags.
+ *
+ * The Moves are turned into strings ("xyXY") only when they are sent
+ * over the network or saved to disk.
+ */
+class hoxMoveHistory
+{
+public:
+    enum MoveFlag
+    {
+        MOVE_FLAG_NONE    = 0x00,
+        MOVE_FLAG_CAPTURE = 0x01   // A Piece was captured.
+    };
+
+    hoxMoveHistory() {}
+
+    void Append( const hoxPosition& from,
+                 const hoxPosition& to,
+                 unsigned char      flags = MOVE_FLAG_NONE );
+
+    /**
+     * Append a Move, with the flag of its captured Piece (if any).
+     */
+    void Append( const hoxMove& move,
+                 unsigned char  flags = MOVE_FLAG_NONE );
+
+    /**
+     * Append a Move from its string ("xyXY").
+     * @return false if the string is not a valid Move.
+     */
+    bool AppendString( const wxString& sMove );
+
+    /**
+     * Append the Moves of a string separated by a delimiter
+     * (e.g., "7747/1242").
+     * @return false if one of them is not valid (it is skipped, and the
+     *         others are still appended).
+     */
+    bool AppendStrings( const wxString& sMoves,
+                        const wxString& delims );
+
+    size_t size() const  { return m_moves.size(); }
+    bool   empty() const { return m_moves.empty(); }
+    void   clear()       { m_moves.clear(); m_flags.clear(); }
+
+    unsigned short GetBinary( size_t index ) const { return m_moves[index]; }
+
+    hoxPosition GetFrom( size_t index ) const
+        { return _SquareToPosition( m_moves[index] >> 8 ); }
+    hoxPosition GetTo( size_t index ) const
+        { return _SquareToPosition( m_moves[index] & 0xFF ); }
+    bool IsCapture( size_t index ) const
+        { return ( m_flags[index] & MOVE_FLAG_CAPTURE ) != 0; }
+
+    const wxString ToString( size_t index ) const;
+
+    /**
+     * All the Moves as one string, separated by a delimiter.
+     */
+    const wxString ToString( const wxString& delim ) const;
+
+private:
+    static hoxPosition _SquareToPosition( int square )
+        { return hoxPosition( square % 9, square / 9 ); }
+
+private:
+    std::vector<unsigned short> m_moves;
+    std::vector<unsigned char>  m_flags;
+};
+
 /**
  * Game's Time-info.
  */
@@ -200,6 +274,9 @@ class hoxTimeInfo
 	void Clear() { nGame = nMove = nFree = 0; }
     bool IsEmpty() const 
         { return (nGame == 0) && (nMove == 0) && (nFree == 0); }
+    bool operator==( const hoxTimeInfo& other ) const
+        { return    nGame == other.nGame && nMove == other.nMove
+                 && nFree == other.nFree; }
 };
 
 /**
@@ -225,6 +302,22 @@ class hoxNetworkTableInfo
 
     bool IsValid() const { return !id.empty(); }
 
+    bool operator==( const hoxNetworkTableInfo& other ) const
+        {
+            return    id          == other.id
+                   && group       == other.group
+                   && redId       == other.redId
+                   && blackId     == other.blackId
+                   && redScore    == other.redScore
+                   && blackScore  == other.blackScore
+                   && initialTime == other.initialTime
+                   && blackTime   == other.blackTime
+                   && redTime     == other.redTime
+                   && gameType    == other.gameType;
+        }
+    bool operator!=( const hoxNetworkTableInfo& other ) const
+        { return !( *this == other ); }
+
     void Clear()
 		{
 			id         = "";
@@ -27,6 +27,7 @@
 
 #include "hoxUtil.h"
 #include "hoxReferee.h"
+#include "../plugins/common/AIEngineLib.h"
 #include <wx/tokenzr.h>
 #include <wx/textfile.h>
 #include <wx/stdpaths.h>
@@ -286,6 +287,7 @@ hoxUtil::RequestTypeToString( const hoxRequestType requestType )
         case hoxREQUEST_MSG:           return "MSG";
 
         case hoxREQUEST_AI_LEVEL:      return "AI_LEVEL";
+        case hoxREQUEST_AI_OPTION:     return "AI_OPTION";
 
         default:                       return "UNKNOWN";
     }
@@ -321,6 +323,7 @@ hoxUtil::StringToRequestType( const wxString& input )
     if ( input == "MSG" )           return hoxREQUEST_MSG;
 
     if ( input == "AI_LEVEL" )      return hoxREQUEST_AI_LEVEL;
+    if ( input == "AI_OPTION" )     return hoxREQUEST_AI_OPTION;
 
     return hoxREQUEST_UNKNOWN;
 }
@@ -588,6 +591,41 @@ hoxUtil::hoxGameStateToFEN( const hoxGameState& gameState )
     return fen;
 }
 
+void
+hoxUtil::hoxGameStateToAIPosition( const hoxGameState& gameState,
+                                   AIPosition&         position )
+{
+    for ( int i = 0; i < 90; ++i )
+    {
+        position.squares[i] = 0;
+    }
+
+    const hoxPieceInfoList& pieces = gameState.pieceList;
+    char cPiece = 0;
+    for ( hoxPieceInfoList::const_iterator it = pieces.begin();
+                                           it != pieces.end(); ++it )
+    {
+        switch ( it->type )
+        {
+            case hoxPIECE_KING:     cPiece = 'K'; break;
+            case hoxPIECE_ADVISOR:  cPiece = 'A'; break;
+            case hoxPIECE_ELEPHANT: cPiece = 'E'; break;
+            case hoxPIECE_CHARIOT:  cPiece = 'R'; break;
+            case hoxPIECE_HORSE:    cPiece = 'H'; break;
+            case hoxPIECE_CANNON:   cPiece = 'C'; break;
+            case hoxPIECE_PAWN:     cPiece = 'P'; break;
+            default: continue; /* skip */
+        }
+
+        // Convert lowercase if the color is BLACK (or BLUE).
+        if ( it->color == hoxCOLOR_BLACK ) { cPiece += 'a' - 'A'; }
+
+        position.squares[(it->position.y * 9) + it->position.x] = cPiece;
+    }
+
+    position.side = ( gameState.nextColor == hoxCOLOR_RED ? 'w' : 'b' );
+}
+
 wxString 
 hoxUtil::EscapeURL( const wxString& value )
 {
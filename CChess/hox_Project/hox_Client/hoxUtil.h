@@ -32,6 +32,9 @@
 #include <wx/image.h>
 #include "hoxTypes.h"
 
+/* Forward declaration */
+struct AIPosition;
+
 namespace hoxUtil
 {
     /**
@@ -171,6 +174,12 @@ namespace hoxUtil
      */
     const std::string hoxGameStateToFEN( const hoxGameState& gameState );
 
+    /**
+     * The same as above but to the binary position of the AI Plugins.
+     */
+    void hoxGameStateToAIPosition( const hoxGameState& gameState,
+                                   AIPosition&         position );
+
     /**
      * A helper to escape invalid characters:
      *  + Percent    ("%") => "%25"
@@ -26,14 +26,20 @@
 #include <AIEngineLib.h>
 #include <DefaultDelete.h>
 #include <memory>
+#include <sstream>
+#include <cstdlib>
 #include "engine.h"
 #include "folHOXEngine.h"
 
+/* Size of the engine's hash table (the default of "Hash"). */
+static const int HASH_SIZE_MB = 32;
+
 class AIEngineImpl : public DefaultDelete<AIEngineLib>
 {
 public:
     AIEngineImpl( const char* engineName )
         : m_name( engineName ? engineName : "__UNKNOWN__" )
+        , m_hashSizeMB( HASH_SIZE_MB )
     {
     }
 
@@ -50,6 +56,8 @@ public:
     {
         const int nDepth = ( nAILevel < 1 ? 3 : nAILevel );
         m_engine.reset( new folHOXEngine( nDepth ) );
+        m_engine->SetHashSize( m_hashSizeMB );
+        m_engine->SetListener( m_progress.listener ? &m_progress : NULL );
     }
 
   	int initGame( const std::string& fen,
@@ -78,6 +86,68 @@ public:
         m_engine->OnHumanMove( sMove );
     }
 
+    int initGameBinary( const AIPosition* position,
+                        const AIMove*     moves,
+                        int               nMoves )
+    {
+        if ( m_engine.get() == NULL ) return hoxAI_RC_ERR;
+
+        m_engine->InitGame( "" /* fen */ );
+
+        for ( int i = 0; i < nMoves; ++i )
+        {
+            m_engine->OnHumanMoveBinary( moves[i] );
+        }
+
+        return hoxAI_RC_OK;
+    }
+
+    AIMove generateMoveBinary()
+    {
+        return (AIMove) m_engine->GenerateMoveBinary();
+    }
+
+    void onHumanMoveBinary( AIMove move )
+    {
+        m_engine->OnHumanMoveBinary( move );
+    }
+
+    int getSearchInfo( AISearchInfo& info )
+    {
+        if ( m_engine.get() == NULL ) return hoxAI_RC_ERR;
+
+        folHOXEngine::SearchInfo search;
+        m_engine->GetSearchInfo( search );
+        info.depth       = search.depth;
+        info.nodes       = search.nodes;
+        info.hashProbes  = search.hashProbes;
+        info.hashHits    = search.hashHits;
+        info.hashCutoffs = search.hashCuts;
+        info.betaCutoffs = search.betaCuts;
+        info.nullCutoffs = search.nullCuts;
+        return hoxAI_RC_OK;
+    }
+
+    int benchSearch( int           depth,
+                     AIMove&       move,
+                     AISearchInfo& info )
+    {
+        if ( m_engine.get() == NULL ) return hoxAI_RC_ERR;
+
+        move = (AIMove) m_engine->BenchSearchBinary( depth );
+        return getSearchInfo( info );
+    }
+
+    int setSearchListener( AISearchListener* listener )
+    {
+        m_progress.listener = listener;
+        if ( m_engine.get() != NULL )
+        {
+            m_engine->SetListener( listener ? &m_progress : NULL );
+        }
+        return hoxAI_RC_OK;
+    }
+
     int setDifficultyLevel( int nAILevel )
     {
         int searchDepth = 1;
@@ -99,11 +169,57 @@ public:
                "folium.googlecode.com";
     }
 
+    int listOptions( AIOptionList& options )
+    {
+        std::ostringstream ostr;
+        ostr << m_hashSizeMB;
+        options.push_back( AIOption( "Hash", AIOption::AI_OPTION_SPIN,
+                                     ostr.str(), 1, 1024 ) );
+        return hoxAI_RC_OK;
+    }
+
+    int setOption( const std::string& name,
+                   const std::string& value )
+    {
+        if ( name != "Hash" ) return hoxAI_RC_NOT_FOUND;
+
+        const int nMegabytes = ::atoi( value.c_str() );
+        if ( nMegabytes < 1 || nMegabytes > 1024 ) return hoxAI_RC_ERR;
+
+        m_hashSizeMB = nMegabytes;
+        if ( m_engine.get() ) m_engine->SetHashSize( m_hashSizeMB );
+        return hoxAI_RC_OK;
+    }
+
+private:
+    /* Passes the iterations of the engine on to the client's listener. */
+    class ProgressAdapter : public folHOXEngine::Listener
+    {
+    public:
+        ProgressAdapter() : listener( NULL ) {}
+        void OnIteration( int depth, int score, unsigned int nodes,
+                          int msecs, unsigned int move )
+        {
+            AISearchProgress info;
+            info.depth    = depth;
+            info.score    = score;
+            info.nodes    = nodes;
+            info.msecs    = (unsigned long) msecs;
+            info.pv[0]    = (AIMove) move;
+            info.pvLength = ( move ? 1 : 0 );
+            listener->onSearchProgress( info );
+        }
+
+        AISearchListener* listener;
+    };
+
 private:
     std::string    m_name;
+    int            m_hashSizeMB;
 
     typedef std::auto_ptr<folHOXEngine>  Engine_APtr;
     Engine_APtr    m_engine;
+    ProgressAdapter m_progress;
 
 }; /* class AIEngineImpl */
 
@@ -11,7 +11,7 @@
 namespace folium
 {
 
-    Engine::Engine():
+    Engine::Engine(uint32 hash_power):
         m_debug(false),
         m_stop(true),
         m_ponder(false),
@@ -19,7 +19,16 @@ namespace folium
         m_starttime(0.0f),
         m_mintime(0.0f),
         m_maxtime(0.0f),
-        m_hash(21)
+        m_hash(hash_power),
+        m_tree_nodes(0),
+        m_leaf_nodes(0),
+        m_quiet_nodes(0),
+        m_hash_probes(0),
+        m_hash_hits(0),
+        m_hash_hit_nodes(0),
+        m_beta_cuts(0),
+        m_null_cuts(0),
+        m_searched_depth(0)
     {
         load("rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR r");
     }
@@ -348,17 +357,22 @@ namespace folium
     }
     uint32 Engine::search(set<uint> ban)
     {
+        m_starttime = now_time();
         m_interrupt = 0;
 
         m_tree_nodes = 0;
         m_leaf_nodes = 0;
         m_quiet_nodes = 0;
+        m_hash_probes = 0;
+        m_hash_hits = 0;
         m_hash_hit_nodes = 0;
+        m_beta_cuts = 0;
         m_hash_move_cuts = 0;
         m_kill_cuts_1 = 0;
         m_kill_cuts_2 = 0;
         m_null_nodes = 0;
         m_null_cuts = 0;
+        m_searched_depth = 0;
 
         m_history.clear();
         m_hash.clear();
@@ -415,6 +429,11 @@ namespace folium
                     *itr = 0;
             }
 
+            if (!m_stop)
+            {
+                m_searched_depth = depth;
+                iteration_done(depth, best_value, best_move);
+            }
             if (best_value > MATEVALUE || best_value < -MATEVALUE)
                 break;
             ml.erase(remove(ml.begin(), ml.end(), (uint)0), ml.end());
@@ -18,8 +18,9 @@ namespace folium
     class Engine
     {
     public:
-        Engine();
+        Engine(uint32 hash_power = 21);
         virtual ~Engine() {}
+        void set_hash_power(uint32 power){m_hash.resize(power);}
         void setxq(const XQ&);
         bool load(const string& fen);
         string fen(){return m_xq.get_fen();}
@@ -27,11 +28,21 @@ namespace folium
         virtual bool readable() {return false;};
         virtual string readline(){return string();};
         virtual void writeline(const string& str){};
+        //called by search() after each completed iteration
+        virtual void iteration_done(int depth, int score, uint move){};
 
         bool make_move(uint32 move);
         void unmake_move();
 
         uint32 search(set<uint>);
+        //statistics of the last search
+        uint searched_nodes()const{return m_tree_nodes + m_leaf_nodes + m_quiet_nodes;}
+        int searched_depth()const{return m_searched_depth;}
+        uint hash_probes()const{return m_hash_probes;}
+        uint hash_hits()const{return m_hash_hits;}
+        uint hash_cuts()const{return m_hash_hit_nodes;}
+        uint beta_cuts()const{return m_beta_cuts;}
+        uint null_cuts()const{return m_null_cuts;}
 
         bool m_debug;
         bool m_stop;
@@ -67,12 +78,16 @@ namespace folium
 		uint m_tree_nodes;
 		uint m_leaf_nodes;
 		uint m_quiet_nodes;
+		uint m_hash_probes;
+		uint m_hash_hits;
 		uint m_hash_hit_nodes;
+		uint m_beta_cuts;
 		uint m_hash_move_cuts;
 		uint m_kill_cuts_1;
 		uint m_kill_cuts_2;
 		uint m_null_nodes;
 		uint m_null_cuts;
+		int m_searched_depth;//last completed iteration
 
     };
 
@@ -30,6 +30,35 @@
 #include "folHOXEngine.h"
 #include <sstream>     // ostringstream
 
+/* The binary (HOX) form of a folium move: a folium square is 89 minus the
+ * HOX square. */
+static unsigned int
+_folium2binary( unsigned int move )
+{
+	unsigned int src = 89 - (move & 0x7f);
+	unsigned int dst = 89 - ((move >> 7) & 0x7f);
+	return (src << 8) | dst;
+}
+
+/* The engine, passing its iterations on to the listener of folHOXEngine. */
+class ListenedEngine : public folium::Engine
+{
+public:
+    ListenedEngine( folium::uint32 power, folHOXEngine::Listener* const& listener )
+        : folium::Engine( power ), _listener( listener ) {}
+
+    void iteration_done( int depth, int score, folium::uint move )
+    {
+        if ( _listener == NULL ) return;
+        const int msecs = (int) ( (folium::now_time() - m_starttime) * 1000 );
+        _listener->OnIteration( depth, score, searched_nodes(), msecs,
+                                _folium2binary( move ) );
+    }
+
+private:
+    folHOXEngine::Listener* const&  _listener;  // That of folHOXEngine.
+};
+
 
 // ----------------------------------------------------------------------------
 //
@@ -40,6 +69,8 @@
 folHOXEngine::folHOXEngine( const int searchDepth /* = 3 */ )
         : _engine( NULL )
         , _searchDepth( searchDepth )
+        , _hashPower( 21 )
+        , _listener( NULL )
 {
 }
 
@@ -65,24 +96,18 @@ folHOXEngine::InitGame( const std::string& fen )
     }
 
     delete _engine;
-	_engine = new folium::Engine();
+	_engine = new ListenedEngine( _hashPower, _listener );
 	_engine->load(fenStartPosition);
 }
 
 std::string
 folHOXEngine::GenerateMove()
 {
-	std::set<folium::uint> ban;
-	_engine->m_stop = false;
-	_engine->m_depth = std::max(_searchDepth, 5);
-	_engine->m_mintime = folium::now_time() + 1000;
-	_engine->m_maxtime = folium::now_time() + 3000;
-	unsigned int move = _engine->search( ban );
+	unsigned int move = _Search();
 	std::string sNextMove;
 	if (move)
 	{
 		sNextMove = _folium2hox( move );
-		_engine->make_move(move);
 	}
 	return sNextMove;
 }
@@ -94,6 +119,74 @@ folHOXEngine::OnHumanMove( const std::string& sMove )
 	_engine->make_move(move);
 }
 
+unsigned int
+folHOXEngine::GenerateMoveBinary()
+{
+	unsigned int move = _Search();
+	return move ? _folium2binary( move ) : 0;
+}
+
+void
+folHOXEngine::OnHumanMoveBinary( unsigned int move )
+{
+	unsigned int src = 89 - (move >> 8);
+	unsigned int dst = 89 - (move & 0xff);
+	_engine->make_move( src | (dst << 7) );
+}
+
+void
+folHOXEngine::GetSearchInfo( SearchInfo& info ) const
+{
+	info.depth      = ( _engine ? _engine->searched_depth() : 0 );
+	info.nodes      = ( _engine ? _engine->searched_nodes() : 0 );
+	info.hashProbes = ( _engine ? _engine->hash_probes() : 0 );
+	info.hashHits   = ( _engine ? _engine->hash_hits() : 0 );
+	info.hashCuts   = ( _engine ? _engine->hash_cuts() : 0 );
+	info.betaCuts   = ( _engine ? _engine->beta_cuts() : 0 );
+	info.nullCuts   = ( _engine ? _engine->null_cuts() : 0 );
+}
+
+unsigned int
+folHOXEngine::BenchSearchBinary( int depth )
+{
+	std::set<folium::uint> ban;
+	_engine->m_stop = false;
+	_engine->m_depth = depth + 1;  // The iterations stop before m_depth.
+	_engine->m_mintime = folium::now_time() + 1.0e9;
+	_engine->m_maxtime = folium::now_time() + 1.0e9;
+	unsigned int move = _engine->search( ban );
+	return move ? _folium2binary( move ) : 0;
+}
+
+void
+folHOXEngine::SetHashSize( int megabytes )
+{
+    /* Each of the 2^_hashPower entries takes 16 bytes. */
+    const size_t bytes = (size_t) megabytes << 20;
+    unsigned int power = 10;
+    while ( ((size_t) 16 << (power + 1)) <= bytes ) ++power;
+
+    if ( power == _hashPower ) return;
+    _hashPower = power;
+    if ( _engine ) _engine->set_hash_power( _hashPower );
+}
+
+unsigned int
+folHOXEngine::_Search()
+{
+	std::set<folium::uint> ban;
+	_engine->m_stop = false;
+	_engine->m_depth = std::max(_searchDepth, 5);
+	_engine->m_mintime = folium::now_time() + 1000;
+	_engine->m_maxtime = folium::now_time() + 3000;
+	unsigned int move = _engine->search( ban );
+	if (move)
+	{
+		_engine->make_move(move);
+	}
+	return move;
+}
+
 unsigned int
 folHOXEngine::_hox2folium( const std::string& sMove ) const
 {
@@ -41,10 +41,46 @@ public:
     std::string GenerateMove();
     void OnHumanMove( const std::string& sMove );
 
+    /* The same without strings: a move is (from << 8) | to, where a square
+     * is 9 * row + column in HOX coordinates (0 = no move). */
+    unsigned int GenerateMoveBinary();
+    void OnHumanMoveBinary( unsigned int move );
+
+    /* The statistics of the last search. */
+    struct SearchInfo
+    {
+        int          depth;       // The last completed iteration.
+        unsigned int nodes;
+        unsigned int hashProbes, hashHits, hashCuts;
+        unsigned int betaCuts, nullCuts;
+    };
+    void GetSearchInfo( SearchInfo& info ) const;
+
+    /* Searches to a fixed depth, without time limit, for benchmarks.
+     * Returns the best move (binary form, 0 if none) without playing it. */
+    unsigned int BenchSearchBinary( int depth );
+
+    /* Told about each completed iteration of the searches. */
+    class Listener
+    {
+    public:
+        virtual ~Listener() {}
+        virtual void OnIteration( int depth, int score, unsigned int nodes,
+                                  int msecs, unsigned int move ) = 0;
+                                  /* The best move, in binary form. */
+    };
+    void SetListener( Listener* listener ) { _listener = listener; } // NULL = none
+
     void SetSearchDepth( int searchDepth ) { _searchDepth = searchDepth; }
     int  GetSearchDepth() const { return _searchDepth; }
 
+    /* Sets the size of the hash table, rounded down to a power of 2. */
+    void SetHashSize( int megabytes );
+
 private:
+    unsigned int _Search();
+        /* Searches and plays the best move (0 if none) in folium form. */
+
     unsigned int _hox2folium( const std::string& sMove ) const;
     std::string _folium2hox( unsigned int move ) const;
 
@@ -55,6 +91,8 @@ private:
          */
 
     int              _searchDepth;
+    unsigned int     _hashPower;   // The hash table has 2^_hashPower entries.
+    Listener*        _listener;
 };
 
 #endif /* __INCLUDED_FOL_HOX_ENGINE_H__ */
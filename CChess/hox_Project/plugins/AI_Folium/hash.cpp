@@ -16,6 +16,16 @@ namespace folium
         delete[] m_records[1];
     }
 
+    void HashTable::resize(uint32 power)
+    {
+        delete[] m_records[0];
+        delete[] m_records[1];
+        m_size = 1 << (power -  1);
+        m_mask = m_size - 1;
+        m_records[0] = new Record[m_size];
+        m_records[1] = new Record[m_size];
+    }
+
     void HashTable::clear()
     {
         for (uint i = 0; i < 2; ++i)
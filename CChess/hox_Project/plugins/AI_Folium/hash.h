@@ -154,6 +154,7 @@ namespace folium
         HashTable(uint32 power=22);
         ~HashTable();
         void clear();
+        void resize(uint32 power);
         Record& record(const uint32 &key, uint player);
     private:
         uint32 m_size;
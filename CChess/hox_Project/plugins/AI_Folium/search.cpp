@@ -46,9 +46,12 @@ namespace folium
         }
 
         Record& record = m_hash.record(m_keys[m_ply], m_xq.player());
-        uint32 hash_move;
+        uint32 hash_move = 0;
         {
+            m_hash_probes++;
             int score = record.probe(m_xq, depth, ply, alpha, beta, hash_move, m_locks[m_ply]);
+            if (hash_move)
+                m_hash_hits++;
             if (score != INVAILDVALUE)
             {
                 m_hash_hit_nodes++;
@@ -102,6 +105,7 @@ namespace folium
                 {
                     if (is_stop())
                         return - WINSCORE;
+                    ++m_beta_cuts;
                     m_history.update_history(best_move, depth);
                     record.store_beta(depth, ply, score, best_move, m_locks[m_ply]);
                     if (!is_good_cap(m_xq, best_move))
@@ -29,17 +29,27 @@
 
 #include <AIEngineLib.h>
 #include <DefaultDelete.h>
+#include <sstream>
+#include <cstdlib>
+#include "haqikidHOX.h"
 
-/*
- * External dependencies (defined in 'haqikidHOX.cpp')
- */
+/* Size of the engine's transposition table (the default of "Hash"). */
+static const int HASH_SIZE_MB = 32;
 
-extern void        InitEngine();
-extern void        InitGame();
-extern const char* GenerateNextMove();
-extern void        OnOpponentMove(const char *line);
-extern void        DeInitEngine();
-extern void        SetMaxDepth( int searchDepth );
+/* HaQiKiD's difficulty levels (see AILevel). */
+static const AILevel s_levels[10] = {
+    /* maxDepth   nodes    msecs        level  average */
+    {  1,    25000,    250 },  /*  1      0 ms */
+    {  2,    50000,    250 },  /*  2      0 ms */
+    {  3,   100000,    500 },  /*  3      1 ms */
+    {  4,   200000,   1000 },  /*  4      7 ms */
+    {  5,   400000,   1500 },  /*  5     15 ms */
+    {  6,   700000,   2500 },  /*  6     67 ms */
+    {  8,  1200000,   4000 },  /*  7    559 ms */
+    { 10,  2000000,   6000 },  /*  8   1455 ms */
+    { 12,  3500000,  10000 },  /*  9   3275 ms */
+    { 16,  6000000,  15000 },  /* 10   4830 ms */
+};
 
 /*
  * AI Engine Implementation
@@ -49,13 +59,13 @@ class AIEngineImpl : public DefaultDelete<AIEngineLib>
 {
 public:
     AIEngineImpl(const char* engineName)
+        : m_hashSizeMB( HASH_SIZE_MB )
     {
         m_name = engineName ? engineName : "__UNKNOWN__";
     }
 
     ~AIEngineImpl()
     {
-        DeInitEngine();
     }
 
     void destroy()
@@ -66,7 +76,8 @@ public:
     void initEngine( int nAILevel = 0 )
     {
         setDifficultyLevel( nAILevel == 0 ? 5 : nAILevel );
-        ::InitEngine();
+        m_engine.SetHashSize( m_hashSizeMB );
+        m_engine.InitEngine();
     }
 
   	int initGame( const std::string& fen,
@@ -74,13 +85,13 @@ public:
     {
         //if ( ! fen.empty() ) return hoxAI_RC_NOT_SUPPORTED;
 
-        ::InitGame();
+        m_engine.InitGame();
 
         for ( MoveList::const_iterator it = moves.begin();
                                        it != moves.end(); ++it)
         {
             std::string stdMove = _hoxToMove( *it );
-            ::OnOpponentMove( stdMove.c_str() );
+            m_engine.OnOpponentMove( stdMove.c_str() );
         }
 
         return hoxAI_RC_OK;
@@ -88,25 +99,82 @@ public:
 
 	std::string generateMove()
     {
-        const char* szMove = ::GenerateNextMove();
+        const char* szMove = m_engine.GenerateNextMove();
         return _moveToHox( std::string( szMove ) );
     }
 
     void onHumanMove( const std::string& sMove )
     {
         std::string stdMove = _hoxToMove( sMove );
-        ::OnOpponentMove( stdMove.c_str() );
+        m_engine.OnOpponentMove( stdMove.c_str() );
     }
 
-    int setDifficultyLevel( int nAILevel )
+    int initGameBinary( const AIPosition* position,
+                        const AIMove*     moves,
+                        int               nMoves )
     {
-        int searchDepth = 1;
+        m_engine.InitGame();
 
-        if      ( nAILevel > 10 ) searchDepth = 10;
-        else if ( nAILevel < 1 )  searchDepth = 1;
-        else                      searchDepth = nAILevel;
+        char szMove[5];
+        for ( int i = 0; i < nMoves; ++i )
+        {
+            _binaryToMove( moves[i], szMove );
+            m_engine.OnOpponentMove( szMove );
+        }
 
-        ::SetMaxDepth( searchDepth );
+        return hoxAI_RC_OK;
+    }
+
+    AIMove generateMoveBinary()
+    {
+        return _moveToBinary( m_engine.GenerateNextMove() );
+    }
+
+    void onHumanMoveBinary( AIMove move )
+    {
+        char szMove[5];
+        _binaryToMove( move, szMove );
+        m_engine.OnOpponentMove( szMove );
+    }
+
+    int getSearchInfo( AISearchInfo& info )
+    {
+        HaQiKiD::SearchInfo search;
+        m_engine.GetSearchInfo( search );
+        info.depth       = search.depth;
+        info.nodes       = (unsigned long) search.nodes;
+        info.hashProbes  = (unsigned long) search.hashProbes;
+        info.hashHits    = (unsigned long) search.hashHits;
+        info.hashCutoffs = (unsigned long) search.hashCuts;
+        info.betaCutoffs = (unsigned long) search.betaCuts;
+        info.nullCutoffs = (unsigned long) search.nullCuts;
+        return hoxAI_RC_OK;
+    }
+
+    int benchSearch( int           depth,
+                     AIMove&       move,
+                     AISearchInfo& info )
+    {
+        move = _moveToBinary( m_engine.BenchSearch( depth ) );
+        return getSearchInfo( info );
+    }
+
+    int setSearchListener( AISearchListener* listener )
+    {
+        m_progress.listener = listener;
+        m_engine.SetListener( listener ? &m_progress : NULL );
+        return hoxAI_RC_OK;
+    }
+
+    int setDifficultyLevel( int nAILevel )
+    {
+        if      ( nAILevel > 10 ) nAILevel = 10;
+        else if ( nAILevel < 1 )  nAILevel = 1;
+
+        const AILevel& level = s_levels[nAILevel - 1];
+        m_engine.SetMaxDepth( level.maxDepth );
+        m_engine.SetNodeLimit( level.nodes );
+        m_engine.SetMoveTime( level.msecs );
         return hoxAI_RC_OK;
     }
 
@@ -116,15 +184,68 @@ public:
                "home.hccnet.nl/h.g.muller/XQhaqikid.html";
     }
 
+    int listOptions( AIOptionList& options )
+    {
+        std::ostringstream ostr;
+        ostr << m_hashSizeMB;
+        options.push_back( AIOption( "Hash", AIOption::AI_OPTION_SPIN,
+                                     ostr.str(), 1, 1024 ) );
+        return hoxAI_RC_OK;
+    }
+
+    int setOption( const std::string& name,
+                   const std::string& value )
+    {
+        if ( name != "Hash" ) return hoxAI_RC_NOT_FOUND;
+
+        const int nMegabytes = ::atoi( value.c_str() );
+        if ( nMegabytes < 1 || nMegabytes > 1024 ) return hoxAI_RC_ERR;
+
+        m_hashSizeMB = nMegabytes;
+        m_engine.SetHashSize( m_hashSizeMB );
+        return hoxAI_RC_OK;
+    }
+
 private:
     std::string _hoxToMove( const std::string& sIn );
     std::string _moveToHox( const std::string& sIn );
 
+    /* The same for binary moves (no allocation). */
+    static void   _binaryToMove( AIMove move, char szMove[5] );
+    static AIMove _moveToBinary( const char* szMove );
+
+    /* Passes the progress of the engine on to the client's listener. */
+    class ProgressAdapter : public HaQiKiD::Listener
+    {
+    public:
+        ProgressAdapter() : listener( NULL ) {}
+        void OnProgress( const HaQiKiD::Progress& progress );
+
+        AISearchListener* listener;
+    };
+
 private:
     std::string m_name;
+    HaQiKiD     m_engine;
+    int         m_hashSizeMB;
+    ProgressAdapter m_progress;
 
 }; /* class AIEngineImpl */
 
+void
+AIEngineImpl::ProgressAdapter::OnProgress( const HaQiKiD::Progress& progress )
+{
+    AISearchProgress info;
+    info.depth    = progress.depth;
+    info.score    = progress.score;
+    info.nodes    = (unsigned long) progress.nodes;
+    info.msecs    = (unsigned long) progress.msecs;
+    info.hashFull = progress.hashFull;
+    info.pv[0]    = _moveToBinary( progress.move );
+    info.pvLength = ( info.pv[0] == hoxAI_MOVE_NONE ? 0 : 1 );
+    listener->onSearchProgress( info );
+}
+
 std::string
 AIEngineImpl::_hoxToMove( const std::string& sIn )
 {
@@ -147,6 +268,28 @@ AIEngineImpl::_moveToHox( const std::string& sIn )
     return sMove;
 }
 
+void
+AIEngineImpl::_binaryToMove( AIMove move, char szMove[5] )
+{
+    szMove[0] = 'a' + AIMoveFrom( move ) % 9;
+    szMove[1] = '9' - AIMoveFrom( move ) / 9;
+    szMove[2] = 'a' + AIMoveTo( move ) % 9;
+    szMove[3] = '9' - AIMoveTo( move ) / 9;
+    szMove[4] = '\0';
+}
+
+AIMove
+AIEngineImpl::_moveToBinary( const char* szMove )
+{
+    if (   szMove[0] < 'a' || szMove[0] > 'i' || szMove[1] < '0' || szMove[1] > '9'
+        || szMove[2] < 'a' || szMove[2] > 'i' || szMove[3] < '0' || szMove[3] > '9' )
+    {
+        return hoxAI_MOVE_NONE;
+    }
+    return AIMakeMove( 9 * ('9' - szMove[1]) + (szMove[0] - 'a'),
+                       9 * ('9' - szMove[3]) + (szMove[2] - 'a') );
+}
+
 
 //////////////////////////////////////////////////////////////
 AIEngineLib* CreateAIEngineLib()
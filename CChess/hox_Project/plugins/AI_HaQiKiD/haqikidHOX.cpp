@@ -13,8 +13,6 @@
 #define ALPHABETA
 #define NULLMOVE
 #define KILLERS 2   /* set to 0 or 2 */
-//#define HASH
-#define DEPTHPREF
 #define CHECKEXT
 #define XFUTILITY
 #define REPDRAW
@@ -32,22 +30,7 @@
 #define BLACK 32
 #define COLOR (WHITE|BLACK)
 
-/* Global variables visible to engine. Normally they */
-/* would be replaced by the names under which these  */
-/* are known to your engine, so that they can be     */
-/* manipulated directly by the interface.            */
-
-int Side;
-int Post = 0;           /* set to 1 to see machine thinking printed */
-int MaxDepth  = 60;     /* must be set 2 higher than actual depth!  */
-int MaxTime   = 1200000; /* Time per session, msec                   */
-int MaxMoves  = 40;     /* moves per session; 0 = entire game       */
-int TimeInc   = 0;      /* extra time per move in msec              */
-int TimeLeft;
-int MovesLeft;
-int Randomize = 1;
-int GamePtr;
-int Ticks, tlim, tlim2;
+#include "haqikidHOX.h"
 
 // move stack
 typedef union {
@@ -57,11 +40,9 @@ typedef union {
     } u;
 } MOVE;
 
-MOVE moveStack[51200], gameMove/*, retMove*/;
-int moveSP;
-int path[500];
+// transposition table, sized at run time (see SetHashSize())
+#define HASH_WAYS 4 /* entries per bucket */
 
-#ifdef HASH
 struct _hash {
     int signature;
     short int score;
@@ -69,30 +50,12 @@ struct _hash {
     unsigned char to;
     unsigned char depth;
     unsigned char flags;
-} *hashTable;
-
-int hashMask = (1<<22)-1;
-#endif
-
-int history[256*256];
-
-// repeat stack, storing hash keys of game history
-int repStack[1000];
-int repSP = 1000;
-char repCheck[1000];
-
-// globals that might be used to pass returned values to caller
-MOVE retMove;
-int  retDepth;
-
-// killers
-unsigned int killer[500][2]; // two for each level
-
-// piece list
-char spoiler[48];
+    unsigned char age;  // search that last used the entry
+};
 
-int hashKeyH=729, hashKeyL=89556, stm, difEval, level, revMovCnt, nodeCnt;
-int materialIndex = 1457 + (1457<<16);
+struct _bucket {
+    struct _hash entry[HASH_WAYS];
+};
 
 // move-generator tables
 
@@ -149,11 +112,8 @@ int mval[48] = { // material index value of pieces
 0,81<<16,81<<16,27<<16,27<<16,9<<16,9<<16, 3,3,1,1, 243<<16,243<<16,243<<16,243<<16,243<<16,
 };
 
-char materialTable[1458];
-
-
-// board (14x20 mailbox with 2-wide guard band)
-unsigned char bord[] = {
+// board (14x20 mailbox with 2-wide guard band), copied into each engine
+const unsigned char initialBord[] = {
 48,48,48,48,48,48,48,48,48,48,48,48,48,          0,0,0,0,0,0,0,
 48,48,48,48,48,48,48,48,48,48,48,48,48,          0,0,0,0,0,0,0,
 48,48, 0, 0,25, 0,16,24, 0, 0,18,48,48,          0,0,0,0,0,0,0,
@@ -172,7 +132,7 @@ unsigned char bord[] = {
 
 #define board (bord+42)
 
-unsigned char pos[48] = {
+const unsigned char initialPos[48] = {
 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
 4,23,8,41,47,42,46, 24,5,2,44, 60,62,64,66,68,
 184,180,165,141,147,142,146, 183,164,144,186, 120,122,124,126,128
@@ -369,18 +329,6 @@ unsigned char pst[] = {
   9,  9,  9, 11, 13, 11,  9,  9,  9,  0,    0,  0, 20,  0,  0,  0, 20
 };
 
-int Zob[900]; // Zobrist randoms
-
-#define NULL_ZOB Zob+610
-
-int *Zobrist[] = {
-NULL_ZOB, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-Zob+828, Zob,     Zob,     Zob+200, Zob+200, Zob+400, Zob+400, Zob+718,
-Zob+718, Zob+701, Zob+701, Zob+700, Zob+700, Zob+700, Zob+700, Zob+700,
-Zob+692, Zob+10,  Zob+10,  Zob+210, Zob+210, Zob+410, Zob+410, Zob+582,
-Zob+582, Zob+710, Zob+710, Zob+600, Zob+600, Zob+600, Zob+600, Zob+600
-};
-
 unsigned char *PST[] = {
 pst+610, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 pst+828, pst,     pst,     pst+200, pst+200, pst+400, pst+400, pst+718,
@@ -404,11 +352,130 @@ int comp(const void *x, const void *y)
 {  return *(int*)y-*(int*)x;
 }
 
-int historyComp(const void *x, const void *y)
-{  return history[*(int*)y & 0xFFFF]-history[*(int*)x & 0xFFFF];
+/* Everything the engine changes while it plays. These used to be globals, */
+/* so only one game could be played per process; now every HaQiKiD object  */
+/* has its own.  The instance is zero-filled when created, like globals.   */
+
+struct HaQiKiD::Engine {
+    /* variables that the interface manipulates */
+    int Side;
+    int Post;           /* set to 1 to see machine thinking printed */
+    int MaxDepth;       /* must be set 2 higher than actual depth!  */
+    int MaxTime;        /* Time per session, msec                   */
+    int MaxMoves;       /* moves per session; 0 = entire game       */
+    int TimeInc;        /* extra time per move in msec              */
+    int TimeLeft;
+    int MovesLeft;
+    int Randomize;
+    int GamePtr;
+    int Ticks, tlim, tlim2;
+    int MoveTime;       /* wall-clock cap per move, msec; 0 = none  */
+    int NodeLimit;      /* node budget per move; 0 = none           */
+
+    // move stack
+    MOVE moveStack[51200], gameMove;
+    int moveSP;
+    int path[500];
+
+    // transposition table
+    struct _bucket *hashTable;
+    int hashMask;           // number of buckets - 1
+    int hashSizeMB;         // 0 = no hash table
+    unsigned char hashAge;  // bumped for every search
+
+    int history[256*256];
+
+    // repeat stack, storing hash keys of game history
+    int repStack[1000];
+    int repSP;
+    char repCheck[1000];
+
+    // globals that might be used to pass returned values to caller
+    MOVE retMove;
+    int  retDepth;
+
+    // killers
+    unsigned int killer[500][2]; // two for each level
+
+    // piece list
+    char spoiler[48];
+
+    int hashKeyH, hashKeyL, stm, difEval, level, revMovCnt, nodeCnt;
+    int hashProbes, hashHits, hashCuts, betaCuts, nullCuts; // statistics
+    HaQiKiD::Listener *listener; // told about each iteration; NULL = none
+    int materialIndex;
+
+    char materialTable[1458];
+
+    unsigned char bord[sizeof(initialBord)];
+    unsigned char pos[48];
+
+    int Zob[900];       // Zobrist randoms
+    int *Zobrist[48];   // same layout as PST[]
+
+    int p1, p2, p3, p4;
+    int initDone;
+    unsigned int randSeed;
+    char moveText[5];
+
+    void Setup();
+    int  Random();
+#ifdef HISTORY
+    void SortHistory(MOVE *list, int n);
+#endif
+    void InitMaterial();
+    int  Evaluate(int stm);
+    int  StupidInCheck(int stm, int to);
+    int  Search(int origAlpha, int beta, int lastPly, int PV, int depth);
+    void AllocHash();
+    void InitEngine();
+    void InitGame();
+    void MakeMove();
+    void OnOpponentMove(const char *line);
+    const char *GenerateNextMove();
+    const char *BenchSearch(int depth);
+    void ReportProgress(int depth, int score, MOVE move);
+    void DeInitEngine();
+};
+
+void HaQiKiD::Engine::Setup()
+{
+    int i;
+
+    MaxDepth = 60;
+    MaxTime  = 1200000;
+    MaxMoves = 40;
+    Randomize = 1;
+    hashSizeMB = 32;
+    repSP = 1000;
+    hashKeyH=729; hashKeyL=89556;
+    materialIndex = 1457 + (1457<<16);
+    memcpy(bord, initialBord, sizeof(bord));
+    memcpy(pos, initialPos, sizeof(pos));
+    for(i=0; i<48; i++) Zobrist[i] = PST[i] ? Zob + (PST[i] - pst) : 0;
+    randSeed = 1;
 }
 
-void InitMaterial()
+int HaQiKiD::Engine::Random() // instead of rand(), which all engines would share
+{
+    randSeed = randSeed * 1103515245 + 12345;
+    return (int)(randSeed >> 1);
+}
+
+#ifdef HISTORY
+void HaQiKiD::Engine::SortHistory(MOVE *list, int n)
+{   // insertion sort on history count, best first
+    int i, j;
+    for(i=1; i<n; i++) {
+        MOVE m = list[i];
+        for(j=i; j>0 && history[list[j-1].m & 0xFFFF] < history[m.m & 0xFFFF]; j--)
+            list[j] = list[j-1];
+        list[j] = m;
+    }
+}
+#endif
+
+void HaQiKiD::Engine::InitMaterial()
 {
     int nR, nC, nH, nP, nA, nE, density, total, defenders, attackers, i;
 
@@ -436,8 +503,7 @@ void InitMaterial()
     }
 }
 
-int p1, p2, p3, p4;
-int Evaluate(int stm)
+int HaQiKiD::Engine::Evaluate(int stm)
 {
     int x, y, score=0, penalty;
 
@@ -499,7 +565,7 @@ p2 = score - p1;
          - (p4=materialTable[materialIndex>>(32-stm) & 0xFFFF]);
 }
 
-int StupidInCheck(int stm, int to)
+int HaQiKiD::Engine::StupidInCheck(int stm, int to)
 {   // scan board in all directions, to see if opponent can capture 'to'
     int i, x;
     i=0; x=to;
@@ -574,19 +640,17 @@ int StupidInCheck(int stm, int to)
 }
 
 /* simple alpha-beta search for mailbox + piece list */
-int Search(int origAlpha, int beta, int lastPly, int PV, int depth)
+int HaQiKiD::Engine::Search(int origAlpha, int beta, int lastPly, int PV, int depth)
 {
     int alpha, curEval, curMove, lastMove, bestMove, capts, nonCapts, iterDep;
     int score, i, j, from, to, step, piece, victim, dir, mustSort, firstMove;
     int bestScore, prevScore = -INF, startScore = -INF, ranKey;
     int saveKeyH = hashKeyH, saveKeyL = hashKeyL;
-    int alphaMoves, evalCor, hashMove, inCheck = 0, xking = pos[stm], king;
+    int alphaMoves, evalCor, hashMove = 0, inCheck = 0, xking = pos[stm], king;
     int old50 = revMovCnt;
     int savDifEval = difEval;
-#ifdef HASH
     int origDep = depth;
-    struct _hash *hashEntry;
-#endif
+    struct _hash *hashEntry = NULL;
 #ifdef CASTLE
     char saveRights = castlingRights;
 #endif
@@ -597,7 +661,7 @@ int Search(int origAlpha, int beta, int lastPly, int PV, int depth)
 
     curEval = difEval + (evalCor = Evaluate(stm)) + 3;
     if(depth==1000)
-    {   ranKey = rand();
+    {   ranKey = Random();
         for(i=0;i<256*256;i++)history[i] = 0;
     }
 
@@ -666,39 +730,35 @@ int Search(int origAlpha, int beta, int lastPly, int PV, int depth)
         bestScore = startScore; // stand-pat cutoff or mate-distance pruning
         goto NullCut;
     }
-#ifdef HASH
     // PROBE HASH
-    if(depth >= 0) { 
-        hashEntry = hashTable + (hashKeyL + (stm<<3) & hashMask);
-        if(hashKeyH == hashEntry->signature) { // hash hit
-            if(hashEntry->depth >= depth && (
-               hashEntry->flags & 1 && hashEntry->score >= beta ||
-               hashEntry->flags & 2 && hashEntry->score <= origAlpha) ) {
-                bestScore = hashEntry->score;
-                goto NullCut;
-            }
-            hashMove = hashEntry->to + (hashEntry->from << 8); // get move
-#ifdef DEPTHPREF
-        } else { struct _hash *oldEntry = hashEntry;
-        hashEntry = hashTable + (hashKeyL + (stm<<3) & hashMask ^ 1);
-        if(hashKeyH == hashEntry->signature) { // hash hit
+    // Scores are stored as they are: the delayed-loss bonus applied on return
+    // already makes mate scores relative to the node, not to the root.
+    if(depth >= 0 && hashTable) {
+        struct _hash *bucket = hashTable[hashKeyL + (stm<<3) & hashMask].entry;
+        for(i=0; i<HASH_WAYS; i++)
+            if(hashKeyH == bucket[i].signature) break;
+        hashProbes++;
+        if(i < HASH_WAYS) { // hash hit
+            hashHits++;
+            hashEntry = bucket + i;
+            hashEntry->age = hashAge;
             if(hashEntry->depth >= depth && (
                hashEntry->flags & 1 && hashEntry->score >= beta ||
                hashEntry->flags & 2 && hashEntry->score <= origAlpha) ) {
                 bestScore = hashEntry->score;
+                hashCuts++;
                 goto NullCut;
             }
             hashMove = hashEntry->to + (hashEntry->from << 8); // get move
         } else {
-            if(hashEntry->depth >= oldEntry->depth) // replace lowest draft
-                hashEntry = oldEntry;
-            hashMove = 0;
-        }}
-#else
-        } else hashMove = 0;
-#endif
+            // replace entry left by an earlier search, else lowest draft
+            hashEntry = bucket;
+            for(i=1; i<HASH_WAYS; i++)
+                if(bucket[i].depth + 256*(bucket[i].age == hashAge) <
+                   hashEntry->depth + 256*(hashEntry->age == hashAge))
+                    hashEntry = bucket + i;
+        }
     }
-#endif
     // CHECK LEGALITY
     if(captCode[xking-to+188] & 0xF) { // orthogonal
         // test for King capture by mover-activated Cannon
@@ -746,6 +806,7 @@ int Search(int origAlpha, int beta, int lastPly, int PV, int depth)
 
         if(score >= beta) {
                 bestScore = beta;
+                nullCuts++;
                 goto NullCut; // skip hash store
         }
 #ifdef THREAT
@@ -800,7 +861,6 @@ int Search(int origAlpha, int beta, int lastPly, int PV, int depth)
         }
     }
     mustSort = KILLERS+1; // indicate that we yet have to sort the moves
-#ifdef HASH
     if(hashMove) {
         for(i=capts; i<lastMove; i++) {
             if(moveStack[i].u.to   == (hashMove&0xFF) &&
@@ -815,7 +875,6 @@ int Search(int origAlpha, int beta, int lastPly, int PV, int depth)
             }
         }
     }
-#endif
     alphaMoves = capts;
 
 if(depth<=0) {
@@ -871,7 +930,7 @@ if(depth<=0) {
 #endif
                     if(mustSort == 1) { // extract positionally good nonCapts
 #ifdef HISTORY
-                       qsort(moveStack + curMove, lastMove-curMove, sizeof(int), historyComp);
+                       SortHistory(moveStack + curMove, lastMove-curMove);
 #else
                        unsigned int best = moveStack[curMove].m;
                        int j = curMove;
@@ -1007,19 +1066,22 @@ if(depth<=0) {
                         }
 #endif
                         history[moveStack[curMove].m & 0xFFFF] += iterDep*iterDep;
+                        betaCuts++;
                         goto Cutoff;
                     }
 #endif
                     alpha = score;
                 }
             }
-            if(depth>=1000 && GetTickCount()-Ticks > tlim2
+            if(depth>=1000 && (GetTickCount()-Ticks > tlim2
+                               || (NodeLimit && nodeCnt >= NodeLimit))
                            && bestScore > prevScore-7) break;
             // next move
             firstMove = 0;
         }
 
         if(depth>=1000) {
+            retDepth = iterDep;
             Evaluate(stm);
             if(Post) printf("%2d %6d %6d %10d %c%c%c%c {%d,%d(%d,%d,%d,%d)%x}\n",iterDep, 4*bestScore,
                 (GetTickCount()-Ticks)/10, nodeCnt,
@@ -1027,9 +1089,11 @@ if(depth<=0) {
                 'a'+moveStack[bestMove].u.to%20, '0'+moveStack[bestMove].u.to/20,
                 curEval, evalCor,p1,p2,p3,p4,materialIndex
                 ); fflush(stdout);
+            if(listener) ReportProgress(iterDep, 4*bestScore, moveStack[bestMove]);
             if(GetTickCount()-Ticks > tlim || iterDep >= MaxDepth ||
+                (NodeLimit && 2*nodeCnt >= NodeLimit) ||
                 iterDep >= 2*(INF-bestScore)-1 || iterDep >= 2*(bestScore+INF)) {
-                // in root, stop deepening if time (or depth) used up
+                // in root, stop deepening if time (or depth, nodes) used up
                 gameMove = moveStack[bestMove]; // return best move
                 difEval  = savDifEval; // make sure we leave globals unchanged
                 hashKeyH = saveKeyH; hashKeyL = saveKeyL;
@@ -1054,9 +1118,8 @@ if(depth<=0) {
 #endif
 
       Cutoff:
-#ifdef HASH
         // HASH STORE
-        if(origDep >= 1) {
+        if(origDep >= 1 && hashEntry) {
             hashEntry->signature = saveKeyH;
             hashEntry->from = moveStack[bestMove].u.from;
             hashEntry->to   = moveStack[bestMove].u.to;
@@ -1068,8 +1131,8 @@ if(depth<=0) {
             hashEntry->score = bestScore;
             hashEntry->flags = (bestScore > origAlpha) // is lower bound
                              + 2*(bestScore < beta);   // is upper bound
+            hashEntry->age = hashAge;
         }
-#endif
         if(iterDep<depth-1 && depth < 1000 && !PV) iterDep = depth-1;
     }
 
@@ -1102,24 +1165,31 @@ if(depth<=0) {
 /* define this to the codes used in your engine,     */
 /* if the engine hasn't defined it already.          */
 
-int initDone = 0;
+void HaQiKiD::Engine::AllocHash()
+{
+ size_t bytes = (size_t)hashSizeMB << 20, n = 1;
 
-void InitEngine()
+ free(hashTable); hashTable = NULL; hashMask = 0;
+ if(hashSizeMB <= 0) return;
+ while(2*n*sizeof(struct _bucket) <= bytes) n *= 2; // power of 2 buckets
+ hashTable = (struct _bucket *) calloc(n, sizeof(struct _bucket));
+ if(hashTable) hashMask = n - 1;
+}
+
+void HaQiKiD::Engine::InitEngine()
 {
  int i, j;
 
-#ifdef HASH
- hashTable = (struct _hash *) calloc(hashMask+1, sizeof(struct _hash));
-#endif
- for(j=0; j<50; j++) rand();
+ AllocHash();
+ for(j=0; j<50; j++) Random();
  for(j=0; j<900; j++)
-     Zob[j] = rand() + rand()/100 + rand()*193 + rand()*138753;
+     Zob[j] = Random() + Random()/100 + Random()*193 + Random()*138753;
  for(i=0; i<200; i+=20) for(j=0; j<10; j++)
      Zob[i + j + 610] = 0;
  InitMaterial(); initDone = 1;
 }
 
-void InitGame()
+void HaQiKiD::Engine::InitGame()
 {
  int i,j; static char array[] = { 1,5,9,7,0,8,10,6,2 };
 
@@ -1143,14 +1213,13 @@ void InitGame()
  repSP = 1000;
  hashKeyH=729; hashKeyL=89556; // just some non-zero values;
  materialIndex = 1457 + (1457<<16);
- srand(GetTickCount());
-#ifdef HASH
- for(i=0; i<=hashMask; i++) hashTable[i].signature = 0;
-#endif
+ randSeed = GetTickCount();
+ if(hashTable) memset(hashTable, 0, (hashMask+1)*sizeof(struct _bucket));
+ hashAge = 0;
  MovesLeft = MaxMoves; TimeLeft = MaxTime; /* initialize time control */
 }
 
-void MakeMove()
+void HaQiKiD::Engine::MakeMove()
 {
         difEval = -difEval - PST[board[gameMove.u.to]][gameMove.u.to]
               - PST[board[gameMove.u.from]][gameMove.u.to]
@@ -1172,7 +1241,7 @@ void MakeMove()
         Side ^= COLOR; GamePtr++;
 }
 
-void OnOpponentMove(const char *line)
+void HaQiKiD::Engine::OnOpponentMove(const char *line)
 {
     int m;
 
@@ -1187,9 +1256,8 @@ void OnOpponentMove(const char *line)
     else MakeMove();  /* legal move, perform it */
 }
 
-const char *GenerateNextMove()
+const char *HaQiKiD::Engine::GenerateNextMove()
 {
- static char move[5];
  int m;
 
     /* determine time to sepend on next move */
@@ -1198,14 +1266,19 @@ const char *GenerateNextMove()
     tlim = 0.5*(TimeLeft+(m-1)*TimeInc)/(m+7);
     if(10*tlim > TimeLeft) tlim = TimeLeft/10;
     tlim2 = 2*tlim;
+    if(MoveTime > 0 && tlim2 > MoveTime) {
+        /* no new iteration after half of the cap, none continued after it */
+        tlim = MoveTime/2; tlim2 = MoveTime;
+    }
 
     /* now call the AI */
-    nodeCnt=0;
+    nodeCnt=0; retDepth=0; hashAge++;
+    hashProbes=hashHits=hashCuts=betaCuts=nullCuts=0;
     stm = Side ^ COLOR;
     if (Search(-INF, INF, gameMove.m, 0, 1000) > 1-INF) {
         MakeMove(); // perform the move it came up with
 
-        sprintf(move, "%c%c%c%c",
+        sprintf(moveText, "%c%c%c%c",
           'a'+gameMove.u.from%20, '0'+gameMove.u.from/20,
           'a'+gameMove.u.to  %20, '0'+gameMove.u.to/20);
 
@@ -1224,7 +1297,7 @@ const char *GenerateNextMove()
     } else {
             printf("resign\n"); // no move, we must be mated
     }
-    return move;
+    return moveText;
 }
 
 /*****************************************************************************/
@@ -1234,22 +1307,141 @@ const char *GenerateNextMove()
 //       Huy Phan 's changes                   //
 /////////////////////////////////////////////////
 
-void DeInitEngine()
+/* Search to a fixed depth for the benchmark: no time or node limit, no */
+/* randomization, and the move is only returned, not performed.         */
+const char *HaQiKiD::Engine::BenchSearch(int depth)
+{
+    const int saveDepth = MaxDepth, saveTime = MoveTime, saveNodes = NodeLimit;
+    const int saveRandom = Randomize;
+
+    MaxDepth = depth; MoveTime = 0; NodeLimit = 0; Randomize = 0;
+    Ticks = GetTickCount();
+    tlim = tlim2 = 0x7FFFFFFF;
+
+    nodeCnt=0; retDepth=0; hashAge++;
+    hashProbes=hashHits=hashCuts=betaCuts=nullCuts=0;
+    stm = Side ^ COLOR;
+    if (Search(-INF, INF, gameMove.m, 0, 1000) > 1-INF) {
+        sprintf(moveText, "%c%c%c%c",
+          'a'+gameMove.u.from%20, '0'+gameMove.u.from/20,
+          'a'+gameMove.u.to  %20, '0'+gameMove.u.to/20);
+    } else {
+        moveText[0] = '\0'; // no move, we are mated
+    }
+
+    MaxDepth = saveDepth; MoveTime = saveTime; NodeLimit = saveNodes;
+    Randomize = saveRandom;
+    return moveText;
+}
+
+/* Tell the listener about an iteration.  The use of the hash table is */
+/* sampled from its first 250 buckets.                                 */
+void HaQiKiD::Engine::ReportProgress(int depth, int score, MOVE move)
+{
+    HaQiKiD::Progress progress;
+    int i, j, n = 0, used = 0;
+
+    progress.depth = depth; progress.score = score;
+    progress.nodes = nodeCnt; progress.msecs = GetTickCount() - Ticks;
+    for(i = 0; hashTable && i < 250 && i <= hashMask; i++)
+        for(j = 0; j < HASH_WAYS; j++, n++)
+            used += (hashTable[i].entry[j].age == hashAge);
+    progress.hashFull = n ? 1000*used/n : 0;
+    sprintf(progress.move, "%c%c%c%c",
+      'a'+move.u.from%20, '0'+move.u.from/20,
+      'a'+move.u.to  %20, '0'+move.u.to/20);
+    listener->OnProgress(progress);
+}
+
+void HaQiKiD::Engine::DeInitEngine()
 {
     if ( initDone )
     {
-#ifdef HASH
-        free(hashTable);
-#endif
+        free(hashTable); hashTable = NULL;
         initDone = 0;
     }
 }
 
-void SetMaxDepth( int searchDepth )
+///////////////// END of Huy Phan's changes //////////////////////////////////
+
+/*****************************************************************************/
+/* HaQiKiD: the public interface, one engine per object.                     */
+/*****************************************************************************/
+
+HaQiKiD::HaQiKiD()
+    : m_engine( new Engine() )  // '()' zero-fills the engine
 {
-    MaxDepth = searchDepth;
+    m_engine->Setup();
 }
 
-///////////////// END of Huy Phan's changes //////////////////////////////////
+HaQiKiD::~HaQiKiD()
+{
+    m_engine->DeInitEngine();
+    delete m_engine;
+}
+
+void HaQiKiD::InitEngine()
+{
+    m_engine->InitEngine();
+}
+
+void HaQiKiD::InitGame()
+{
+    m_engine->InitGame();
+}
+
+const char* HaQiKiD::GenerateNextMove()
+{
+    return m_engine->GenerateNextMove();
+}
+
+void HaQiKiD::OnOpponentMove( const char *line )
+{
+    m_engine->OnOpponentMove( line );
+}
+
+const char* HaQiKiD::BenchSearch( int depth )
+{
+    return m_engine->BenchSearch( depth );
+}
+
+void HaQiKiD::GetSearchInfo( SearchInfo& info ) const
+{
+    info.depth      = m_engine->retDepth;
+    info.nodes      = m_engine->nodeCnt;
+    info.hashProbes = m_engine->hashProbes;
+    info.hashHits   = m_engine->hashHits;
+    info.hashCuts   = m_engine->hashCuts;
+    info.betaCuts   = m_engine->betaCuts;
+    info.nullCuts   = m_engine->nullCuts;
+}
+
+void HaQiKiD::SetListener( Listener* listener )
+{
+    m_engine->listener = listener;
+}
+
+void HaQiKiD::SetMaxDepth( int searchDepth )
+{
+    m_engine->MaxDepth = searchDepth;
+}
+
+void HaQiKiD::SetMoveTime( int milliseconds )
+{
+    m_engine->MoveTime = milliseconds;
+}
+
+void HaQiKiD::SetNodeLimit( int nodes )
+{
+    m_engine->NodeLimit = nodes;
+}
+
+void HaQiKiD::SetHashSize( int megabytes )
+{
+    Engine* e = m_engine;
+    if ( megabytes == e->hashSizeMB && (e->hashTable || megabytes <= 0) ) return;
+    e->hashSizeMB = megabytes;
+    if ( e->initDone ) e->AllocHash();
+}
 
 /************************* END OF FILE ***************************************/
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         * 
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+#ifndef __INCLUDED_HAQIKID_HOX_H__
+#define __INCLUDED_HAQIKID_HOX_H__
+
+/**
+ * The HaQiKi D engine (see 'haqikidHOX.cpp').
+ *
+ * Each object is a complete engine with its own board, move stack and
+ * hash table, so several games can be played at the same time (on
+ * different threads).  A single object is not thread-safe.
+ */
+class HaQiKiD
+{
+public:
+    struct SearchInfo  // of the last search
+    {
+        int depth;     // the last completed iteration
+        int nodes;
+        int hashProbes, hashHits, hashCuts;
+        int betaCuts, nullCuts;
+    };
+
+    struct Progress    // of an iteration of the search
+    {
+        int  depth, score;
+        int  nodes, msecs;  // since the search started
+        int  hashFull;      // per mille
+        char move[5];       // the best move so far
+    };
+
+    class Listener
+    {
+    public:
+        virtual ~Listener() {}
+        virtual void OnProgress( const Progress& progress ) = 0;
+    };
+
+    HaQiKiD();
+    ~HaQiKiD();
+
+    void        InitEngine();
+    void        InitGame();
+    const char* GenerateNextMove();
+    void        OnOpponentMove( const char *line );
+    const char* BenchSearch( int depth );  // fixed depth, the move is not made
+    void        GetSearchInfo( SearchInfo& info ) const;
+    void        SetListener( Listener* listener );  // NULL = none
+    void        SetMaxDepth( int searchDepth );
+    void        SetMoveTime( int milliseconds );  // 0 = no cap
+    void        SetNodeLimit( int nodes );        // 0 = no budget
+    void        SetHashSize( int megabytes );
+
+private:
+    HaQiKiD( const HaQiKiD& );             // Not copyable.
+    HaQiKiD& operator=( const HaQiKiD& );
+
+    struct Engine;
+    Engine*     m_engine;
+};
+
+#endif /* __INCLUDED_HAQIKID_HOX_H__ */
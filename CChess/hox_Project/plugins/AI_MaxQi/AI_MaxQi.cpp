@@ -29,12 +29,33 @@
 
 #include <AIEngineLib.h>
 #include <DefaultDelete.h>
+#include <sstream>
+#include <cstdlib>
 #include "MaxQi.h"
 
+/* Size of the engine's hash table (the default of "Hash"). */
+static const int HASH_SIZE_MB = 48;
+
+/* MaxQi's difficulty levels (see AILevel). */
+static const AILevel s_levels[10] = {
+    /* maxDepth   nodes    msecs        level  average */
+    {  1,    10000,    250 },  /*  1      0 ms */
+    {  2,    25000,    250 },  /*  2      0 ms */
+    {  3,    50000,    500 },  /*  3      0 ms */
+    {  4,   100000,   1000 },  /*  4      3 ms */
+    {  5,   200000,   1500 },  /*  5     14 ms */
+    {  6,   350000,   2500 },  /*  6     71 ms */
+    {  8,   650000,   4000 },  /*  7    936 ms */
+    { 10,  1100000,   6000 },  /*  8   1569 ms */
+    { 12,  1900000,  10000 },  /*  9   2838 ms */
+    { 16,  3000000,  15000 },  /* 10   4570 ms */
+};
+
 class AIEngineImpl : public DefaultDelete<AIEngineLib>
 {
 public:
     AIEngineImpl(const char* engineName)
+        : m_hashSizeMB( HASH_SIZE_MB )
     {
         m_name = engineName ? engineName : "__UNKNOWN__";
     }
@@ -58,29 +79,80 @@ public:
     {
         if ( ! fen.empty() ) return hoxAI_RC_NOT_SUPPORTED;
 
-        MaxQi::init_game();
+        m_engine.init_game();
         return hoxAI_RC_OK;
     }
 
 	std::string generateMove()
     {
-        return MaxQi::generate_move();
+        return m_engine.generate_move();
     }
 
     void onHumanMove( const std::string& sMove )
     {
-        MaxQi::on_human_move( sMove );
+        m_engine.on_human_move( sMove );
     }
 
-    int setDifficultyLevel( int nAILevel )
+    int initGameBinary( const AIPosition* position,
+                        const AIMove*     moves,
+                        int               nMoves )
+    {
+        if ( position != NULL ) return hoxAI_RC_NOT_SUPPORTED;
+
+        m_engine.init_game();
+        return hoxAI_RC_OK;
+    }
+
+    AIMove generateMoveBinary()
+    {
+        return AIMoveFromString( m_engine.generate_move_text() );
+    }
+
+    void onHumanMoveBinary( AIMove move )
     {
-        int searchDepth = 1;
+        char szMove[5];
+        AIMoveToString( move, szMove );
+        m_engine.on_human_move( szMove );
+    }
+
+    int getSearchInfo( AISearchInfo& info )
+    {
+        int depth = 0, nodes = 0;
+        m_engine.get_search_info( depth, nodes );
+        info.depth = depth;
+        info.nodes = (unsigned long) nodes;
+
+        int probes = 0, hits = 0;
+        m_engine.get_hash_info( probes, hits );
+        info.hashProbes = (unsigned long) probes;
+        info.hashHits   = (unsigned long) hits;
+        return hoxAI_RC_OK;  // The cutoffs are not counted.
+    }
+
+    int benchSearch( int           depth,
+                     AIMove&       move,
+                     AISearchInfo& info )
+    {
+        move = AIMoveFromString( m_engine.bench_search_text( depth ) );
+        return getSearchInfo( info );
+    }
+
+    int setSearchListener( AISearchListener* listener )
+    {
+        m_progress.listener = listener;
+        m_engine.set_listener( listener ? &m_progress : NULL );
+        return hoxAI_RC_OK;
+    }
 
-        if      ( nAILevel > 10 ) searchDepth = 10;
-        else if ( nAILevel < 1 )  searchDepth = 1;
-        else                      searchDepth = nAILevel;
+    int setDifficultyLevel( int nAILevel )
+    {
+        if      ( nAILevel > 10 ) nAILevel = 10;
+        else if ( nAILevel < 1 )  nAILevel = 1;
 
-        MaxQi::set_max_depth( searchDepth );
+        const AILevel& level = s_levels[nAILevel - 1];
+        m_engine.set_max_depth( level.maxDepth );
+        m_engine.set_node_limit( level.nodes );
+        m_engine.set_move_time( level.msecs );
         return hoxAI_RC_OK;
     }
 
@@ -90,11 +162,65 @@ public:
                "home.hccnet.nl/h.g.muller/XQmaxqi.html";
     }
 
+    int listOptions( AIOptionList& options )
+    {
+        std::ostringstream ostr;
+        ostr << m_hashSizeMB;
+        options.push_back( AIOption( "Hash", AIOption::AI_OPTION_SPIN,
+                                     ostr.str(), 1, 1024 ) );
+        return hoxAI_RC_OK;
+    }
+
+    int setOption( const std::string& name,
+                   const std::string& value )
+    {
+        if ( name != "Hash" ) return hoxAI_RC_NOT_FOUND;
+
+        const int nMegabytes = ::atoi( value.c_str() );
+        if ( nMegabytes < 1 || nMegabytes > 1024 ) return hoxAI_RC_ERR;
+
+        m_hashSizeMB = nMegabytes;
+        m_engine.set_hash_size( m_hashSizeMB );
+        return hoxAI_RC_OK;
+    }
+
+private:
+    /* Passes the iterations of the engine on to the client's listener. */
+    class ProgressAdapter : public MaxQi::Engine::Listener
+    {
+    public:
+        ProgressAdapter() : listener( NULL ) {}
+        void on_iteration( int depth, int score, int nodes, int msecs,
+                           const char* szMove );
+
+        AISearchListener* listener;
+    };
+
 private:
-    std::string m_name;
+    std::string     m_name;
+    MaxQi::Engine   m_engine;
+    int             m_hashSizeMB;
+    ProgressAdapter m_progress;
 
 }; /* class AIEngineImpl */
 
+void
+AIEngineImpl::ProgressAdapter::on_iteration( int         depth,
+                                             int         score,
+                                             int         nodes,
+                                             int         msecs,
+                                             const char* szMove )
+{
+    AISearchProgress info;
+    info.depth    = depth;
+    info.score    = score;
+    info.nodes    = (unsigned long) nodes;
+    info.msecs    = (unsigned long) msecs;
+    info.pv[0]    = AIMoveFromString( szMove );
+    info.pvLength = ( info.pv[0] == hoxAI_MOVE_NONE ? 0 : 1 );
+    listener->onSearchProgress( info );
+}
+
 
 //////////////////////////////////////////////////////////////
 AIEngineLib* CreateAIEngineLib()
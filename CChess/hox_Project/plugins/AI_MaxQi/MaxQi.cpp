@@ -9,6 +9,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #ifdef WIN32
 #include <windows.h>
@@ -21,26 +22,14 @@ int GetTickCount() // with thanks to Tord Romstad
 }
 #endif
 
-int Side;
-int Post = 0;           /* set to 1 to see machine thinking printed */
-int MaxDepth  = 60;     /* must be set 2 higher than actual depth!  */
-int MaxTime   = 1200000; /* Time per session, msec                   */
-int MaxMoves  = 40;     /* moves per session; 0 = entire game       */
-int TimeInc   = 0;      /* extra time per move in msec              */
-int TimeLeft;
-int MovesLeft;
-int Fifty;
-int PlyNr;
-int Ticks, tlim;
-
 #define W while
 #define K(A,B) *(int*)(T+A+((B&31)<<8))
 #define J(A) K(y+A,b[y])-K(x+A,u)-K(y+A,t)
 
-#define U (1<<22)
-struct _ {int K,V;char X,Y,D,F;} A[U];         /* hash table, 4M entries   */
+#define U (1<<22)                              /* default hash entries     */
+struct _ {int K,V;char X,Y,D,F;};              /* hash table entry         */
 
-int M=136,S=128,I=8e3,Q,O,K,N,j,R,J,Z,LL,L,    /* M=0x88                   */
+int M=136,S=128,I=8e3,                         /* M=0x88                   */
 w[]={0,10,10,-1,15,15,19,19,20,45,46,90},      /* relative piece values    */
 of[]={0xC07,0xC07,0xC07,0xC07,0,               /* move rights flags  King  */
  0x470,0x470,0x470,0x470,0,0x870,0x870,0x870,0x870,0,         /* Elephants */
@@ -62,8 +51,6 @@ o[]={1,16,-1,-16,0,                                    /* board steps King */
 1,16,-1,-16,0                                                 /* Chariot   */
 },
 oo[32]={11,9,4,8,3,8,4,9,11},                  /* initial piece setup */
-b[513],                                        /* board: 16x8+dummy, + PST */
-T[8200],                                       /* hash translation table   */
 centr[]={0,1,1,1,1,1,0,1,0,0},                 /* piece draws to center    */
 n[]=".P*KEEQQAHCR????x+pkeeqqahcr????";        /* piece symbols on printout*/
 
@@ -79,7 +66,72 @@ char zn[] = {                                  /* zones of xiangqi board   */
 1,1,1,1,1,2,2,2,2,2,    0,0,0,0,0,0
 };
 
-void pboard()
+/* Everything the engine changes while it plays.  These used to be globals, */
+/* so only one game could be played per process; now every MaxQi::Engine    */
+/* has its own.  The state is zero-filled when created, like globals.       */
+struct MaxQi::Engine::State
+{
+ int Side;
+ int Post;               /* set to 1 to see machine thinking printed */
+ int MaxDepth;           /* must be set 2 higher than actual depth!  */
+ int MaxTime;            /* Time per session, msec                   */
+ int MaxMoves;           /* moves per session; 0 = entire game       */
+ int TimeInc;            /* extra time per move in msec              */
+ int TimeLeft;
+ int MovesLeft;
+ int Fifty;
+ int PlyNr;
+ int Ticks, tlim;
+ int MoveTime;           /* wall-clock cap per move, msec; 0 = none  */
+ int NodeLimit;          /* node budget per move; 0 = none           */
+ int Armed, Abort;       /* may the root iteration be abandoned? has it? */
+ unsigned char RX, RY;   /* root's best move of the last full iteration */
+ int RootDepth;          /* the last full root iteration                 */
+ int SearchDepth, SearchNodes; /* of the last _GenerateNextMove()        */
+ int HashProbes, HashHits;     /* statistics of the search               */
+ int Randomize;          /* randomize the root moves of the opening      */
+ MaxQi::Engine::Listener *listener; /* told about each root iteration     */
+
+ struct _ *A;                                  /* hash table               */
+ int HashSize;                                 /* entries, a power of 2    */
+ int Q,O,K,N,j,R,J,Z,LL,L;
+ char b[513],                                  /* board: 16x8+dummy, + PST */
+ T[8200];                                      /* hash translation table   */
+
+ int initDone;
+ unsigned int randSeed;
+ char move[5];
+
+ void Setup();
+ int Random();
+ void pboard();
+ int D(int k,int q,int l,int e,int z,int n);
+ void AllocHash();
+ void InitEngine();
+ void InitGame();
+ void _OnOpponentMove(const char *move);
+ const char *_GenerateNextMove();
+ const char *_BenchSearch(int depth);
+ void Report(int depth,int score,int from,int to);
+};
+
+void MaxQi::Engine::State::Setup()
+{
+ MaxDepth  = 60;
+ MaxTime   = 1200000;
+ MaxMoves  = 40;
+ randSeed  = 1;
+ HashSize  = U;
+ Randomize = 1;
+}
+
+int MaxQi::Engine::State::Random() /* instead of rand(), shared by all engines */
+{
+ randSeed = randSeed * 1103515245 + 12345;
+ return (int)(randSeed >> 1);
+}
+
+void MaxQi::Engine::State::pboard()
 {int i;
  i=-1;W(++i<144)printf(" %c",(i&15)==10&&(i+=15-10)?10:n[b[i]&31]);
 }
@@ -87,11 +139,13 @@ void pboard()
 D(k,q,l,e,z,n)          /* recursive minimax search, k=moving side, n=depth*/
 int k,q,l,e,z,n;        /* (q,l)=window, e=current eval. score, E=e.p. sqr.*/
 #endif
-int D(int k,int q,int l,int e,int z,int n) 
+int MaxQi::Engine::State::D(int k,int q,int l,int e,int z,int n) 
 {                       /* e=score, z=prev.dest; J,Z=hashkeys; return score*/
  int j,r,m,v,d,h,i,P,V,f=J,g=Z,C,s,flag,F;
  unsigned char t,p,u,x,y,X,Y,B,lu;
- struct _*a=A+(J+k&U-1);                       /* lookup pos. in hash table*/
+ struct _*a=A+(J+k&HashSize-1);                       /* lookup pos. in hash table*/
+ if(Abort)return 0;                            /* unwinding: value unused  */
+ HashProbes++;HashHits+=a->K==Z;               /* statistics               */
  q-=q<e;l-=l<=e;                               /* adj. window: delay bonus */
  d=a->D;m=a->V;F=a->F;                         /* resume at stored depth   */
  X=a->X;Y=a->Y;                                /* start at best-move hint  */
@@ -100,13 +154,18 @@ if(z&S&&a->K==Z)printf("# root hit %d %d %x\n",a->D,a->V,a->F);
   !(m<=q|F&8&&m>=l|F&S))                       /*   or window incompatible */
   d=X=0,Y=-1;                                  /* start iter. from scratch */
  W(d++<n||d<3||              /*** min depth = 2   iterative deepening loop */
-   z&S&&K==I&&(GetTickCount()-Ticks<tlim&d<=MaxDepth|| /* root: deepen upto time   */
-   (K=X,L=Y,d=3)))                             /* time's up: go do best    */
+   z&S&&K==I&&(GetTickCount()-Ticks<tlim&d<=MaxDepth /* root: deepen upto  */
+   &(!NodeLimit|2*N<NodeLimit)&!Abort||        /*   time or nodes, if not  */
+   (K=Abort?RX:X,L=Abort?RY:Y,                 /* time's up: go do best of */
+    Abort=Armed=0,d=3)))                       /*   last full iteration    */
  {x=B=X;lu=1;                                  /* start scan at prev. best */
+  if(z&S)RX=X,RY=Y,Armed=d>3&K==I;             /* root: budget may stop it */
   h=Y-255;                                       /* if move, request 1st try */
   P=d>2&&l+I?D(16-k,-l,1-l,-e,2*S,d-3):I;      /* search null move         */
   m=-P<l|R<5?d-2?-I:e:-P;   /*** prune if > beta  unconsidered:static eval */
   N++;                                         /* node count (for timing)  */
+  if(Armed&&(NodeLimit&&N>=NodeLimit||         /* node budget or time used */
+     MoveTime&&!(N&1023)&&GetTickCount()-Ticks>=MoveTime))Abort=1;
   do{u=b[x];                                   /* scan board looking for   */
    if(u)m=lu|u&15^3?m:(d=98,I),lu=u&15^3;        /* Kings facing each other  */
    if(u&&(u&16)==k)                            /*  own piece (inefficient!)*/
@@ -135,7 +194,7 @@ if(z&S&&a->K==Z)printf("# root hit %d %d %x\n",a->D,a->V,a->F);
          if(zn[x]-zn[y])b[y]+=5,               /* upgrade Pawn and         */
           i+=w[p+5]-w[p];                      /*          promotion bonus */
         }
-        if(z&S && PlyNr<6) v+=(rand()>>10&31)-16; // randomize in root
+        if(z&S && PlyNr<6 && Randomize) v+=(Random()>>10&31)-16; // randomize in root
         J+=J(0);Z+=J(4);
         v+=e+i;V=m>q?m:q;                      /*** new eval & alpha    ****/
         C=d-1-(d>5&p>2&!t&!h);                 /* nw depth, reduce non-cpt.*/
@@ -171,9 +230,12 @@ if(z&S&&a->K==Z)printf("# root hit %d %d %x\n",a->D,a->V,a->F);
    if((++x&15)>=10)x=x+16&240,lu=1;            /* next sqr. of board, wrap */
    if(x>=16*9)x=0;
   }W(x-B);           
-C:if(a->D<99)                                  /* protect game history     */
+C:if(a->D<99&!Abort)                           /* protect game history     */
    a->K=Z,a->V=m,a->D=d,a->X=X,                /* always store in hash tab */
    a->F=8*(m>q)|S*(m<l),a->Y=Y;                /* move, type (bound/exact),*/
+ if(z&S&&!Abort)RootDepth=d-2;                 /* root iteration completed */
+ if(z&S&&!Abort&&K==I&&d>2&&listener)          /* searching, not a move    */
+  Report(d-2,m,X,Y);                           /*   entered: report it     */
 if(z&S&&Post){
   printf("%2d ",d-2);
   printf("%6d ",m);
@@ -184,17 +246,27 @@ if(z&S&&Post){
 }
 
 void
-InitEngine()
+MaxQi::Engine::State::AllocHash()
 {
- N=8100;W(N-->256)T[N]=rand()>>9;                  /* Zobrist random keys */
- srand(GetTickCount());
+ if(A)return;
+ W(!(A=(struct _*)calloc(HashSize,sizeof(struct _)))&&HashSize>1)
+  HashSize/=2;                                     /* settle for less     */
 }
 
 void
-InitGame()
+MaxQi::Engine::State::InitEngine()
 {
- int i; static int initDone;
+ AllocHash();                                      /* hash table          */
+ N=8100;W(N-->256)T[N]=Random()>>9;                /* Zobrist random keys */
+ randSeed=GetTickCount();
+}
+
+void
+MaxQi::Engine::State::InitGame()
+{
+ int i;
  if(!initDone)initDone=1,InitEngine();
+ else memset(A,0,HashSize*sizeof(struct _));       /* forget old game     */
 
  for(i=0;i<16*9;i++)b[i]=0;           /* clear board   */
  b[23]=b[119]=10;b[18]=b[114]=26;     /* place Cannons */
@@ -210,7 +282,7 @@ InitGame()
  MovesLeft = MaxMoves; TimeLeft = MaxTime; /* initialize time control */
 }
 
-void _OnOpponentMove(const char *move)
+void MaxQi::Engine::State::_OnOpponentMove(const char *move)
 {
  const char *c=move;
  //K=16*('i'-c[0])+'9'-c[1];
@@ -226,21 +298,23 @@ void _OnOpponentMove(const char *move)
  }
 }
 
-const char *_GenerateNextMove()
+const char *MaxQi::Engine::State::_GenerateNextMove()
 {
- static char move[5];
-
  /* determine time to sepend on next move */
  Ticks = GetTickCount();                /* record starting time            */
  N = MovesLeft<=0 ? 40 : MovesLeft;     /* assume 40 movs for rest of game */
  tlim = (0.6-0.06*(10-8))*(TimeLeft+(N-1)*TimeInc)/(N+7);
  if(tlim>TimeLeft/15) tlim = TimeLeft/15;
+ if(MoveTime>0&&tlim>MoveTime/2)        /* no new iteration after half the */
+  tlim = MoveTime/2;                    /* cap: it would not finish in time*/
 
  /* now call the AI */
- N=0;K=I;
+ N=0;K=I;Armed=Abort=0;RootDepth=0;
+ SearchDepth=SearchNodes=HashProbes=HashHits=0;
  if (D(Side,-I,I,Q,S,3)!=I) sprintf(move, "none"); /* no move found */ else
  {/* legal move was found and played */
   Side ^= 16; /* other side moves next */
+  SearchDepth = RootDepth; SearchNodes = N; /* before N is reused below */
   //sprintf(move, "%c%c%c%c",'i'-(K>>4),'9'-(K&15),'i'-(L>>4&15),'9'-(L&15));
   sprintf(move, "%d%d%d%d",(K>>4),(K&15),(L>>4&15),(L&15));
 
@@ -258,20 +332,65 @@ const char *_GenerateNextMove()
  return move;
 }
 
+/* Search to a fixed depth for the benchmark: no time or node limit, and */
+/* no randomization.  The move found is played, like any other move.     */
+const char *MaxQi::Engine::State::_BenchSearch(int depth)
+{
+ int saveDepth=MaxDepth, saveTime=MoveTime, saveNodes=NodeLimit;
+ int saveRandom=Randomize;
+
+ MaxDepth=depth+2;                      /* MaxDepth counts 2 extra plies   */
+ MoveTime=NodeLimit=Randomize=0;
+ Ticks = GetTickCount();
+ tlim = 0x7FFFFFFF;
+
+ N=0;K=I;Armed=Abort=0;RootDepth=0;
+ SearchDepth=SearchNodes=HashProbes=HashHits=0;
+ if (D(Side,-I,I,Q,S,3)!=I) sprintf(move, "none"); /* no move found */ else
+ {Side ^= 16;
+  SearchDepth = RootDepth; SearchNodes = N;
+  sprintf(move, "%d%d%d%d",(K>>4),(K&15),(L>>4&15),(L&15));
+ }
+
+ MaxDepth=saveDepth; MoveTime=saveTime; NodeLimit=saveNodes;
+ Randomize=saveRandom;
+ return move;
+}
+
+/* Tell the listener about a completed root iteration.                  */
+void MaxQi::Engine::State::Report(int depth,int score,int from,int to)
+{
+ char szMove[9];  /* four nibbles, each up to two digits */
+ snprintf(szMove,sizeof(szMove),"%d%d%d%d",(from>>4&15),(from&15),(to>>4&15),(to&15));
+ listener->on_iteration(depth,score,N,GetTickCount()-Ticks,szMove);
+}
+
 ///////////////////////////////////////////
 //  namespace MaxQi                       //
 ///////////////////////////////////////////
 
+MaxQi::Engine::Engine()
+    : m_state( new State() )  // '()' zero-fills the state
+{
+    m_state->Setup();
+}
+
+MaxQi::Engine::~Engine()
+{
+    free( m_state->A );
+    delete m_state;
+}
+
 void
-MaxQi::init_game()
+MaxQi::Engine::init_game()
 {
-    InitGame();
+    m_state->InitGame();
 }
 
 std::string
-MaxQi::generate_move()
+MaxQi::Engine::generate_move()
 {
-    const char* szMove = _GenerateNextMove();
+    const char* szMove = m_state->_GenerateNextMove();
     std::string sMove;
     sMove += szMove[0];
     sMove += szMove[1];
@@ -281,7 +400,7 @@ MaxQi::generate_move()
 }
 
 void
-MaxQi::on_human_move( const std::string& sMove )
+MaxQi::Engine::on_human_move( const std::string& sMove )
 {
     std::string stdMove;
     stdMove += (sMove[0]); 
@@ -289,13 +408,77 @@ MaxQi::on_human_move( const std::string& sMove )
     stdMove += (sMove[2]); 
     stdMove += (sMove[3]); 
     
-    _OnOpponentMove( stdMove.c_str() );
+    m_state->_OnOpponentMove( stdMove.c_str() );
+}
+
+const char*
+MaxQi::Engine::generate_move_text()
+{
+    return m_state->_GenerateNextMove();
+}
+
+void
+MaxQi::Engine::on_human_move( const char* szMove )
+{
+    m_state->_OnOpponentMove( szMove );
+}
+
+const char*
+MaxQi::Engine::bench_search_text( int depth )
+{
+    return m_state->_BenchSearch( depth );
+}
+
+void
+MaxQi::Engine::get_search_info( int& depth, int& nodes ) const
+{
+    depth = m_state->SearchDepth;
+    nodes = m_state->SearchNodes;
+}
+
+void
+MaxQi::Engine::get_hash_info( int& probes, int& hits ) const
+{
+    probes = m_state->HashProbes;
+    hits   = m_state->HashHits;
+}
+
+void
+MaxQi::Engine::set_listener( Listener* listener )
+{
+    m_state->listener = listener;
+}
+
+void
+MaxQi::Engine::set_max_depth( int searchDepth )
+{
+    m_state->MaxDepth = searchDepth;
 }
 
 void
-MaxQi::set_max_depth( int searchDepth )
+MaxQi::Engine::set_move_time( int nMilliseconds )
 {
-    MaxDepth = searchDepth;
+    m_state->MoveTime = nMilliseconds;
+}
+
+void
+MaxQi::Engine::set_node_limit( int nNodes )
+{
+    m_state->NodeLimit = nNodes;
+}
+
+void
+MaxQi::Engine::set_hash_size( int nMegabytes )
+{
+    const size_t bytes = (size_t) nMegabytes << 20;
+    int n = 1;
+    while ( 2 * n * sizeof(struct _) <= bytes ) n *= 2;  // power of 2 entries
+
+    if ( n == m_state->HashSize ) return;
+    free( m_state->A );
+    m_state->A = NULL;
+    m_state->HashSize = n;
+    if ( m_state->initDone ) m_state->AllocHash();
 }
 
 /************************* END OF FILE ***************************************/
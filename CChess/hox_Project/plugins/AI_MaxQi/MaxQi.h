@@ -27,10 +27,46 @@ namespace MaxQi
 {
     /* PUBLIC API */
 
-    void        init_game();
-    std::string generate_move();
-    void        on_human_move( const std::string& sMove );
-    void        set_max_depth( int searchDepth );
+    /**
+     * A MaxQi engine.  Each object has its own board and hash table, so
+     * several games can be played at the same time (on different threads).
+     * A single object is not thread-safe.
+     */
+    class Engine
+    {
+    public:
+        Engine();
+        ~Engine();
+
+        void        init_game();
+        std::string generate_move();
+        void        on_human_move( const std::string& sMove );
+        const char* generate_move_text();                // without allocating:
+        void        on_human_move( const char* szMove ); // 4-digit HOX moves
+        const char* bench_search_text( int depth );     // fixed depth, no limits
+        void        get_search_info( int& depth, int& nodes ) const; // of the last move
+        void        get_hash_info( int& probes, int& hits ) const;   //   and search
+        void        set_max_depth( int searchDepth );
+        void        set_move_time( int nMilliseconds );  // 0 = no cap
+        void        set_node_limit( int nNodes );        // 0 = no budget
+        void        set_hash_size( int nMegabytes );     // rounded down to 2^n entries
+
+        class Listener  // told about each completed root iteration
+        {
+        public:
+            virtual ~Listener() {}
+            virtual void on_iteration( int depth, int score, int nodes, int msecs,
+                                       const char* szMove ) = 0; // the best move
+        };
+        void        set_listener( Listener* listener );  // NULL = none
+
+    private:
+        Engine( const Engine& );             // Not copyable.
+        Engine& operator=( const Engine& );
+
+        struct State;
+        State*      m_state;
+    };
 
 } // namespace MaxQi
 
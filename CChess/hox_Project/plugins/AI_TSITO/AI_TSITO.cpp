@@ -30,17 +30,27 @@
 #include <AIEngineLib.h>
 #include <DefaultDelete.h>
 #include <memory>
+#include <sstream>
+#include <cstdlib>
 #include "Move.h"
 #include "Board.h"
 #include "Lawyer.h"
+#include "Transposition.h"
 #include "tsiEngine.h"
 
+/* Defaults of the engine options (see tsiEngine). */
+static const int   TABLE_BITS   = 18;
+static const char* OPENING_BOOK = "book.bin";
+
 
 class AIEngineImpl : public DefaultDelete<AIEngineLib>
 {
 public:
     AIEngineImpl( const char* engineName )
         : m_name( engineName ? engineName : "__UNKNOWN__" )
+        , m_nTableBits( TABLE_BITS )
+        , m_bOwnBook( false )
+        , m_sBookFile( OPENING_BOOK )
     {
     }
 
@@ -63,8 +73,12 @@ public:
         m_board.reset( fen.empty() ? new Board()
                                    : new Board( fen ) );
         m_lawyer.reset( new Lawyer( m_board.get() ) );
+        m_board->addObserver( m_lawyer.get() );
         m_engine.reset( new tsiEngine( m_board.get(),
                                        m_lawyer.get() ) );
+        m_engine->setTableBits( m_nTableBits );
+        m_engine->setOpeningBook( m_bOwnBook, m_sBookFile );
+        m_engine->setSearchObserver( m_progress.listener ? &m_progress : NULL );
         return hoxAI_RC_OK;
     }
 
@@ -94,6 +108,72 @@ public:
         m_board->makeMove( tMove);
     }
 
+    /* NOTE: The binary moves use the same squares (9 * row + column)
+     *       as TSITO.  The position still goes through FEN since the
+     *       board is rebuilt for every game anyway.
+     */
+
+    AIMove generateMoveBinary()
+    {
+        m_engine->think();
+
+        if ( m_engine->doneThinking() )
+        {
+          Move move = m_engine->getMove();
+          if (!(move == Move()))
+            {
+              m_board->makeMove( move );
+              return AIMakeMove( move.origin(), move.destination() );
+            }
+        }
+
+        return hoxAI_MOVE_NONE;
+    }
+
+    void onHumanMoveBinary( AIMove move )
+    {
+        Move tMove;
+        tMove.origin( AIMoveFrom( move ) );
+        tMove.destination( AIMoveTo( move ) );
+        m_board->makeMove( tMove );
+    }
+
+    int getSearchInfo( AISearchInfo& info )
+    {
+        if ( m_engine.get() == NULL ) return hoxAI_RC_ERR;
+
+        info.depth = m_engine->depthSearched();
+        info.nodes = (unsigned long) m_engine->nodesSearched();
+        info.hashProbes  = (unsigned long) m_engine->hashProbesSearched();
+        info.hashHits    = (unsigned long) m_engine->hashHitsSearched();
+        info.hashCutoffs = (unsigned long) m_engine->hashCutoffsSearched();
+        info.betaCutoffs = (unsigned long) m_engine->betaCutoffsSearched();
+        info.nullCutoffs = (unsigned long) m_engine->nullCutoffsSearched();
+        return hoxAI_RC_OK;
+    }
+
+    int benchSearch( int           depth,
+                     AIMove&       move,
+                     AISearchInfo& info )
+    {
+        if ( m_engine.get() == NULL ) return hoxAI_RC_ERR;
+
+        const Move tMove = m_engine->benchSearch( depth );
+        move = ( tMove == Move() ? hoxAI_MOVE_NONE
+                                 : AIMakeMove( tMove.origin(), tMove.destination() ) );
+        return getSearchInfo( info );
+    }
+
+    int setSearchListener( AISearchListener* listener )
+    {
+        m_progress.listener = listener;
+        if ( m_engine.get() != NULL )
+        {
+            m_engine->setSearchObserver( listener ? &m_progress : NULL );
+        }
+        return hoxAI_RC_OK;
+    }
+
     int setDifficultyLevel( int nAILevel )
     {
         int searchDepth = 1;
@@ -116,6 +196,55 @@ public:
                "xiangqi-engine.sourceforge.net";
     }
 
+    /* NOTE: The options are kept by this object, not by the engine's
+     *       global Options object, which every TSITO engine observes.
+     */
+
+    int listOptions( AIOptionList& options )
+    {
+        /* The size actually allocated, rounded up to whole megabytes so
+         * that setting it again gives the same table. */
+        std::ostringstream ostr;
+        ostr << ( ( ((2 * sizeof(TNode)) << m_nTableBits) + (1 << 20) - 1 ) >> 20 );
+        options.push_back( AIOption( "Hash", AIOption::AI_OPTION_SPIN,
+                                     ostr.str(), 1, 1024 ) );
+
+        options.push_back( AIOption( "OwnBook", AIOption::AI_OPTION_CHECK,
+                                     m_bOwnBook ? "true" : "false" ) );
+        options.push_back( AIOption( "Book", AIOption::AI_OPTION_STRING,
+                                     m_sBookFile ) );
+        return hoxAI_RC_OK;
+    }
+
+    int setOption( const std::string& name,
+                   const std::string& value )
+    {
+        if ( name == "Hash" )
+        {
+            const int nMegabytes = ::atoi( value.c_str() );
+            if ( nMegabytes < 1 || nMegabytes > 1024 ) return hoxAI_RC_ERR;
+
+            /* The table has two halves (one per side) of 2^bits nodes. */
+            const size_t bytes = (size_t) nMegabytes << 20;
+            int nBits = 10;
+            while ( ((2 * sizeof(TNode)) << (nBits + 1)) <= bytes ) ++nBits;
+
+            m_nTableBits = nBits;
+            if ( m_engine.get() ) m_engine->setTableBits( m_nTableBits );
+        }
+        else if ( name == "OwnBook" || name == "Book" )
+        {
+            if ( name == "OwnBook" ) m_bOwnBook = ( value == "true" );
+            else                     m_sBookFile = value;
+            if ( m_engine.get() ) m_engine->setOpeningBook( m_bOwnBook, m_sBookFile );
+        }
+        else
+        {
+            return hoxAI_RC_NOT_FOUND;
+        }
+        return hoxAI_RC_OK;
+    }
+
 private:
     Move _translateStringToMove( const std::string& sMove )
     {
@@ -140,9 +269,38 @@ private:
         return sMove;
     }
 
+    /* Passes the iterations of the engine on to the client's listener. */
+    class ProgressAdapter : public SearchObserver
+    {
+    public:
+        ProgressAdapter() : listener( NULL ) {}
+        void iterationDone( int depth, long score, int nodes, int msecs,
+                            const std::vector<PVEntry>& pv )
+        {
+            AISearchProgress info;
+            info.depth = depth;
+            info.score = (int) score;
+            info.nodes = (unsigned long) nodes;
+            info.msecs = (unsigned long) msecs;
+            for ( size_t i = 0; i < pv.size() && i < hoxAI_MAX_PV; ++i )
+            {
+                info.pv[info.pvLength++] = AIMakeMove( pv[i].move.origin(),
+                                                       pv[i].move.destination() );
+            }
+            listener->onSearchProgress( info );
+        }
+
+        AISearchListener* listener;
+    };
+
 private:
     std::string m_name;
 
+    /* The engine options (see listOptions). */
+    int         m_nTableBits;
+    bool        m_bOwnBook;
+    std::string m_sBookFile;
+
     typedef std::auto_ptr<Board>  TSITO_Board_APtr;
     typedef std::auto_ptr<Lawyer> TSITO_Lawyer_APtr;
     typedef std::auto_ptr<tsiEngine> TSITO_Engine_APtr;
@@ -150,6 +308,7 @@ private:
     TSITO_Board_APtr    m_board;
     TSITO_Lawyer_APtr   m_lawyer;
     TSITO_Engine_APtr   m_engine;
+    ProgressAdapter     m_progress;
 
 }; /* class AIEngineImpl */
 
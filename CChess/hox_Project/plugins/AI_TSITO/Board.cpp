@@ -1,5 +1,6 @@
 #include	"Board.h"
 #include	"Move.h"
+#include	"Evaluator.h"
 
 #include	<string>
 #include	<cctype>
@@ -22,13 +23,19 @@ static
 const char pieceChars[] = {'+', 'p','c','r','h','e','a','k' };
 
 // Generates a full int random number...
+// A private generator with a fixed seed is used (instead of rand()) so that the
+// zoberist keys are the same in every run and on every platform.  Keys can then
+// be stored on disk, e.g. in the opening book.
 static u_int32 _rand32()
 {
-  u_int32 retVal;
+  static u_int32 seed = 0x2F6B7A13;
 
-  retVal = (rand() << 16) ^ (rand());
+  // xorshift32
+  seed ^= (seed << 13) & 0xFFFFFFFF;
+  seed ^= seed >> 17;
+  seed ^= (seed << 5) & 0xFFFFFFFF;
 
-  return retVal & 0x7FFFFFFF; // 32nd bit reserved for color.
+  return seed & 0x7FFFFFFF; // 32nd bit reserved for color.
 }
 
 // Static variables...
@@ -49,7 +56,11 @@ Board::Board()
 Board::Board(string fen)
 {
   _primaryHash = _secondaryHash = 0;
-  generateValues();
+  if (!hashValuesFilled)
+    {
+      generateValues();
+      hashValuesFilled = true;
+    }
   setPosition(fen);
 }
 
@@ -57,7 +68,6 @@ Board::Board(string fen)
 void Board::generateValues()
 {
   map<u_int32, u_int32> repeatCheckMap;
-  srand( (unsigned int) time(NULL) );
   for (int w = 0; w < 2; w++)
     {
       for (int i = 0; i < 90; i++)
@@ -79,17 +89,30 @@ void Board::generateValues()
 
 // Piece management
 
+// Adds (sign 1) or subtracts (sign -1) the piece at loc from the evaluation sums...
+void Board::addValues(int loc, int sign)
+{
+  const int side = (colorAt(loc)==RED?1:0);
+  const int p = pieceAt(loc);
+  _material[side]     += sign * Evaluator::materialValue(p);
+  _squareSum[side][0] += sign * Evaluator::squareValue(p, 0, loc);
+  _squareSum[side][1] += sign * Evaluator::squareValue(p, 1, loc);
+}
+
 // Removes piece at loc from the appropriate index...
 void Board::removePiece(int loc)
 {
-  vector<int>::iterator it;
-  vector< vector<int> > *pieces = (colorAt(loc)==RED? &rpieces:&bpieces);
-  for (it = (*pieces)[pieceAt(loc) - 1].begin();
-       it != (*pieces)[pieceAt(loc) - 1].end();
-       it++)
-    if (*it == loc)
+  const int side = (colorAt(loc)==RED?1:0);
+  const int p = pieceAt(loc);
+  addValues(loc, -1);
+  int *list = pieceList[side][p];
+  const int count = pieceCount[side][p];
+  for (int i = 0; i < count; i++)
+    if (list[i] == loc)
       {
-        (*pieces)[pieceAt(loc) - 1].erase(it);
+        // Keep the order of the remaining pieces.
+        for (int j = i + 1; j < count; j++) list[j-1] = list[j];
+        pieceCount[side][p]--;
         break;
       }
 }
@@ -97,40 +120,27 @@ void Board::removePiece(int loc)
 // Adds the piece at loc to the appropriate index...
 void Board::addPiece(int loc)
 {
-  if (colorAt(loc) == RED)
-    rpieces[pieceAt(loc) - 1].push_back(loc);
-  else
-  bpieces[pieceAt(loc) - 1].push_back(loc);
+  const int side = (colorAt(loc)==RED?1:0);
+  const int p = pieceAt(loc);
+  pieceList[side][p][pieceCount[side][p]++] = loc;
+  addValues(loc, 1);
 }
 
 // Move the piece at origin to dest in piece indexes.
 void Board::movePiece(int origin, int dest)
 {
-  vector<int>::iterator it;
-  vector< vector<int> > *pieces = (colorAt(origin)==RED? &rpieces:&bpieces);
-  for (it = (*pieces)[pieceAt(origin) - 1].begin();
-       it != (*pieces)[pieceAt(origin) - 1].end();
-       it++)
-    if (*it == origin)
+  const int side = (colorAt(origin)==RED?1:0);
+  const int p = pieceAt(origin);
+  int *list = pieceList[side][p];
+  const int count = pieceCount[side][p];
+  for (int i = 0; i < count; i++)
+    if (list[i] == origin)
       {
-        *it = dest;
+        list[i] = dest;
         break;
       }
-}
-
-// Return the piece index array for the specified color and piece type...
-vector<int> Board::pieces(color c, piece p)
-{
-  if (c == RED)
-    return rpieces[p - 1];
-  else
-    return bpieces[p - 1];
-}
-
-// Set up a piece index vector...
-static void setupVector(vector< vector<int> > &v)
-{
-  for (int i = 0; i < 7; i++) v.push_back(vector<int>());
+  _squareSum[side][0] += Evaluator::squareValue(p, 0, dest) - Evaluator::squareValue(p, 0, origin);
+  _squareSum[side][1] += Evaluator::squareValue(p, 1, dest) - Evaluator::squareValue(p, 1, origin);
 }
 
 // Read fen notation and distribute pieces on board and indexes...
@@ -143,10 +153,10 @@ bool Board::setPosition(string fen)
   char tempBoard[BOARD_AREA];
   int board_i = 0, board_j = 0;
   u_int32 t_primaryHash = 0, t_secondaryHash = 0;
-  vector< vector<int> > t_bpieces;
-  vector< vector<int> > t_rpieces;
+  int t_pieceList[2][8][MAX_PIECES_PER_TYPE];
+  int t_pieceCount[2][8];
 
-  setupVector(t_rpieces); setupVector(t_bpieces);
+  memset(t_pieceCount, 0, sizeof(t_pieceCount));
 
   // Iterate through the fen string as long as we are still on the board.
   while (fen_p != fen.end() && (board_i) * 9 + board_j < BOARD_AREA)
@@ -224,10 +234,12 @@ bool Board::setPosition(string fen)
           t_secondaryHash ^= hashValues[1][row+board_j][(size_t)tempBoard[row+board_j]];
 
           // Add the piece to the piece index tables...
-          if ((tempBoard[row+board_j]&8) == RED)
-            t_rpieces[(tempBoard[row+board_j]&7) - 1].push_back(row+board_j);
-          else if ((tempBoard[row+board_j]&8) == BLUE)
-            t_bpieces[(tempBoard[row+board_j]&7) - 1].push_back(row+board_j);
+          {
+            const int side = ((tempBoard[row+board_j]&8) == RED ? 1:0);
+            const int p = tempBoard[row+board_j]&7;
+            if (t_pieceCount[side][p] == MAX_PIECES_PER_TYPE) return false;
+            t_pieceList[side][p][t_pieceCount[side][p]++] = row+board_j;
+          }
           
           board_j++;
         }
@@ -252,15 +264,15 @@ bool Board::setPosition(string fen)
   _gameOver = false;
   _primaryHash = t_primaryHash;
   _secondaryHash = t_secondaryHash;
-  u_int32 colorSet = (_sideToMove << 28);
+  u_int32 colorSet = ((u_int32)_sideToMove << 28);
   _primaryHash |= colorSet;
   _secondaryHash |= colorSet;
-  rpieces.clear(); bpieces.clear();
-  for (int i = 0; i < 7; i ++)
-    {
-      rpieces.push_back(t_rpieces[i]);
-      bpieces.push_back(t_bpieces[i]);
-    }
+  memcpy(pieceList, t_pieceList, sizeof(pieceList));
+  memcpy(pieceCount, t_pieceCount, sizeof(pieceCount));
+  memset(_material, 0, sizeof(_material));
+  memset(_squareSum, 0, sizeof(_squareSum));
+  for (int loc = 0; loc < BOARD_AREA; loc++)
+    if (board[loc]) addValues(loc, 1);
   notifyObservers(BOARD_ALTERED);
 
   return true; // Return true.
@@ -390,7 +402,9 @@ ostream& operator<<(ostream& out, Board& theBoard)
   return out;
 }
 
-void Board::makeMove(Move &theMove)
+// Updates the board, piece indexes and hash keys for a move; the captured
+// piece is recorded in the move.
+void Board::doMove(Move &theMove)
 {
   if (!(theMove.origin() == theMove.destination()))
     {
@@ -411,19 +425,15 @@ void Board::makeMove(Move &theMove)
       //alterHashes(theMove.origin());
       alterHashes(theMove.destination());
     }
-  moveHistory.push_back(theMove);
-  
   
   _sideToMove    ^= RED;
   _primaryHash   ^= COLOR_SWITCH_KEY;
   _secondaryHash ^= COLOR_SWITCH_KEY;
-  notifyObservers(MOVE_MADE);
 }
 
-void Board::unmakeMove() // unmakes the top move in moveHistory.
+// Reverses doMove().
+void Board::undoMove(const Move &theMove)
 {
-  Move theMove = moveHistory.back();
-  moveHistory.pop_back();
   if (!(theMove.origin() == theMove.destination()))
     {
       //std::cerr << "Unmaking move " << theMove << "\n";
@@ -446,6 +456,20 @@ void Board::unmakeMove() // unmakes the top move in moveHistory.
   _sideToMove    ^= RED;
   _primaryHash   ^= COLOR_SWITCH_KEY;
   _secondaryHash ^= COLOR_SWITCH_KEY;
+}
+
+void Board::makeMove(Move &theMove)
+{
+  doMove(theMove);
+  moveHistory.push_back(theMove);
+  notifyObservers(MOVE_MADE);
+}
+
+void Board::unmakeMove() // unmakes the top move in moveHistory.
+{
+  Move theMove = moveHistory.back();
+  moveHistory.pop_back();
+  undoMove(theMove);
   notifyObservers(MOVE_UNDONE);
 }
 
@@ -26,8 +26,29 @@ typedef enum { EMPTY, ZU, PAO, CHE, MA, XIANG, SHI, LAO } piece;
 
 typedef unsigned long u_int32;
 
+/* Room in each piece index list; more than any legal position needs. */
+#define MAX_PIECES_PER_TYPE	16
+
 class Board;
 
+/*
+ * A read-only view of one of the board's piece index lists.  It refers to the
+ * board's own storage, so it must not be kept across moves.
+ */
+class PieceSpan
+{
+ private:
+  const int	*_first;
+  int		_size;
+ public:
+  PieceSpan(const int *first, int size) : _first(first), _size(size) {}
+  int size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  int operator[](int i) const { return _first[i]; }
+  const int *begin() const { return _first; }
+  const int *end() const { return _first + _size; }
+};
+
 class BoardObserver
 {
  public:
@@ -50,13 +71,18 @@ class Board
   std::string		_startPos;
 
   int	kings[2];
-  std::vector< std::vector<int> >	rpieces;
-  std::vector< std::vector<int> >   	bpieces;
-
-  // Note: since the random values are generated by the
-  // constructor, these may not be the same across boards;
-  // therefore the hash keys will not match if the keys
-  // are generated by different instances.
+  // Piece index lists: [color (0 = blue, 1 = red)][piece][n]
+  int	pieceList[2][8][MAX_PIECES_PER_TYPE];
+  int	pieceCount[2][8];
+
+  // Running evaluation terms: [color] and [color][table] (see Evaluator::squareValue).
+  long	_material[2];
+  long	_squareSum[2][2];
+  void addValues(int location, int sign);
+
+  // Note: the random values are generated once, from a fixed
+  // seed, so the hash keys of a position are the same across
+  // boards and across runs (the opening book relies on this).
   static u_int32	hashValues[2][90][15];
   static bool 		hashValuesFilled;
   u_int32		_primaryHash;
@@ -74,6 +100,10 @@ class Board
   void addPiece(int location);
   void removePiece(int location);
   void movePiece(int origin, int dest);
+
+  // Board, piece index and hash key updates shared by all the move functions.
+  void doMove(Move &theMove);
+  void undoMove(const Move &theMove);
   
  public:
   Board();
@@ -85,6 +115,14 @@ class Board
   void makeNullMove() { makeMove(Move::nullMove()); }
   void unmakeNullMove() { unmakeMove(); }
 
+  // Search-only move management: the game history is not recorded and no
+  // observers are notified.  Moves must be unmade in the reverse order, with
+  // the same Move object (it holds the captured piece).
+  void makeSearchMove(Move &theMove) { doMove(theMove); }
+  void unmakeSearchMove(const Move &theMove) { undoMove(theMove); }
+  void makeSearchNullMove() { doMove(Move::nullMove()); }
+  void unmakeSearchNullMove() { undoMove(Move::nullMove()); }
+
   // Square based access operators
   piece pieceAt(int index) const { return (piece)(board[index]&7); }
   color colorAt(int index) const { return (color)(board[index]&8); }
@@ -107,7 +145,15 @@ class Board
 
   // Piece index access...
   int king(color c) { return kings[c==RED?1:0]; }
-  std::vector<int> pieces(color c, piece p);
+  PieceSpan pieces(color c, piece p) const
+    {
+      const int side = (c==RED?1:0);
+      return PieceSpan(pieceList[side][p], pieceCount[side][p]);
+    }
+
+  // Running evaluation sums, kept up to date by the move functions...
+  long material(color c) const { return _material[c==RED?1:0]; }
+  long squareSum(color c, int table) const { return _squareSum[c==RED?1:0][table]; }
 
   // Zoberist keys...
   u_int32 primaryHash() { return _primaryHash; }
@@ -247,19 +247,10 @@ long Evaluator::evaluatePosition(Board &theBoard, Lawyer &lawyer)
 {
   color frend = theBoard.sideToMove();
   color enemy  = frend == RED ? BLUE:RED;
-  long total = 0;
-  for (int i = 1; i < 8; ++i) // Iterate through piece types...
-    {
-      // Gather each side's pieces.
-      vector<int> friendly   = theBoard.pieces(frend, (piece)i);
-      vector<int> unfriendly = theBoard.pieces(enemy, (piece)i);
 
-      // Add piece values to score based on position on board.
-      for (vector<int>::iterator it = friendly.begin(); it != friendly.end(); it++)
-        total += pieceValuesByLoc[i][0][*it]; // add values of friendly pieces
-      for (vector<int>::iterator it = unfriendly.begin(); it != unfriendly.end(); it++)
-        total -= pieceValuesByLoc[i][1][*it]; // subtract values of enemy pieces.
-    }
+  // Add values of friendly pieces and subtract those of enemy pieces, based on their
+  // position on the board.  The board keeps these sums as moves are made.
+  long total = theBoard.squareSum(frend, 0) - theBoard.squareSum(enemy, 1);
 
   // If one side is in check it is a more valuable position.
   if      (lawyer.inCheck(enemy))  total += 100;
@@ -272,18 +263,18 @@ long Evaluator::evaluateMaterial(Board &theBoard)
 {
   color frend = theBoard.sideToMove();
   color enemy  = frend == RED ? BLUE:RED;
-  long total = 0;
-  for (int i = 1; i < 8; i++) // Iterate through piece types...
-    {
-      // Gather each side's pieces.
-      vector<int> friendly   = theBoard.pieces(frend, (piece)i);
-      vector<int> unfriendly = theBoard.pieces(enemy, (piece)i);
+  return theBoard.material(frend) - theBoard.material(enemy);
+}
+int Evaluator::materialValue(int piece)
+{
+  return pieceValues[piece];
+}
 
-      total += friendly.size() * pieceValues[i];
-      total -= unfriendly.size() * pieceValues[i];
-    }
-  return total;
+int Evaluator::squareValue(int piece, int table, int location)
+{
+  return pieceValuesByLoc[piece][table][location];
 }
+
 int Evaluator::pieceValue(int piece)
 {
   if (piece < 0 || piece > 7)
@@ -24,6 +24,10 @@ class Evaluator
   long evaluatePosition(Board &theBoard, Lawyer &lawyer); // score the position on the board.
   long evaluateMaterial(Board &theBoard);
   int pieceValue(int piece); // absolute piece values, mostly used for move ordering.
+
+  // Table lookups used by the Board to keep its running sums up to date.
+  static int materialValue(int piece);
+  static int squareValue(int piece, int table, int location); // table: 0 friendly, 1 enemy.
 };
 
 #endif /* __EVALUATOR_H__ */
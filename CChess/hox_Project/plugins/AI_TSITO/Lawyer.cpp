@@ -1,9 +1,7 @@
-#include	<list>
 #include	"Lawyer.h"
 
 #include	"Move.h"
 #include	"Board.h"
-#include	"Evaluator.h"
 
 /*
  * Lawyer.cpp (c) Noah Roberts 2003-02-24
@@ -91,6 +89,8 @@ Lawyer::Lawyer(Board *brd)
   pieceMoves = _pieceMoves;
 
   board = brd;
+  checkValid[0] = checkValid[1] = false;
+  resetPositions();
 }
 
 bool Lawyer::drawn() // Tells us if the game is a draw.
@@ -125,33 +125,25 @@ bool Lawyer::legalMove(Move &theMove) // This method checks to make sure the use
 
   // Very expensive, but very easy...basically generate all possible moves and see if the one we got
   // is in the list.
-  list<Move>	moveList;
-  bool		found = false;
+  GeneratedMoves moveList;
   generateMoves(moveList);
   //cerr << "Number of moves: " << moveList.size() << endl;
-  for (list<Move>::iterator it = moveList.begin(); it != moveList.end(); it++)
-    {
-      if ((*it).origin() == theMove.origin() && (*it).destination() == theMove.destination())
-        found = true;
-      //cerr << (*it) << endl;
-    }
-  if (!found) return false;
+  if (!moveList.contains(theMove)) return false;
 
   // Now we check to see if we are in check after making the move - if so and we where in check then
   // the message is different than if we are simply moving into check.
   currentlyInCheck = inCheck();
-  board->makeMove(theMove);
-  board->makeNullMove();
-  if (inCheck())
+  board->makeSearchMove(theMove);
+  board->makeSearchNullMove();
+  const bool movedIntoCheck = inCheck();
+  board->unmakeSearchNullMove();
+  board->unmakeSearchMove(theMove);
+  if (movedIntoCheck)
     {
       if (currentlyInCheck) message = "in check";
       else message = "moving into check";
-      board->unmakeNullMove();
-      board->unmakeMove();
       return false;
     }
-  board->unmakeNullMove();
-  board->unmakeMove();
   return true;
 }
 
@@ -159,9 +151,19 @@ bool Lawyer::legalMove(Move &theMove) // This method checks to make sure the use
 bool Lawyer::inCheck(int col)
 {
   if (col == -1) col = board->sideToMove();
+  const int side = (col == RED ? 1:0);
+  if (   checkValid[side]
+      && checkPrimary[side] == board->primaryHash()
+      && checkSecondary[side] == board->secondaryHash())
+    return checkResult[side];
+
   // Find king...
   int kLoc = board->king((color)col);
-  return underAttack(kLoc); // Is he under attack?
+  checkResult[side] = underAttack(kLoc); // Is he under attack?
+  checkPrimary[side] = board->primaryHash();
+  checkSecondary[side] = board->secondaryHash();
+  checkValid[side] = true;
+  return checkResult[side];
 }
 
 void dummy() {}
@@ -264,7 +266,7 @@ bool Lawyer::underAttack(int loc, int c)
   return false; // If we haven't returned true it means we haven't found an attacker.
 }
 
-void Lawyer::generateMoves(list<Move> &moveList, int loc, bool onlyLegal)
+void Lawyer::generateMoves(GeneratedMoves &moveList, int loc, bool onlyLegal)
 {
   switch (board->pieceAt(loc))
     {
@@ -293,13 +295,15 @@ void Lawyer::generateMoves(list<Move> &moveList, int loc, bool onlyLegal)
     }
 }
       
-void Lawyer::generateMoves(list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateMoves(GeneratedMoves &moveList, bool onlyLegal)
 {
   for (int i = 1; i < 8; i++) // iterate through piece types
     {
       // Get this colors piece locations for the piece in question
-      vector<int> locations = board->pieces(board->sideToMove(), (piece)i);
-      for (vector<int>::iterator it = locations.begin(); // iterate through the locations and generate moves for that piece.
+      // Moves made to test legality only move these pieces temporarily, so the
+      // list may be walked in place.
+      PieceSpan locations = board->pieces(board->sideToMove(), (piece)i);
+      for (const int *it = locations.begin(); // iterate through the locations and generate moves for that piece.
            it != locations.end();
            it++)
         {
@@ -331,7 +335,7 @@ void Lawyer::generateMoves(list<Move> &moveList, bool onlyLegal)
     }
 }
 
-void Lawyer::addMove(list<Move> &moveList, Move &theMove, bool onlylegal) // Add a move to the move list.
+void Lawyer::addMove(GeneratedMoves &moveList, Move &theMove, bool onlylegal) // Add a move to the move list.
 {
   if (!onlylegal) // If we are generating pseudo-legal moves then just add the move - don't check a damn thing.
     {
@@ -340,14 +344,15 @@ void Lawyer::addMove(list<Move> &moveList, Move &theMove, bool onlylegal) // Add
     }
 
   // Otherwise we need to be sure it doesn't put us in check - doesn't matter why.
-  board->makeMove(theMove);
-  board->makeNullMove();
-  if (!inCheck())
+  board->makeSearchMove(theMove);
+  board->makeSearchNullMove();
+  const bool legal = !inCheck();
+  board->unmakeSearchNullMove();
+  board->unmakeSearchMove(theMove);
+  if (legal)
     {
       moveList.push_back(theMove);
     }
-  board->unmakeNullMove();
-  board->unmakeMove();
 }
 /*
  * It may be less effecient as far as code sharing goes to split these into several methods,
@@ -356,7 +361,7 @@ void Lawyer::addMove(list<Move> &moveList, Move &theMove, bool onlylegal) // Add
  * methods then the breakpoint can be set for the method for that piece.  Also, this may
  * improve performance as some of the hackery involved in merging these methods may not
  * be particularly good. */
-void Lawyer::generatePawnMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generatePawnMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = { -1, 13, 1 };
   int colorModifier = board->colorAt(from) == RED ? -1:1; // Invert offsets if we are red.
@@ -375,7 +380,7 @@ void Lawyer::generatePawnMoves(int from, list<Move> &moveList, bool onlyLegal)
         }
     }
 }
-void Lawyer::generateCanonMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateCanonMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = { -1, -13, 13, 1 };
   for (int i = 0; i < 4; i++) // hop through offsets
@@ -407,7 +412,7 @@ void Lawyer::generateCanonMoves(int from, list<Move> &moveList, bool onlyLegal)
         }
     }
 }
-void Lawyer::generateRookMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateRookMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = { -1, -13, 13, 1 };
   for (int i = 0; i < 4; i++) // hop through offsets
@@ -434,7 +439,7 @@ void Lawyer::generateRookMoves(int from, list<Move> &moveList, bool onlyLegal)
         }
     }
 }
-void Lawyer::generateKnightMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateKnightMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = {-11, -15, -25, -27, 11, 15, 25, 27 }; // moves
   static int blocks[]  = {  1,  -1,  -9,  -9, -1,  1,  9,  9 }; // if these are occupied we can't make the move to
@@ -452,7 +457,7 @@ void Lawyer::generateKnightMoves(int from, list<Move> &moveList, bool onlyLegal)
         }
     }
 }
-void Lawyer::generateElephantMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateElephantMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = { -28, -24, 24, 28 }; // moves
   static int blocks[]  = { -10,  -8,  8, 10 }; // same as per knight.
@@ -472,7 +477,7 @@ void Lawyer::generateElephantMoves(int from, list<Move> &moveList, bool onlyLega
         }
     }
 }
-void Lawyer::generateGuardMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateGuardMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = { -14, -12, 12, 14 }; // moves
   for (int i = 0; i < 4; i++)
@@ -489,7 +494,7 @@ void Lawyer::generateGuardMoves(int from, list<Move> &moveList, bool onlyLegal)
         }
     }
 }
-void Lawyer::generateGeneralMoves(int from, list<Move> &moveList, bool onlyLegal)
+void Lawyer::generateGeneralMoves(int from, GeneratedMoves &moveList, bool onlyLegal)
 {
   static int offsets[] = { -1, -13, 1, 13 }; // offsets
   int kingLineOffset = board->colorAt(from) == RED ? -13:13; // offset for checking for king-face capture
@@ -525,116 +530,113 @@ void Lawyer::generateGeneralMoves(int from, list<Move> &moveList, bool onlyLegal
     }
 }
 
-int Lawyer::gameWonByChase()
+// Does theMove (just made) chase the piece moved by lastMove, which must also be
+// unprotected?
+bool Lawyer::chases(const Move &theMove, const Move &lastMove)
 {
-  vector< Move > moveHistory = board->history();
-  vector< Move > undoHistory;
-  int size = positionalHistory.size();
-  if (size < 5) return NOCOLOR;
-  bool possible = false;
+  const int target = lastMove.destination();
+  if (board->pieceAt(target) == EMPTY || board->pieceAt(target) == JIANG) return false;
+
+  GeneratedMoves atks;
+  generateMoves(atks, theMove.destination(), false);
+  bool attacked = false;
+  for (int i = 0; i < atks.size(); i++)
+    if (atks[i].destination() == target) { attacked = true; break; }
+
+  // Check if it is protected by any piece...
+  return attacked && !underAttack(target, board->colorAt(target));
+}
 
-  // First look for perpetual chase because it is easier to look for...
+void Lawyer::moveMade(const Move &theMove)
+{
   /*
    * Rules: If Player X attacks Y's piece at location A using its piece at location C, and player Y runs to location B,
    *        and player X chases Y's piece at B by moving from C to D, and player Y runs back to A, and player X
    *        again chases player Y's piece at A by moving back to location C...and player Y's piece is not protected
    *        in neither A nor B, then player X looses by moving back to C.
+   *        If we have been put into check by the opponent during the whole cycle - we win.
    */
-  if (positionalHistory[size - 1] == positionalHistory[size - 5] && // current position matches 4 past...possible problem.
-      moveHistory[size-1].origin() == moveHistory[size - 3].destination() &&
-      moveHistory[size-3].origin() == moveHistory[size - 5].destination() &&
-      moveHistory[size-5].destination() == moveHistory[size-1].destination() &&
-      moveHistory[size-2].origin() == moveHistory[size - 4].destination())
-    {
-      list<Move> atks;
-      board->makeNullMove();
-      generateMoves(atks, moveHistory[size-1].destination());
-      board->unmakeNullMove();
-      int locA = -1;
-      int locB = -1;
-      possible = true;
-
-      // The last piece we moved is being attacked by the last piece the opponent moved.
-      locA = moveHistory[size-2].destination();
-      locB = moveHistory[size-2].origin();
-      possible = false;
-      for (list<Move>::iterator it = atks.begin(); it != atks.end(); it++)
-        if (it->destination() == locA) { possible = true; break; }
-      if (possible == true)
-        {
-          // Check if we are protected by any piece...
-          if (underAttack(locA, board->colorAt(locA)))
-            {
-              possible = false;
-            }
-          if (possible == true)
-            {
-              // Check if the same piece was being attacked by the same piece in the previous turn.
-              undoHistory.push_back(moveHistory[size-1]); undoHistory.push_back(moveHistory[size-2]);
-              board->unmakeMove(); board->unmakeMove();
-              
-              atks.clear();
-              board->makeNullMove();
-              generateMoves(atks, board->history()[size-3].destination());
-              board->unmakeNullMove();
-              possible = false;
-              for (list<Move>::iterator it = atks.begin(); it != atks.end(); it++)
-                if (it->destination() == locB) { possible = true; break; }
-              if (possible == true)
-                {
-                  if (underAttack(locB, board->colorAt(locB)))
-                    {
-                      possible = false;
-                    }
-                }
-            }
-        }
-    }
-  // cleanup...
-  for (vector<Move>::reverse_iterator it = undoHistory.rbegin(); it != undoHistory.rend(); it++)
-    board->makeMove(*it);
-  if (possible) { return board->sideToMove();}
- 
-  return NOCOLOR;
+  const bool nullMove   = (theMove.origin() == theMove.destination());
+  const bool reversible = !nullMove && !theMove.isCapture();
+  const int  p          = repetitions.ply() + 1;
+
+  RepetitionPly &info = repetitions.push(board->primaryHash(), board->secondaryHash(), reversible);
+  info.lastMove = theMove;
+  info.lastMove.capturedPiece(0);
+  if (nullMove || info.repeatPly == -1) return;
+
+  judgeRepetition(info, p);
 }
 
-int Lawyer::gameWonByPCheck()
+void Lawyer::judgeRepetition(RepetitionPly &info, int p)
 {
-  /* RULE: If we have been put into check by the opponent moving the same piece 3 times in a row, and the material is the
-           same - we win. */
-  vector<Move> hist = board->history();
-  int size = hist.size();
-  if (size < 6) return NOCOLOR;
+  // The checks and chases are only needed here, so they are found by replaying
+  // the cycle rather than on every move.  Moves after the segment start are not
+  // captures, so the recorded moves can be unmade and made again as they are.
+  const int r = info.repeatPly;
+  bool checks[2] = { true, true };  // [0]: the side that just moved, [1]: the other.
+  bool chased[2] = { true, true };
+
+  for (int k = p; k > r; k--)
+    board->unmakeSearchMove(repetitions.at(k).lastMove);
+  for (int k = r + 1; k <= p; k++)
+    {
+      Move theMove = repetitions.at(k).lastMove;
+      const Move &lastMove = repetitions.at(k-1).lastMove;
+      const int side = (p - k) & 1;
+      board->makeSearchMove(theMove);
+      if (checks[side] && !inCheck())
+        checks[side] = false;
+      if (chased[side] && (   lastMove.origin() == lastMove.destination()
+                           || !chases(theMove, lastMove)))
+        chased[side] = false;
+    }
 
-  Evaluator *eval = Evaluator::defaultEvaluator();
-  long material = eval->evaluateMaterial(*board);
+  const color mover = (board->sideToMove() == RED ? BLUE:RED);
 
-  vector<Move> undoHist;
-  if (inCheck())
+  if (checks[0] && !checks[1])
     {
-      if (hist[size-1].origin() == hist[size-3].destination() &&
-          hist[size-3].origin() == hist[size-5].destination())
-        {
-          bool possible = true;
-          for (int i = 0; i < 3 && possible; i++)
-            {
-              undoHist.push_back(board->history()[board->history().size() - 1]);
-              board->unmakeMove();
-              undoHist.push_back(board->history()[board->history().size() - 1]);
-              board->unmakeMove();
-
-              if (eval->evaluateMaterial(*board) != material ||
-                  !inCheck())
-                possible = false;
-            }
-          for (vector<Move>::reverse_iterator it = undoHist.rbegin(); it != undoHist.rend(); it++)
-            {
-              board->makeMove(*it);
-            }
-          if (possible) return board->sideToMove();
-        }
+      info.winner = board->sideToMove();
+      info.cause = REP_CHECK;
     }
-  return NOCOLOR;
+  else if (checks[1] && !checks[0])
+    {
+      info.winner = mover;
+      info.cause = REP_CHECK;
+    }
+  else if (chased[0] && !chased[1])
+    {
+      info.winner = board->sideToMove();
+      info.cause = REP_CHASE;
+    }
+  else if (chased[1] && !chased[0])
+    {
+      info.winner = mover;
+      info.cause = REP_CHASE;
+    }
+}
+
+void Lawyer::resetPositions()
+{
+  repetitions.reset(board->primaryHash(), board->secondaryHash());
+}
+
+int Lawyer::gameWonByChase()
+{
+  const RepetitionPly &info = repetitions.current();
+  return (info.cause == REP_CHASE ? info.winner : NOCOLOR);
+}
+
+int Lawyer::gameWonByPCheck()
+{
+  const RepetitionPly &info = repetitions.current();
+  return (info.cause == REP_CHECK ? info.winner : NOCOLOR);
+}
+
+bool Lawyer::gameDrawn()
+{
+  const RepetitionPly &info = repetitions.current();
+  return (info.repeatPly != -1 && info.winner == NOCOLOR);
 }
 
 void Lawyer::boardChanged(Board *brd, int message)
@@ -642,13 +644,13 @@ void Lawyer::boardChanged(Board *brd, int message)
   switch(message)
     {
     case BOARD_ALTERED:
-      positionalHistory.clear();
+      resetPositions();
       break;
     case MOVE_MADE:
-      positionalHistory.push_back(make_pair(brd->primaryHash(), brd->secondaryHash()));
+      moveMade(brd->history().back());
       break;
     case MOVE_UNDONE:
-      positionalHistory.pop_back();
+      moveUnmade();
       break;
     }
 }
@@ -16,17 +16,14 @@
  *
  */
 
-#include	<list>
 #include	<string>
-#include	<utility>
 #include	"HashTable.h"
+#include	"MoveBuffer.h"
+#include	"Repetition.h"
 
 class Move;
 #include	"Board.h"
 
-typedef unsigned long ulong;
-typedef std::pair< ulong, ulong > positionHash;
-
 class Lawyer : public BoardObserver
 {
  private:
@@ -44,10 +41,21 @@ class Lawyer : public BoardObserver
   Board	*board;
 
   std::string message;
-  std::vector< positionHash > positionalHistory;
 
+  // Last inCheck() answer for each color, keyed by the position's zoberist keys.  The
+  // search and the evaluator usually ask the same question of the same node.
+  u_int32 checkPrimary[2];
+  u_int32 checkSecondary[2];
+  bool checkValid[2];
+  bool checkResult[2];
+
+  // Positions of the current line, for the repetition rules.
+  RepetitionTable repetitions;
+  bool chases(const Move &theMove, const Move &lastMove);
+  void judgeRepetition(RepetitionPly &info, int p);
 
-  void addMove(std::list<Move> &moveList, Move &theMove, bool onlylegal = false);
+
+  void addMove(GeneratedMoves &moveList, Move &theMove, bool onlylegal = false);
  public:
   Lawyer(Board *brd);
   bool legalMove(Move &theMove);
@@ -67,24 +75,35 @@ class Lawyer : public BoardObserver
    * it is simply cheaper to search the illegal trees.  Must make sure that the program never
    * rates loosing a king better than loosing a rook and then the king.
    */
-  void generateMoves(std::list<Move> &moves, bool onlyLegal = false);
-  void generateMoves(std::list<Move> &moves, int location, bool legalonly = true);
-  //void generateMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void setBoard(Board *brd) { board = brd; }
+  void generateMoves(GeneratedMoves &moves, bool onlyLegal = false);
+  void generateMoves(GeneratedMoves &moves, int location, bool legalonly = true);
+  //void generateMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void setBoard(Board *brd) { board = brd; checkValid[0] = checkValid[1] = false; }
 
   // generation functions - one for each piece.
-  void generatePawnMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void generateCanonMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void generateRookMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void generateKnightMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void generateElephantMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void generateGuardMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-  void generateGeneralMoves(int location, std::list<Move> &moveList, bool onlyLegal = false);
-
+  void generatePawnMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void generateCanonMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void generateRookMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void generateKnightMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void generateElephantMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void generateGuardMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+  void generateGeneralMoves(int location, GeneratedMoves &moveList, bool onlyLegal = false);
+
+  // Repetition rules, all O(1).  When the current position repeats one of the
+  // current reversible segment, the side perpetually checking (or chasing an
+  // unprotected piece) looses; otherwise the game is drawn.
   // returns color that won.
   int gameWonByChase();
   int gameWonByPCheck();
   bool gameDrawn();
+  bool repeated() { return repetitions.current().repeatPly != -1; }
+  int repetitionWinner() { return repetitions.current().winner; }
+
+  // Game moves are tracked through boardChanged(); the search, which moves with
+  // Board::makeSearchMove(), reports its moves with these.
+  void moveMade(const Move &theMove);
+  void moveUnmade() { repetitions.pop(); }
+  void resetPositions();
 
   void boardChanged(Board* brd, int msg);
 };
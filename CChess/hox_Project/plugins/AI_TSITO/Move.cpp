@@ -19,20 +19,6 @@ std::ostream& operator<<(std::ostream& out, const Move &move)
 //               Move                                             
 // ----------------------------------------------------------------
 
-Move::Move()
-    : _origin( 0 )
-    , _destination( 0 )
-    , _capturedPiece( 0 )
-{
-}
-
-Move::Move(int o, int d, unsigned char cP /* = 0 */ )
-    : _origin( o )
-    , _destination( d )
-    , _capturedPiece( cP )
-{
-}
-
 /**
  * Scan and create a move out of a string.  Depends on ASCII layout...
  */
@@ -19,8 +19,9 @@ private:
     static Move    _null;
 
 public:
-    Move();
-    Move(int o, int d, unsigned char cP = 0);
+    Move() : _origin( 0 ), _destination( 0 ), _capturedPiece( 0 ) {}
+    Move(int o, int d, unsigned char cP = 0)
+        : _origin( o ), _destination( d ), _capturedPiece( cP ) {}
     Move( const std::string& moveText );
 
     bool isCapture() const { return _capturedPiece != 0; } 
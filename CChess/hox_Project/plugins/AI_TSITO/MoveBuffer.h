@@ -0,0 +1,82 @@
+#ifndef __MOVE_BUFFER_H__
+#define __MOVE_BUFFER_H__
+
+/*
+ * MoveBuffer.h
+ * A fixed-capacity, stack-allocated container of Moves used by move generation
+ * and the search.  Each slot carries an ordering score so that the search can
+ * sort the moves in place without allocating anything.
+ */
+
+#include <cassert>
+
+#include "Move.h"
+
+/* More than enough for any pseudo-legal Xiangqi position (the known maximum is
+ * well under 128 moves).
+ */
+#define MAX_GEN_MOVES  160
+
+template<int N>
+class MoveBuffer
+{
+private:
+    Move   _moves[N];
+    int    _scores[N];
+    int    _size;
+
+public:
+    MoveBuffer() : _size( 0 ) {}
+
+    void push_back( const Move& m )
+    {
+        assert( _size < N );
+        _moves[_size]    = m;
+        _scores[_size++] = 0;
+    }
+
+    int  size() const  { return _size; }
+    bool empty() const { return _size == 0; }
+    void clear()       { _size = 0; }
+
+    /* Drops every move from position 'n' onwards. */
+    void truncate( int n ) { if ( n < _size ) _size = n; }
+
+    Move&       operator[]( int i )       { return _moves[i]; }
+    const Move& operator[]( int i ) const { return _moves[i]; }
+
+    int  score( int i ) const         { return _scores[i]; }
+    void score( int i, int s )        { _scores[i] = s; }
+
+    bool contains( const Move& m ) const
+    {
+        for ( int i = 0; i < _size; ++i )
+            if ( _moves[i] == m ) return true;
+        return false;
+    }
+
+    /**
+     * Sort the moves by descending score.  An insertion sort is used since the
+     * lists are short and it keeps equally scored moves in generation order.
+     */
+    void sort()
+    {
+        for ( int i = 1; i < _size; ++i )
+        {
+            const Move m = _moves[i];
+            const int  s = _scores[i];
+            int j = i - 1;
+            for ( ; j >= 0 && _scores[j] < s; --j )
+            {
+                _moves[j+1]  = _moves[j];
+                _scores[j+1] = _scores[j];
+            }
+            _moves[j+1]  = m;
+            _scores[j+1] = s;
+        }
+    }
+};
+
+typedef MoveBuffer<MAX_GEN_MOVES> GeneratedMoves;
+
+#endif /* __MOVE_BUFFER_H__ */
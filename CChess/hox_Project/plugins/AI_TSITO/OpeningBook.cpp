@@ -4,87 +4,281 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>  // ... istringstream
+#include <vector>
+#include <algorithm>
 #include <ctime>
 #include <cstdlib>
+#include <cstring>
+
+#ifndef WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
 
 using namespace std;
 
+/*
+ * Binary book layout (all integers are little-endian):
+ *
+ *    header :  "TSIBOOK1"  count(u32)  reserved(u32)
+ *    records:  primaryHash(u32)  secondaryHash(u32)  move(u16)  reserved(u16)
+ *
+ * Records are sorted by (primaryHash, secondaryHash).  A position with several
+ * book moves has one record per move.  A move is (origin << 8) | destination.
+ */
+static const char   BOOK_MAGIC[]     = "TSIBOOK1";
+static const size_t BOOK_MAGIC_SIZE  = 8;
+static const size_t BOOK_HEADER_SIZE = 16;
+static const size_t BOOK_RECORD_SIZE = 12;
+
+static u_int32 _get32(const unsigned char* p)
+{
+    return (u_int32)p[0]         | ((u_int32)p[1] << 8)
+         | ((u_int32)p[2] << 16) | ((u_int32)p[3] << 24);
+}
+
+static u_int16 _get16(const unsigned char* p)
+{
+    return (u_int16)(p[0] | (p[1] << 8));
+}
+
+static void _put32(unsigned char* p, u_int32 v)
+{
+    p[0] = (unsigned char)(v);       p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24);
+}
+
+static void _put16(unsigned char* p, u_int16 v)
+{
+    p[0] = (unsigned char)(v); p[1] = (unsigned char)(v >> 8);
+}
+
 OpeningBook::OpeningBook(std::string filename)
-    : _bookContents( new Book )
-{ 
-    _read(filename);
+    : _records( NULL )
+    , _count( 0 )
+    , _data( NULL )
+    , _dataSize( 0 )
+    , _mapped( false )
+    , _validBook( false )
+{
+    _open(filename);
     srand( (unsigned int)time(NULL) );
 }
 
 OpeningBook::~OpeningBook()
 {
-    delete _bookContents;
+    _close();
 }
 
 void
-OpeningBook::_read(std::string filename)
+OpeningBook::_open(const std::string& filename)
 {
-    ifstream	bookFile(filename.c_str(), ios::in);
-
+#ifndef WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        cerr << "Can't open " << filename << endl;
+        return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* p = ::mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
+        {
+            _data     = p;
+            _dataSize = (size_t)st.st_size;
+            _mapped   = true;
+        }
+    }
+    ::close(fd);
+#else
+    ifstream bookFile(filename.c_str(), ios::in | ios::binary);
     if (!bookFile)
     {
         cerr << "Can't open " << filename << endl;
-        _validBook = false;
         return;
     }
+    bookFile.seekg(0, ios::end);
+    const streamoff size = bookFile.tellg();
+    bookFile.seekg(0, ios::beg);
+    if (size > 0)
+    {
+        _data     = ::malloc((size_t)size);
+        _dataSize = (size_t)size;
+        bookFile.read((char*)_data, size);
+    }
+#endif
+
+    if (_data == NULL) return;
 
-    int nline = 0;
-    char buffer[256];
-    bookFile.getline(buffer,255);
-    while (!bookFile.eof())
+    const unsigned char* bytes = (const unsigned char*) _data;
+    if (   _dataSize < BOOK_HEADER_SIZE
+        || memcmp(bytes, BOOK_MAGIC, BOOK_MAGIC_SIZE) != 0 )
+    {
+        cerr << "Not a binary book: " << filename << endl;
+        _close();
+        return;
+    }
+
+    _count = _get32(bytes + BOOK_MAGIC_SIZE);
+    if (_count > (_dataSize - BOOK_HEADER_SIZE) / BOOK_RECORD_SIZE)
+    {
+        cerr << "Truncated book: " << filename << endl;
+        _close();
+        return;
+    }
+
+    _records   = bytes + BOOK_HEADER_SIZE;
+    _validBook = true;
+}
+
+void
+OpeningBook::_close()
+{
+#ifndef WIN32
+    if (_mapped) ::munmap(_data, _dataSize);
+#else
+    ::free(_data);
+#endif
+    _data      = NULL;
+    _dataSize  = 0;
+    _mapped    = false;
+    _records   = NULL;
+    _count     = 0;
+    _validBook = false;
+}
+
+u_int16 OpeningBook::getMove(Board *board)
+{
+    const u_int32 primary   = board->primaryHash()   & 0xFFFFFFFF;
+    const u_int32 secondary = board->secondaryHash() & 0xFFFFFFFF;
+
+    // Binary search for the first record of the position.
+    size_t lo = 0, hi = _count;
+    while (lo < hi)
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        const unsigned char* r = _records + mid * BOOK_RECORD_SIZE;
+        const u_int32 p = _get32(r);
+        if (p < primary || (p == primary && _get32(r + 4) < secondary))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    size_t end = lo;
+    while (   end < _count
+           && _get32(_records + end * BOOK_RECORD_SIZE)     == primary
+           && _get32(_records + end * BOOK_RECORD_SIZE + 4) == secondary)
+    {
+        ++end;
+    }
+
+    if (end == lo) return 0;  // Not in the book.
+
+    const size_t pick = lo + rand() % (end - lo);
+    return _get16(_records + pick * BOOK_RECORD_SIZE + 8);
+}
+
+/* --------------------------------------------------------------------------
+ * Offline conversion from the text format.
+ * ------------------------------------------------------------------------*/
+
+namespace
+{
+    struct BookRecord
+    {
+        u_int32 primary;
+        u_int32 secondary;
+        u_int16 move;
+        size_t  order;  // Keeps the text order of moves of the same position.
+
+        bool operator<(const BookRecord& other) const
+        {
+            if (primary   != other.primary)   return primary   < other.primary;
+            if (secondary != other.secondary) return secondary < other.secondary;
+            return order < other.order;
+        }
+    };
+}
+
+bool
+OpeningBook::convert( const std::string& textFile,
+                      const std::string& binaryFile )
+{
+    ifstream bookFile(textFile.c_str(), ios::in);
+
+    if (!bookFile)
+    {
+        cerr << "Can't open " << textFile << endl;
+        return false;
+    }
+
+    Board              board;
+    vector<BookRecord> records;
+    int                nline = 0;
+    string             line;
+
+    while (getline(bookFile, line))
     {
         nline++;
-        string line(buffer);
 
         size_t indexOfColon = line.find(':');
         if (indexOfColon == string::npos)
         {
             cerr << "Illegal book entry at line " << nline << endl;
+            continue;
         }
-        else
+
+        if (!board.setPosition(line.substr(0,indexOfColon)))
         {
-            string position = line.substr(0,indexOfColon);
-            string moveTexts = line.substr(indexOfColon+1);
-            moveTexts += " ";
-            std::istringstream movesStream(moveTexts);
-
-            string move;
-            vector<u_int16> moves;
-            movesStream >> move;
-            while (!movesStream.eof())
-            {
-                u_int16	origin = 0, dest = 0;
-
-                Move m(move);
-                origin = (u_int16)m.origin(); dest = (u_int16)m.destination();
-                if (origin == 0 && dest == 0);
-                else
-                {
-                    moves.push_back((origin << 8) | dest);
-                }
-                movesStream >> move;
-            }
-            _bookContents->insert(Book::value_type(position, moves));
+            cerr << "Illegal position at line " << nline << endl;
+            continue;
         }
-        bookFile.getline(buffer,255);
-    }
 
-    _validBook = true;
-}
+        std::istringstream movesStream(line.substr(indexOfColon+1));
+        string move;
+        while (movesStream >> move)
+        {
+            Move m(move);
+            if (m.origin() == 0 && m.destination() == 0) continue;
 
+            BookRecord record;
+            record.primary   = board.primaryHash()   & 0xFFFFFFFF;
+            record.secondary = board.secondaryHash() & 0xFFFFFFFF;
+            record.move      = (u_int16)((m.origin() << 8) | m.destination());
+            record.order     = records.size();
+            records.push_back(record);
+        }
+    }
 
+    std::sort(records.begin(), records.end());
 
-u_int16 OpeningBook::getMove(Board *board)
-{
-  u_int16 move = 0;
+    ofstream out(binaryFile.c_str(), ios::out | ios::binary);
+    if (!out)
+    {
+        cerr << "Can't create " << binaryFile << endl;
+        return false;
+    }
+
+    unsigned char header[BOOK_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, BOOK_MAGIC, BOOK_MAGIC_SIZE);
+    _put32(header + BOOK_MAGIC_SIZE, (u_int32)records.size());
+    out.write((const char*)header, sizeof(header));
 
-  Book::iterator it = _bookContents->find(board->getPosition());
+    for (vector<BookRecord>::const_iterator it = records.begin(); it != records.end(); ++it)
+    {
+        unsigned char r[BOOK_RECORD_SIZE];
+        _put32(r,     it->primary);
+        _put32(r + 4, it->secondary);
+        _put16(r + 8, it->move);
+        _put16(r + 10, 0);
+        out.write((const char*)r, sizeof(r));
+    }
 
-  if (it != _bookContents->end()) move = it->second[rand() % it->second.size()];
-  return move;
+    return out.good();
 }
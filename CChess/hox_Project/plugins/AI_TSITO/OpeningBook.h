@@ -6,27 +6,36 @@
  * In charge of giving the engine some hints on what to play in the beginning of the game.
  * Provides adiquate opening play since the engine is unable to strategize.  Also gives play
  * that is not redundant - ie it won't always respond with the same move every damn time.
+ *
+ * The book is a binary file of records sorted by the board's zoberist keys
+ * (primaryHash, secondaryHash), so a lookup is a binary search that never renders the
+ * board to a FEN string.  The file is mapped into memory rather than parsed.  A text
+ * book ("<fen>:<move> <move> ...") is turned into that format offline by
+ * OpeningBook::convert() (see the 'tsibook' tool).
  */
 
 class Board;
 class Move;
 
 #include <string>
-#include <map>
-#include <vector>
+#include <cstddef>
 
 typedef unsigned short u_int16;
 
-typedef std::vector< u_int16 > BookEntry;
-typedef std::map< std::string, BookEntry > Book;
-
 class OpeningBook
 {
 private:
-    Book*  _bookContents;
-    bool   _validBook;
+    const unsigned char* _records;    // The sorted records (inside _data).
+    size_t               _count;      // Number of records.
+
+    void*                _data;       // The whole file: mapped, or a heap copy.
+    size_t               _dataSize;
+    bool                 _mapped;     // If true, _data was mmap'ed.
 
-    void   _read(std::string filename);
+    bool                 _validBook;
+
+    void   _open(const std::string& filename);
+    void   _close();
 
 public:
     OpeningBook(std::string filename);
@@ -34,6 +43,13 @@ public:
     u_int16 getMove(Board *board);
 
     bool valid() { return _validBook; }
+
+    /**
+     * Convert a text book into the binary format read by this class.
+     * @return true if the binary book has been written.
+     */
+    static bool convert( const std::string& textFile,
+                         const std::string& binaryFile );
 };
 
 #endif	/* __OPENINGBOOK_H__ */
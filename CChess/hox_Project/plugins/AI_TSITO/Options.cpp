@@ -100,6 +100,11 @@ void Options::addObserver(OptionsObserver *observer)
   observers.push_back(observer);
 }
 
+void Options::removeObserver(OptionsObserver *observer)
+{
+  observers.remove(observer);
+}
+
 bool Options::isOption(string commandText)
 {
   std::istringstream commandInputStream( commandText );
@@ -21,7 +21,7 @@ class OptionsObserver
 {
  public:
   virtual ~OptionsObserver() {}
-  virtual void optionChanged(std::string which)
+  virtual void optionChanged(const std::string& which)
     { std::cerr << "optionChanged() is a subclass responsibility!!\n"; }
 };
 
@@ -51,6 +51,7 @@ class Options
 
   // Observer pattern
   void addObserver(OptionsObserver *observer);
+  void removeObserver(OptionsObserver *observer);
 };
 
 #endif
@@ -0,0 +1,106 @@
+#include	"Repetition.h"
+
+/*
+ * Repetition.cpp
+ * RepetitionTable implementation.
+ */
+
+RepetitionTable::RepetitionTable()
+{
+  _plies.reserve(512);
+  reset(0, 0);
+}
+
+void RepetitionTable::reset(u_int32 primary, u_int32 secondary)
+{
+  for (int i = 0; i < TABLE_SIZE; i++)
+    {
+      _slots[i].primary = _slots[i].secondary = 0;
+      _slots[i].ply = -1;
+    }
+  _plies.clear();
+
+  RepetitionPly first;
+  first.primary = primary;
+  first.secondary = secondary;
+  first.segmentStart = 0;
+  first.repeatPly = -1;
+  first.lastMove = Move::nullMove();
+  first.winner = NOCOLOR;
+  first.cause = REP_NONE;
+
+  const int s = (int)(primary & (TABLE_SIZE - 1));
+  first.slot = s;
+  first.slotPrimary = _slots[s].primary;
+  first.slotSecondary = _slots[s].secondary;
+  first.slotPly = _slots[s].ply;
+  _slots[s].primary = primary;
+  _slots[s].secondary = secondary;
+  _slots[s].ply = 0;
+
+  _plies.push_back(first);
+}
+
+RepetitionPly& RepetitionTable::push(u_int32 primary, u_int32 secondary, bool reversible)
+{
+  const int p = (int)_plies.size();
+  const int segmentStart = (reversible ? _plies.back().segmentStart : p);
+
+  // Linear probing.  Slots last seen before the segment are stale and may be reused.
+  int found = -1, reusable = -1;
+  int s = (int)(primary & (TABLE_SIZE - 1));
+  for (int n = 0; n < TABLE_SIZE; n++, s = (s + 1) & (TABLE_SIZE - 1))
+    {
+      if (_slots[s].ply >= 0 && _slots[s].primary == primary && _slots[s].secondary == secondary)
+        {
+          found = s;
+          break;
+        }
+      if (_slots[s].ply < segmentStart && reusable == -1) reusable = s;
+      if (_slots[s].ply == -1) break; // end of the probe chain.
+    }
+  if (found == -1) found = reusable;
+
+  RepetitionPly info;
+  info.primary = primary;
+  info.secondary = secondary;
+  info.segmentStart = segmentStart;
+  info.repeatPly = -1;
+  info.lastMove = Move::nullMove();
+  info.winner = NOCOLOR;
+  info.cause = REP_NONE;
+  info.slot = found;
+
+  if (found != -1)
+    {
+      const Slot &slot = _slots[found];
+      if (   slot.ply >= segmentStart
+          && slot.primary == primary && slot.secondary == secondary)
+        {
+          info.repeatPly = slot.ply;
+        }
+      info.slotPrimary = slot.primary;
+      info.slotSecondary = slot.secondary;
+      info.slotPly = slot.ply;
+
+      _slots[found].primary = primary;
+      _slots[found].secondary = secondary;
+      _slots[found].ply = p;
+    }
+  // else: the table is full of live positions; this one is simply not tracked.
+
+  _plies.push_back(info);
+  return _plies.back();
+}
+
+void RepetitionTable::pop()
+{
+  const RepetitionPly &info = _plies.back();
+  if (info.slot != -1)
+    {
+      _slots[info.slot].primary = info.slotPrimary;
+      _slots[info.slot].secondary = info.slotSecondary;
+      _slots[info.slot].ply = info.slotPly;
+    }
+  _plies.pop_back();
+}
@@ -0,0 +1,72 @@
+#ifndef	__REPETITION_H__
+#define	__REPETITION_H__
+
+/*
+ * Repetition.h
+ * Keeps the positions of the current line (game moves plus search moves) in a small
+ * open-addressed hash table so that a repeated position is found in O(1).  Only the
+ * reversible segment matters: a capture or a null move starts a new segment, and
+ * positions seen before it no longer count as repetitions.
+ *
+ * Positions are pushed and popped in LIFO order, which lets pop() restore the table
+ * exactly, including slots that were reused.  Each ply also carries the verdict the
+ * Lawyer computes when the position repeats.
+ */
+
+#include	<vector>
+
+#include	"Board.h"
+
+struct RepetitionPly
+{
+  u_int32	primary;
+  u_int32	secondary;
+  int		segmentStart;	// First ply of the reversible segment.
+  int		repeatPly;	// Earlier ply of the same position in the segment, or -1.
+  Move		lastMove;	// The move that reached the position.
+
+  // Filled in by the Lawyer...
+  int		winner;		// If this repetition is forbidden: the color that wins.
+  int		cause;		// What forbids it (REP_CHECK or REP_CHASE).
+
+  // Used to restore the table on pop().
+  int		slot;
+  u_int32	slotPrimary;
+  u_int32	slotSecondary;
+  int		slotPly;
+};
+
+enum { REP_NONE = 0, REP_CHECK, REP_CHASE };
+
+class RepetitionTable
+{
+ private:
+  enum { TABLE_BITS = 10, TABLE_SIZE = 1 << TABLE_BITS };
+
+  struct Slot
+  {
+    u_int32	primary;
+    u_int32	secondary;
+    int		ply;		// Latest ply at which the position was seen, -1 if empty.
+  };
+
+  Slot				_slots[TABLE_SIZE];
+  std::vector<RepetitionPly>	_plies;
+
+ public:
+  RepetitionTable();
+
+  // Starts over from the given position (ply 0).
+  void reset(u_int32 primary, u_int32 secondary);
+
+  // Records the position reached by a move.  'reversible' is false for captures
+  // and null moves.
+  RepetitionPly& push(u_int32 primary, u_int32 secondary, bool reversible);
+  void pop();
+
+  int ply() const { return (int)_plies.size() - 1; }
+  RepetitionPly& at(int ply) { return _plies[ply]; }
+  RepetitionPly& current() { return _plies.back(); }
+};
+
+#endif	/* __REPETITION_H__ */
@@ -9,7 +9,8 @@
 #include "OpeningBook.h"
 
 
-#define OPENING_BOOK_FILE "book.dat"
+#define OPENING_BOOK_FILE "book.bin"
+#define DEFAULT_TABLE_BITS 18
 
 /* Engine.cpp (c) Noah Roberts 2003-02-27
  */
@@ -25,7 +26,7 @@ tsiEngine::tsiEngine( Board *brd, Lawyer *law )
 {
     evaluator         = Evaluator::defaultEvaluator();
     _openingBook      = NULL;
-    _transposTable    = new TranspositionTable(18);
+    _transposTable    = NULL;
 
     // Options and their defaults...
     _maxPly           = /* HPHAN: 6 */ 2;
@@ -45,87 +46,123 @@ tsiEngine::tsiEngine( Board *brd, Lawyer *law )
 
     _searchAborted    = NO_ABORT;
     _searchState      = BETWEEN_SEARCHES;
+    _depthSearched    = 0;
+    nodeCount         = 0;
+    hashProbes        = 0;
+    hashHits          = 0;
+    hashCutoffs       = 0;
+    betaCutoffs       = 0;
+    nullCutoffs       = 0;
+    _searchObserver   = NULL;
 
     // Register with Options class
     Options::defaultOptions()->addObserver(this);
 
-    // Open opening book if ok to do so.
-    if (_useOpeningBook)
-    {
-        _openingBook = new OpeningBook( OPENING_BOOK_FILE );
-        if (!_openingBook->valid()) // if not a valid book...
-        {
-            delete _openingBook;
-            _openingBook = NULL;
-            cerr << "Can't open my book!\n";
-        }
-    }
+    // Options that may have been set before this engine was created.
+    if (!Options::defaultOptions()->getValue("useOpeningBook").empty())
+        _useOpeningBook = (Options::defaultOptions()->getValue("useOpeningBook") == "on");
+    _bookFile = Options::defaultOptions()->getValue("bookFile");
+    const string bits = Options::defaultOptions()->getValue("tableSize");
+    _tableBits = ( bits.empty() ? DEFAULT_TABLE_BITS : ::atoi( bits.c_str() ) );
+
+    createTable();
+    openBook();
 }
 
 tsiEngine::~tsiEngine()
 {
+    Options::defaultOptions()->removeObserver(this);
     delete _transposTable;
     delete _openingBook;
 }
 
-/**
- * Functor to compare two Moves in a given Board context.
- */
-class CompareMovesInBoard
+void
+tsiEngine::createTable()
 {
-    public:
-        CompareMovesInBoard( const Board&             board,
-                             const std::vector<Move>& priorityTable )
-                : _board( board )
-                , _priorTable( priorityTable ) {}
+    if ( _tableBits <= 0 || _tableBits >= 31 ) _tableBits = DEFAULT_TABLE_BITS;
 
-        bool operator()(const Move& m1, const Move& m2);
+    delete _transposTable;
+    _transposTable = new TranspositionTable( _tableBits );
+}
 
-    private:
-        const Board&             _board;
-        const std::vector<Move>& _priorTable; // Move Priority Table
-};
+void
+tsiEngine::setTableBits(int bits)
+{
+    if (bits == _tableBits) return;
+    _tableBits = bits;
+    createTable();
+}
 
-bool
-CompareMovesInBoard::operator()(const Move& m1, const Move& m2)
+void
+tsiEngine::setOpeningBook(bool use, const std::string& file)
 {
-  Evaluator *e = Evaluator::defaultEvaluator();
-  int m1Index = -1, m2Index = -1;
-  for (size_t i = 0; i < _priorTable.size(); i++)
-    {
-      if (_priorTable[i] == m1) m1Index = i;
-      if (_priorTable[i] == m2) m2Index = i;
-    }
-  if (m1Index == -1 && m2Index != -1) return false;
-  if (m2Index == -1 && m1Index != -1) return true;
-  if (m1Index < m2Index) return true;
-  if (m2Index < m1Index) return false;
+    if (use == _useOpeningBook && file == _bookFile) return;
+    _useOpeningBook = use;
+    _bookFile = file;
+    openBook();
+}
 
-  // Now that killer moves and transposition table are taken into account,
-  // we try to order other moves logically
+void
+tsiEngine::openBook()
+{
+    delete _openingBook;
+    _openingBook = NULL;
+
+    if (!_useOpeningBook) return;
 
-  // king moves last...
-  if (_board.pieceAt(m1.origin()) == JIANG && _board.pieceAt(m2.origin()) != JIANG) return false;
-  if (_board.pieceAt(m2.origin()) == JIANG && _board.pieceAt(m1.origin()) != JIANG) return true;
+    const string file = (_bookFile.empty() ? string(OPENING_BOOK_FILE) : _bookFile);
 
-  // Captures: MVV/LVA (Most Valuable Victem/Least Valuable Attacker)
-  if (e->pieceValue(_board.pieceAt(m1.destination())) < e->pieceValue(_board.pieceAt(m2.destination()))) return false;
-  if (e->pieceValue(_board.pieceAt(m1.destination())) > e->pieceValue(_board.pieceAt(m2.destination()))) return true;
-  if (e->pieceValue(_board.pieceAt(m1.origin())) == e->pieceValue(_board.pieceAt(m2.origin()))) return false;
-  if (e->pieceValue(_board.pieceAt(m1.origin())) < e->pieceValue(_board.pieceAt(m2.origin())))
+    _openingBook = new OpeningBook( file );
+    if (!_openingBook->valid()) // if not a valid book...
     {
-      if (_board.pieceAt(m1.destination()) == EMPTY)
-        return false;
-      else
-        return true;
+        delete _openingBook;
+        _openingBook = NULL;
+        cerr << "Can't open my book!\n";
     }
-  else
+}
+
+/**
+ * Give every move an ordering score and sort the list by it.
+ *
+ * Moves from the priority table (killers, table move) come first, in table
+ * order.  King moves come last.  The other moves are ordered by MVV/LVA
+ * (Most Valuable Victem/Least Valuable Attacker); among non-captures the more
+ * valuable piece moves first.
+ */
+void
+tsiEngine::orderMoves(GeneratedMoves &moveList)
+{
+    enum { PRIORITY_BONUS = 1 << 24,
+           KING_PENALTY   = 1 << 23,
+           VICTIM_SCALE   = 2048 };  // Above the value of any attacker.
+
+    for (int i = 0; i < moveList.size(); ++i)
     {
-      if (_board.pieceAt(m1.destination()) == EMPTY)
-        return true;
-      else
-        return false;
+        const Move& m = moveList[i];
+
+        int priority = -1;
+        for (size_t p = 0; p < _priorityTable.size(); ++p)
+        {
+            if (_priorityTable[p] == m) priority = (int) p;
+        }
+
+        int s = 0;
+        if (priority != -1)
+        {
+            s = PRIORITY_BONUS - priority;
+        }
+        else
+        {
+            const int victim   = evaluator->pieceValue(board->pieceAt(m.destination()));
+            const int attacker = evaluator->pieceValue(board->pieceAt(m.origin()));
+            s = victim * VICTIM_SCALE
+                + (victim ? (VICTIM_SCALE - 1 - attacker) : attacker);
+            if (board->pieceAt(m.origin()) == JIANG) s -= KING_PENALTY;
+        }
+        moveList.score(i, s);
     }
+
+    moveList.sort();
 }
 
 
@@ -212,6 +249,9 @@ tsiEngine::think()
         killer2.clear();
         ftime(&_startTime);
         nodeCount = 0;
+        hashProbes = hashHits = hashCutoffs = 0;
+        betaCutoffs = nullCutoffs = 0;
+        _depthSearched = 0;
     }
 
     // Before we do ANYTHING else, check if the current position is recorded in the opening
@@ -250,6 +290,19 @@ tsiEngine::think()
         {
             _principleVariation = iterPV;
         }
+        if ( !_searchAborted )
+        {
+            _depthSearched = i;
+            if (_searchObserver)
+            {
+                struct timeb nowTime;
+                ftime(&nowTime);
+                const int msecs = 1000*(nowTime.time - _startTime.time)
+                                + (nowTime.millitm - _startTime.millitm);
+                _searchObserver->iterationDone(i, result, nodeCount, msecs,
+                                               _principleVariation);
+            }
+        }
         if (_displayThinking)
         {
             struct timeb nowTime;
@@ -272,6 +325,22 @@ tsiEngine::think()
   return result;
 }
 
+Move
+tsiEngine::benchSearch(int depth)
+{
+    const int    maxPly = _maxPly;
+    OpeningBook* book   = _openingBook;
+
+    _maxPly = depth;
+    _openingBook = NULL;
+    _searchState = BETWEEN_SEARCHES;
+    think();
+    _maxPly = maxPly;
+    _openingBook = book;
+
+    return getMove();
+}
+
 Move
 tsiEngine::getMove()
 {
@@ -296,6 +365,18 @@ tsiEngine::optionChanged(const std::string& whatOption)
     else if (whatOption == "useOpeningBook")
     {
         _useOpeningBook = (Options::defaultOptions()->getValue(whatOption) == "on");
+        openBook();
+    }
+    else if (whatOption == "bookFile")
+    {
+        _bookFile = Options::defaultOptions()->getValue(whatOption);
+        openBook();
+    }
+    else if (whatOption == "tableSize")
+    {
+        string bits = Options::defaultOptions()->getValue(whatOption);
+        _tableBits = ::atoi( bits.c_str() );
+        createTable();
     }
     else if (whatOption == "search")
     {
@@ -367,26 +448,16 @@ tsiEngine::optionChanged(const std::string& whatOption)
 }
 
 
-void tsiEngine::filterOutNonCaptures(list<Move> &moveList)
+void tsiEngine::filterOutNonCaptures(GeneratedMoves &moveList)
 {
   if (lawyer->inCheck()) return; // In check positions we want to look at all legal moves.
 
-  list<Move> copy;
-
-  // Otherwise only captures.
-  for (list<Move>::iterator it = moveList.begin(); it != moveList.end();)
-    {
-      if (board->pieceAt(it->destination()) == EMPTY)
-        {
-          break; // captures are on top (assuming sorted) so we can just stop processing here.
-        }
-      else
-        {
-          copy.push_back(*it);
-          it++;
-        }
-    }
-    moveList = copy; // This will be faster because there will be fewer moves...usually
+  // Otherwise only captures.  Captures are on top (assuming sorted) so we can just
+  // cut the list at the first non-capture.
+  int i = 0;
+  while (i < moveList.size() && board->pieceAt(moveList[i].destination()) != EMPTY)
+    i++;
+  moveList.truncate(i);
 }
 
 std::string
@@ -431,7 +502,7 @@ long tsiEngine::search(vector<PVEntry> &pv, long alpha, long beta, int ply, int
   vector<PVEntry> myPV;
   long value = 0;
   bool failHigh = false;
-  list<Move>		moveList;
+  GeneratedMoves	moveList;
 
   if (_searchAborted) return 0;
 
@@ -452,7 +523,13 @@ long tsiEngine::search(vector<PVEntry> &pv, long alpha, long beta, int ply, int
       if (!pv.empty()) pv[pv.size()-1].cutoff = MISC_CUTOFF;
       return INFIN; // I can take the king right now...illegal move made.
     }
-  //if (lawyer->gameWonByChase() != NOCOLOR || lawyer->gameWonByPCheck() != NOCOLOR) return (-CHECKMATE) - ply;
+  // A repeated position is a draw unless one side is perpetually checking or chasing.
+  if (ply > 0 && lawyer->repeated())
+    {
+      int winner = lawyer->repetitionWinner();
+      if (winner == NOCOLOR) return 0;
+      return (winner == board->sideToMove() ? (-CHECKMATE) - ply : CHECKMATE + ply);
+    }
   //if ((!legalonly) && lawyer->inCheck()) legalonly = true; // I am in check.
 
   // Return evaluation if this is a leaf node.
@@ -468,6 +545,7 @@ long tsiEngine::search(vector<PVEntry> &pv, long alpha, long beta, int ply, int
   long score;
   if (tableSearch(ply, depth, alpha, beta, m, score, nullOk))
     {
+      hashCutoffs++;
       pv.push_back(PVEntry(m, HASH_CUTOFF));
       return score;
     }
@@ -479,10 +557,12 @@ long tsiEngine::search(vector<PVEntry> &pv, long alpha, long beta, int ply, int
   if (ply > 0 && (!legalonly) && nullOk && ((!verify) || ((depth-ply) > 2)))
     {
       vector<PVEntry> ignore;
-      board->makeNullMove();
+      board->makeSearchNullMove();
+      lawyer->moveMade(Move::nullMove());
       value = -search(ignore, -beta, 1-beta, ply+1, depth-nullMoveReductionFactor,
                       false, false, verify);
-      board->unmakeMove();
+      lawyer->moveUnmade();
+      board->unmakeSearchNullMove();
 
       if (value > beta)
         {
@@ -497,6 +577,7 @@ long tsiEngine::search(vector<PVEntry> &pv, long alpha, long beta, int ply, int
             }
           else
             {
+              nullCutoffs++;
               if (!pv.empty()) pv[pv.size()-1].cutoff = NULL_CUTOFF;
               return value;
             }
@@ -512,8 +593,7 @@ long tsiEngine::search(vector<PVEntry> &pv, long alpha, long beta, int ply, int
       return CHECKMATE + ply;
     }
 
-  moveList.sort( CompareMovesInBoard( *board, _priorityTable ) );
-              // The information to sort has been set up by "search".
+  orderMoves(moveList); // The information to sort has been set up by "search".
 
   
 research: // Goto usually bad, but simplifies the code here.
@@ -548,6 +628,8 @@ research: // Goto usually bad, but simplifies the code here.
                       // is not that bad...the gain in worth it.
     }
 
+  if (value > beta)
+    betaCutoffs++;
   if (value > beta && !myPV.empty())
     newKiller(myPV[0].move, ply);
 
@@ -570,7 +652,7 @@ long tsiEngine::quiescence(long alpha, long beta, int ply, int depth, bool nullO
     */
 {
   long value = 0;
-  list<Move>	moveList;
+  GeneratedMoves moveList;
   bool		legalonly = false;
   vector<PVEntry> myPV;
   bool verify = false;
@@ -599,12 +681,14 @@ long tsiEngine::quiescence(long alpha, long beta, int ply, int depth, bool nullO
   if (!legalonly && nullOk && _useQNull)
     {
       vector<PVEntry> ignore;
-      board->makeNullMove();
+      board->makeSearchNullMove();
+      lawyer->moveMade(Move::nullMove());
       _useQuiescence = false;
       // Search to depth 1 looking for a beta cutoff - no quiescence during null.
       value = -search(ignore, -beta, 1-beta, 0,1, false, false, verify);
       _useQuiescence = true;
-      board->unmakeMove();
+      lawyer->moveUnmade();
+      board->unmakeSearchNullMove();
 
       // This position is quiet, return evaluation.
       if (value >= beta) return evaluator->evaluatePosition(*board,*lawyer);
@@ -615,7 +699,7 @@ long tsiEngine::quiescence(long alpha, long beta, int ply, int depth, bool nullO
   if (moveList.empty()) return CHECKMATE;
   
   setUpKillers(ply);
-  moveList.sort( CompareMovesInBoard( *board, _priorityTable ) );
+  orderMoves(moveList);
 
   // Only pay attention to captures and evasions.
   filterOutNonCaptures(moveList);
@@ -647,7 +731,7 @@ long tsiEngine::quiescence(long alpha, long beta, int ply, int depth, bool nullO
 }
 
 // Traditional AlphaBeta Search...
-long tsiEngine::alphaBeta(vector<PVEntry> &pv, list<Move> moveList, long alpha, long beta,
+long tsiEngine::alphaBeta(vector<PVEntry> &pv, GeneratedMoves &moveList, long alpha, long beta,
                        int ply, int depth, bool legalonly, bool nullOk,
                        bool verify)
   /* Inputs : moveList (list of moves to search), alpha (lower bound), beta (upper),
@@ -664,16 +748,17 @@ long tsiEngine::alphaBeta(vector<PVEntry> &pv, list<Move> moveList, long alpha,
   long value     = 0;
 
   // Iterate through the moves to find the best one.
-  for (list<Move>::iterator it = moveList.begin();
-       it != moveList.end() && best < beta; // have moves and haven't surpassed beta
-       it++)
+  for (int i = 0;
+       i < moveList.size() && best < beta; // have moves and haven't surpassed beta
+       i++)
     // We stop searching at beta because that means this line is worse for the other side
     // than any that came before, so they won't make that move and so this line never
     // takes place.  We assume the other player makes the best move possible.
     {
       vector<PVEntry> tempPV;
-      tempPV.push_back(PVEntry(*it,NO_CUTOFF));
-      board->makeMove(*it);
+      tempPV.push_back(PVEntry(moveList[i],NO_CUTOFF));
+      board->makeSearchMove(moveList[i]);
+      lawyer->moveMade(moveList[i]);
       if (best > alpha)  alpha = best; // We don't care about any lines that score less than
                                        // our current best.
       value = -search(tempPV, -beta, -alpha, ply+1, depth, false, true, verify);
@@ -684,7 +769,8 @@ long tsiEngine::alphaBeta(vector<PVEntry> &pv, list<Move> moveList, long alpha,
           best = value;  // replace best value
           myPV = tempPV; // replace current PV.
         }
-      board->unmakeMove();
+      lawyer->moveUnmade();
+      board->unmakeSearchMove(moveList[i]);
     }
   if (best == -INFIN) return CHECKMATE;
   pv.insert(pv.end(), myPV.begin(), myPV.end()); // add best line to PV.
@@ -699,7 +785,7 @@ long tsiEngine::alphaBeta(vector<PVEntry> &pv, list<Move> moveList, long alpha,
 // window and then the rest with 0 width windows just to prove the first was the best.
 // If the first is not the best then we research the one that gave us a better score
 // with window between beta and the returned score to find a true value.
-long tsiEngine::negaScout(std::vector<PVEntry> &pv,  std::list<Move> moveList,
+long tsiEngine::negaScout(std::vector<PVEntry> &pv, GeneratedMoves &moveList,
                        long alpha, long beta, int ply, int depth,
                        bool legalonly, bool nullOk, bool verify)
   /* Inputs : moveList (list of moves to search), alpha (lower bound), beta (upper),
@@ -720,20 +806,22 @@ long tsiEngine::negaScout(std::vector<PVEntry> &pv,  std::list<Move> moveList,
   long t = 0;
 
 
-  for (list<Move>::iterator it = moveList.begin(); it != moveList.end() && a < beta; it++)
+  for (int i = 0; i < moveList.size() && a < beta; i++)
     {
       vector<PVEntry> tempPV;
-      tempPV.push_back(PVEntry(*it, NO_CUTOFF));
-      board->makeMove(*it);
+      tempPV.push_back(PVEntry(moveList[i], NO_CUTOFF));
+      board->makeSearchMove(moveList[i]);
+      lawyer->moveMade(moveList[i]);
       t = -search(tempPV, -b, -a, ply+1, depth, false, true, verify);
-      if (t > a && t < beta && it != moveList.begin() && ply < depth-1)
+      if (t > a && t < beta && i != 0 && ply < depth-1)
         // Best move was not best - must search again.
         {
           tempPV.clear();
-          tempPV.push_back(PVEntry(*it, NO_CUTOFF));
+          tempPV.push_back(PVEntry(moveList[i], NO_CUTOFF));
           a = -search(tempPV, -beta, -t, ply+1, depth, false, true, verify);
         }
-      board->unmakeMove();
+      lawyer->moveUnmade();
+      board->unmakeSearchMove(moveList[i]);
       if (t > a) // We have a better best.
         {
           a = t;
@@ -763,8 +851,10 @@ bool tsiEngine::tableSearch(int ply, int depth, long &alpha, long &beta, Move &m
   if (!_useTable) return false;
   TNode searchNode;
   _transposTable->find(board, searchNode);
+  hashProbes++;
   if (searchNode.flag() != NOT_FOUND)
     {
+      hashHits++;
       m = searchNode.move();
       score = searchNode.score();
       if (allowTableWindowAdjustments)
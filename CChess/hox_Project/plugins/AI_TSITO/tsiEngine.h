@@ -14,6 +14,7 @@
 #include <sys/timeb.h>
 
 #include "Move.h"
+#include "MoveBuffer.h"
 #include "Options.h"
 #include "Timer.h"
 
@@ -36,6 +37,15 @@ struct PVEntry
 #define		INFIN	3000
 #define CHECKMATE (-2000)
 
+// Told about each completed iteration of the search.
+class SearchObserver
+{
+ public:
+  virtual ~SearchObserver() {}
+  virtual void iterationDone(int depth, long score, int nodes, int msecs,
+                             const std::vector<PVEntry>& pv) = 0;
+};
+
 class tsiEngine : public OptionsObserver
 {
 private:
@@ -65,13 +75,20 @@ private:
 
     // Search statistics
     int                  nodeCount;
+    int                  hashProbes;
     int                  hashHits;
+    int                  hashCutoffs;
+    int                  betaCutoffs;
     int                  nullCutoffs;
+    int                  _depthSearched; // The last completed iteration.
     struct timeb         _startTime;
+    SearchObserver*      _searchObserver; // NULL if none.
 
     // User configurable options
 
     bool        _useOpeningBook;
+    std::string _bookFile;
+    int         _tableBits;   // The table has 2^_tableBits nodes per side.
     bool        _displayThinking;
 
     bool        _useQuiescence; // perform quiescence search or not
@@ -103,16 +120,17 @@ private:
 
     // Search functions
     long quiescence(long alpha, long beta, int ply, int depth, bool nullOk = true);
-    void filterOutNonCaptures(std::list<Move> &l);
+    void filterOutNonCaptures(GeneratedMoves &moveList);
+    void orderMoves(GeneratedMoves &moveList);
 
     // Search algorithms...
 
-    long alphaBeta(std::vector<PVEntry> &pv, std::list<Move> moveList,
+    long alphaBeta(std::vector<PVEntry> &pv, GeneratedMoves &moveList,
                  long alpha, long beta, int ply, int depth,
                  bool legalonly = false, bool nullOk = true, bool verify = true);
     //long pvSearch(std::vector<PVEntry> &pv, long alpha, long beta, int ply, int depth,
     //              bool legalonly = false, bool nullOk = true, bool verify = true);
-    long negaScout(std::vector<PVEntry> &pv,  std::list<Move> moveList,
+    long negaScout(std::vector<PVEntry> &pv, GeneratedMoves &moveList,
                  long alpha, long beta, int ply, int depth,
                  bool legalonly = false, bool nullOk = true, bool verify = true);
 
@@ -129,6 +147,11 @@ private:
     bool tableSearch(int ply, int depth, long &alpha, long &beta, Move &m, long &score, bool &nullok);
     // stores position in table.
     void tableSet(int ply, int depth, long alpha, long beta, Move m, long score);
+    // (Re)creates the table and the book from _tableBits, _useOpeningBook and
+    // _bookFile (set from the "tableSize", "useOpeningBook" and "bookFile"
+    // options, or by setTableBits() and setOpeningBook()).
+    void createTable();
+    void openBook();
     // looks for killers and alters priority table
     void setUpKillers(int ply);
     // Adds killer move at ply
@@ -144,13 +167,33 @@ public:
     // Tells engine to think...
     long think();
 
+    // Settings of this engine only: unlike the shared Options, they do not
+    // touch the other engines (which may be searching on other threads).
+    void setTableBits(int bits);
+    int  tableBits() const { return _tableBits; }
+    void setOpeningBook(bool use, const std::string& file);
+
     // Tells engine that something happened such that search must be stopped.
     void endSearch();
     bool doneThinking();
     bool thinking();
 
+    // Searches to a fixed depth, without the opening book, for benchmarks.
+    // The move is not made.
+    Move benchSearch(int depth);
+
+    // Tells 'observer' (NULL for none) about the iterations of the searches.
+    void setSearchObserver(SearchObserver* observer) { _searchObserver = observer; }
+
     // Search information retrieval...
     Move getMove();
+    int  depthSearched() const { return _depthSearched; }
+    int  nodesSearched() const { return nodeCount; }
+    int  hashProbesSearched() const  { return hashProbes; }
+    int  hashHitsSearched() const    { return hashHits; }
+    int  hashCutoffsSearched() const { return hashCutoffs; }
+    int  betaCutoffsSearched() const { return betaCutoffs; }
+    int  nullCutoffsSearched() const { return nullCutoffs; }
     std::string variationText(const std::vector<PVEntry>& pv) const;
 
     // OptionObserver requirements
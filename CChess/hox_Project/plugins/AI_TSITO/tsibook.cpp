@@ -0,0 +1,22 @@
+/*
+ * tsibook.cpp
+ * Offline tool: converts a TSITO text opening book ("<fen>:<move> <move> ...")
+ * into the sorted binary book loaded by OpeningBook.
+ *
+ *    usage: tsibook <text book> <binary book>
+ */
+
+#include <iostream>
+
+#include "OpeningBook.h"
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <text book> <binary book>\n";
+        return 1;
+    }
+
+    return OpeningBook::convert(argv[1], argv[2]) ? 0 : 1;
+}
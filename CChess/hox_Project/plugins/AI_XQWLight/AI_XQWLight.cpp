@@ -29,12 +29,37 @@
 
 #include <AIEngineLib.h>
 #include <DefaultDelete.h>
+#include <sstream>
+#include <cstdlib>
 #include "XQWLight.h"
 
+/* Defaults of the engine options. */
+static const int   HASH_SIZE_MB = 16;
+static const char* OPENING_BOOK = "../plugins/BOOK.DAT";
+
+/* XQWLight's difficulty levels (see AILevel). */
+static const AILevel s_levels[10] = {
+    /* maxDepth   nodes    msecs        level  average */
+    {  1,     9000,    250 },  /*  1      6 ms */
+    {  2,    18000,    250 },  /*  2      8 ms */
+    {  3,    37000,    500 },  /*  3     10 ms */
+    {  4,    75000,   1000 },  /*  4     48 ms */
+    {  5,   150000,   1500 },  /*  5     75 ms */
+    {  6,   260000,   2500 },  /*  6    324 ms */
+    {  8,   440000,   4000 },  /*  7   1277 ms */
+    { 10,   740000,   6000 },  /*  8   2314 ms */
+    { 12,  1300000,  10000 },  /*  9   3380 ms */
+    { 16,  2200000,  15000 },  /* 10   5386 ms */
+};
+
 class AIEngineImpl : public DefaultDelete<AIEngineLib>
 {
 public:
     AIEngineImpl( const char* engineName )
+        : m_hashSizeMB( HASH_SIZE_MB )
+        , m_bOwnBook( true )
+        , m_sBook( OPENING_BOOK )
+        , m_listener( NULL )
     {
         m_name = engineName ? engineName : "__UNKNOWN__";
     }
@@ -51,7 +76,6 @@ public:
     void initEngine( int nAILevel = 0 )
     {
         setDifficultyLevel( nAILevel  == 0 ? 5 : nAILevel );
-        XQWLight::set_search_time( 60 /* seconds */ );
     }
 
   	int initGame( const std::string& fen,
@@ -84,15 +108,77 @@ public:
         XQWLight::on_human_move( sMove );
     }
 
-    int setDifficultyLevel( int nAILevel )
+    int initGameBinary( const AIPosition* position,
+                        const AIMove*     moves,
+                        int               nMoves )
+    {
+        if ( position == NULL )
+        {
+            XQWLight::init_game();
+        }
+        else
+        {
+            unsigned char board[10][9];
+            for ( int i = 0; i < 90; ++i )
+            {
+                const int piece = position->squares[i]
+                                ? _pieceCode( position->squares[i] ) : 0;
+                if ( piece < 0 ) return hoxAI_RC_ERR;
+                board[i / 9][i % 9] = piece;
+            }
+            XQWLight::init_game( board, position->side );
+        }
+        return hoxAI_RC_OK;
+    }
+
+    AIMove generateMoveBinary()
+    {
+        return (AIMove) XQWLight::generate_move_binary();
+    }
+
+    void onHumanMoveBinary( AIMove move )
+    {
+        XQWLight::on_human_move_binary( move );
+    }
+
+    int getSearchInfo( AISearchInfo& info )
+    {
+        XQWLight::SearchInfo search;
+        XQWLight::get_search_info( search );
+        info.depth       = search.depth;
+        info.nodes       = (unsigned long) search.nodes;
+        info.hashProbes  = (unsigned long) search.hashProbes;
+        info.hashHits    = (unsigned long) search.hashHits;
+        info.hashCutoffs = (unsigned long) search.hashCuts;
+        info.betaCutoffs = (unsigned long) search.betaCuts;
+        info.nullCutoffs = (unsigned long) search.nullCuts;
+        return hoxAI_RC_OK;
+    }
+
+    int benchSearch( int           depth,
+                     AIMove&       move,
+                     AISearchInfo& info )
+    {
+        move = (AIMove) XQWLight::bench_search( depth );
+        return getSearchInfo( info );
+    }
+
+    int setSearchListener( AISearchListener* listener )
     {
-        int searchDepth = 1;
+        m_listener = listener;
+        XQWLight::set_progress_callback( listener ? _onProgress : NULL, this );
+        return hoxAI_RC_OK;
+    }
 
-        if      ( nAILevel > 10 ) searchDepth = 10;
-        else if ( nAILevel < 1 )  searchDepth = 1;
-        else                      searchDepth = nAILevel;
+    int setDifficultyLevel( int nAILevel )
+    {
+        if      ( nAILevel > 10 ) nAILevel = 10;
+        else if ( nAILevel < 1 )  nAILevel = 1;
 
-        XQWLight::init_engine( searchDepth );
+        const AILevel& level = s_levels[nAILevel - 1];
+        XQWLight::init_engine( level.maxDepth );
+        XQWLight::set_node_limit( level.nodes );
+        XQWLight::set_move_time( level.msecs );
         return hoxAI_RC_OK;
     }
 
@@ -102,16 +188,82 @@ public:
                "www.elephantbase.net";
     }
 
+    int listOptions( AIOptionList& options )
+    {
+        std::ostringstream ostr;
+        ostr << m_hashSizeMB;
+        options.push_back( AIOption( "Hash", AIOption::AI_OPTION_SPIN,
+                                     ostr.str(), 1, 1024 ) );
+        options.push_back( AIOption( "OwnBook", AIOption::AI_OPTION_CHECK,
+                                     m_bOwnBook ? "true" : "false" ) );
+        options.push_back( AIOption( "Book", AIOption::AI_OPTION_STRING,
+                                     m_sBook ) );
+        return hoxAI_RC_OK;
+    }
+
+    int setOption( const std::string& name,
+                   const std::string& value )
+    {
+        if ( name == "Hash" )
+        {
+            const int nMegabytes = ::atoi( value.c_str() );
+            if ( nMegabytes < 1 || nMegabytes > 1024 ) return hoxAI_RC_ERR;
+            m_hashSizeMB = nMegabytes;
+            XQWLight::set_hash_size( m_hashSizeMB );
+        }
+        else if ( name == "OwnBook" )
+        {
+            m_bOwnBook = ( value == "true" );
+            XQWLight::set_opening_book( m_bOwnBook ? m_sBook : "" );
+        }
+        else if ( name == "Book" )
+        {
+            m_sBook = value.empty() ? OPENING_BOOK : value;
+            if ( m_bOwnBook ) XQWLight::set_opening_book( m_sBook );
+        }
+        else
+        {
+            return hoxAI_RC_NOT_FOUND;
+        }
+        return hoxAI_RC_OK;
+    }
+
 private:
+    static void _onProgress( const XQWLight::Progress& progress, void* data );
+
+    static int _pieceCode( char cPiece );
+        /* The XQWLight code of a FEN piece letter (-1 if invalid). */
+
     bool _convertFENtoBoard( const std::string& fen,
                              unsigned char      board[10][9],
                              char&              side ) const;
 
 private:
     std::string m_name;
+    int         m_hashSizeMB;
+    bool        m_bOwnBook;
+    std::string m_sBook;
+    AISearchListener* m_listener;
 
 }; /* class AIEngineImpl */
 
+void
+AIEngineImpl::_onProgress( const XQWLight::Progress& progress,
+                           void*                     data )
+{
+    AISearchProgress info;
+    info.depth    = progress.depth;
+    info.score    = progress.score;
+    info.nodes    = (unsigned long) progress.nodes;
+    info.msecs    = (unsigned long) progress.msecs;
+    info.hashFull = progress.hashFull;
+    for ( int i = 0; i < progress.pvLength && i < hoxAI_MAX_PV; ++i )
+    {
+        info.pv[info.pvLength++] = (AIMove) progress.pv[i];
+    }
+    static_cast<AIEngineImpl*>( data )->m_listener->onSearchProgress( info );
+}
+
 bool
 AIEngineImpl::_convertFENtoBoard( const std::string& fen,
                                   unsigned char      board[10][9],
@@ -152,27 +304,10 @@ AIEngineImpl::_convertFENtoBoard( const std::string& fen,
         }
         else
         {
-            const int color = ( *it < 'a' ? 0x08 : 0x10 );
-            int cType = *it;
-            if ( cType >= 'a' )
-            {
-                cType -= 'a' - 'A';  // ... to uppercase.
-            }
+            const int piece = _pieceCode( *it );
+            if ( piece < 0 ) return false; /* failure */
 
-            int type = 0;
-            switch ( cType )
-            {
-                case 'K': type = 0; break;
-                case 'A': type = 1; break;
-                case 'E': type = 2; break;
-                case 'R': type = 4; break;
-                case 'H': type = 3; break;
-                case 'C': type = 5; break;
-                case 'P': type = 6; break;
-                default: return false; /* failure */
-            }
-
-            board[r][c] = color + type;
+            board[r][c] = piece;
             ++c;
         }
     }
@@ -180,6 +315,32 @@ AIEngineImpl::_convertFENtoBoard( const std::string& fen,
     return true; // success
 }
 
+int
+AIEngineImpl::_pieceCode( char cPiece )
+{
+    const int color = ( cPiece < 'a' ? 0x08 : 0x10 );
+    int cType = cPiece;
+    if ( cType >= 'a' )
+    {
+        cType -= 'a' - 'A';  // ... to uppercase.
+    }
+
+    int type = 0;
+    switch ( cType )
+    {
+        case 'K': type = 0; break;
+        case 'A': type = 1; break;
+        case 'E': type = 2; break;
+        case 'R': type = 4; break;
+        case 'H': type = 3; break;
+        case 'C': type = 5; break;
+        case 'P': type = 6; break;
+        default: return -1; /* invalid */
+    }
+
+    return color + type;
+}
+
 ////////////////// END OF AIEngineImpl ////////////////////////////////////////
 
 AIEngineLib* CreateAIEngineLib()
@@ -32,6 +32,9 @@
 #include "XQWLight.h"
 
 #include <time.h>
+#ifndef WIN32
+#  include <sys/time.h>  // gettimeofday
+#endif
 //#include <windows.h>
 //#include "resource.h"
 #include <sstream>     // ostringstream
@@ -57,9 +60,13 @@ typedef unsigned int       DWORD;
 #endif
 
 // *** Additional variables ***
-static int          s_search_depth = 7; // Search Depth
-static int          s_search_time = 1;  // In seconds (search-time)
-static const char*  s_opening_book = "../plugins/BOOK.DAT";
+static int          s_search_depth = 7;    // Search Depth (a ceiling)
+static int          s_search_time = 1000;  // Per-move cap, in milliseconds (0 = none)
+static int          s_search_nodes = 0;    // Per-move node budget (0 = none)
+static std::string  s_opening_book = "../plugins/BOOK.DAT"; // "" = no book
+static BOOL         s_randomize = TRUE;    // Noise on the root scores (off for benchmarks)
+static XQWLight::ProgressCallback s_progress_callback = NULL; // Told about each iteration
+static void*        s_progress_data = NULL;
 
 ///////          END of  HPHAN's changes                      /////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -604,6 +611,10 @@ struct MoveStruct {
 struct PositionStruct {
   int sdPlayer;                   // ֵ˭ߣ0=췽1=ڷ
   BYTE ucpcSquares[256];          // ϵ
+  BYTE ucsqPieces[2][16];         // The squares of the pieces of each side, in no order
+  BYTE ucpcIndex[256];            // The index in "ucsqPieces" of the piece on a square
+  int nPieces[2];                 // The number of pieces of each side
+  int sqKings[2];                 // The square of each King (0 if none)
   int vlWhite, vlBlack;           // 졢˫ֵ
   int nDistance, nMoveNum;        // ڵĲʷ߷
   MoveStruct mvsList[MAX_MOVES];  // ʷ߷Ϣб
@@ -612,6 +623,8 @@ struct PositionStruct {
   void ClearBoard(void) {         // 
     sdPlayer = vlWhite = vlBlack = nDistance = 0;
     memset(ucpcSquares, 0, 256);
+    nPieces[0] = nPieces[1] = 0;
+    sqKings[0] = sqKings[1] = 0;
     zobr.InitZero();
   }
   void SetIrrev(void) {           // (ʼ)ʷ߷Ϣ
@@ -625,6 +638,13 @@ struct PositionStruct {
   }
   void AddPiece(int sq, int pc) { // Ϸһö
     ucpcSquares[sq] = pc;
+    int sd = (pc < 16 ? 0 : 1);
+    ucpcIndex[sq] = nPieces[sd];
+    ucsqPieces[sd][nPieces[sd]] = sq;
+    nPieces[sd] ++;
+    if ((pc & 7) == PIECE_KING) {
+      sqKings[sd] = sq;
+    }
     // 췽ӷ֣ڷ(ע"cucvlPiecePos"ȡֵҪߵ)
     if (pc < 16) {
       vlWhite += cucvlPiecePos[pc - 8][sq];
@@ -636,6 +656,14 @@ struct PositionStruct {
   }
   void DelPiece(int sq, int pc) { // һö
     ucpcSquares[sq] = 0;
+    int sd = (pc < 16 ? 0 : 1);
+    // The last piece of the side takes the place of this one
+    int sqLast = ucsqPieces[sd][-- nPieces[sd]];
+    ucsqPieces[sd][ucpcIndex[sq]] = sqLast;
+    ucpcIndex[sqLast] = ucpcIndex[sq];
+    if ((pc & 7) == PIECE_KING) {
+      sqKings[sd] = 0;
+    }
     // 췽֣ڷ(ע"cucvlPiecePos"ȡֵҪߵ)ӷ
     if (pc < 16) {
       vlWhite -= cucvlPiecePos[pc - 8][sq];
@@ -705,7 +733,7 @@ void PositionStruct::Startup(unsigned char board[10][9]) {
   {
       for (int i = 0; i<10;i++)
 	      for (int j = 0; j <9; j++){
-		      if (board[i][j] > 0){
+		      if (board[i][j] > 0 && nPieces[board[i][j] < 16 ? 0 : 1] < 16){
 			      sq = (3+i)*16 + 3 + j;
 			      AddPiece(sq, board[i][j]);
 		      }
@@ -775,20 +803,18 @@ const BOOL GEN_CAPTURE = TRUE;
 
 // ߷"bCapture"Ϊ"TRUE"ֻɳ߷
 int PositionStruct::GenerateMoves(int *mvs, BOOL bCapture) const {
-  int i, j, nGenMoves, nDelta, sqSrc, sqDst;
+  int i, j, k, nGenMoves, nDelta, sqSrc, sqDst;
   int pcSelfSide, pcOppSide, pcSrc, pcDst;
   // ߷Ҫ¼裺
 
   nGenMoves = 0;
   pcSelfSide = SIDE_TAG(sdPlayer);
   pcOppSide = OPP_SIDE_TAG(sdPlayer);
-  for (sqSrc = 0; sqSrc < 256; sqSrc ++) {
+  for (k = 0; k < nPieces[sdPlayer]; k ++) {
 
     // 1. ҵһӣжϣ
+    sqSrc = ucsqPieces[sdPlayer][k];
     pcSrc = ucpcSquares[sqSrc];
-    if ((pcSrc & pcSelfSide) == 0) {
-      continue;
-    }
 
     // 2. ȷ߷
     switch (pcSrc - pcSelfSide) {
@@ -1000,66 +1026,63 @@ BOOL PositionStruct::LegalMove(int mv) const {
 // жǷ񱻽
 BOOL PositionStruct::Checked() const {
   int i, j, sqSrc, sqDst;
-  int pcSelfSide, pcOppSide, pcDst, nDelta;
-  pcSelfSide = SIDE_TAG(sdPlayer);
+  int pcOppSide, pcDst, nDelta;
   pcOppSide = OPP_SIDE_TAG(sdPlayer);
   // ҵϵ˧()жϣ
 
-  for (sqSrc = 0; sqSrc < 256; sqSrc ++) {
-    if (ucpcSquares[sqSrc] != pcSelfSide + PIECE_KING) {
-      continue;
-    }
+  sqSrc = sqKings[sdPlayer];
+  if (sqSrc == 0) {
+    return FALSE;
+  }
 
-    // 1. жǷ񱻶Էı()
-    if (ucpcSquares[SQUARE_FORWARD(sqSrc, sdPlayer)] == pcOppSide + PIECE_PAWN) {
+  // 1. жǷ񱻶Էı()
+  if (ucpcSquares[SQUARE_FORWARD(sqSrc, sdPlayer)] == pcOppSide + PIECE_PAWN) {
+    return TRUE;
+  }
+  for (nDelta = -1; nDelta <= 1; nDelta += 2) {
+    if (ucpcSquares[sqSrc + nDelta] == pcOppSide + PIECE_PAWN) {
       return TRUE;
     }
-    for (nDelta = -1; nDelta <= 1; nDelta += 2) {
-      if (ucpcSquares[sqSrc + nDelta] == pcOppSide + PIECE_PAWN) {
+  }
+
+  // 2. жǷ񱻶Է((ʿ)Ĳ)
+  for (i = 0; i < 4; i ++) {
+    if (ucpcSquares[sqSrc + ccAdvisorDelta[i]] != 0) {
+      continue;
+    }
+    for (j = 0; j < 2; j ++) {
+      pcDst = ucpcSquares[sqSrc + ccKnightCheckDelta[i][j]];
+      if (pcDst == pcOppSide + PIECE_KNIGHT) {
         return TRUE;
       }
     }
+  }
 
-    // 2. жǷ񱻶Է((ʿ)Ĳ)
-    for (i = 0; i < 4; i ++) {
-      if (ucpcSquares[sqSrc + ccAdvisorDelta[i]] != 0) {
-        continue;
-      }
-      for (j = 0; j < 2; j ++) {
-        pcDst = ucpcSquares[sqSrc + ccKnightCheckDelta[i][j]];
-        if (pcDst == pcOppSide + PIECE_KNIGHT) {
+  // 3. жǷ񱻶Էĳڽ(˧)
+  for (i = 0; i < 4; i ++) {
+    nDelta = ccKingDelta[i];
+    sqDst = sqSrc + nDelta;
+    while (IN_BOARD(sqDst)) {
+      pcDst = ucpcSquares[sqDst];
+      if (pcDst != 0) {
+        if (pcDst == pcOppSide + PIECE_ROOK || pcDst == pcOppSide + PIECE_KING) {
           return TRUE;
         }
+        break;
       }
+      sqDst += nDelta;
     }
-
-    // 3. жǷ񱻶Էĳڽ(˧)
-    for (i = 0; i < 4; i ++) {
-      nDelta = ccKingDelta[i];
-      sqDst = sqSrc + nDelta;
-      while (IN_BOARD(sqDst)) {
-        pcDst = ucpcSquares[sqDst];
-        if (pcDst != 0) {
-          if (pcDst == pcOppSide + PIECE_ROOK || pcDst == pcOppSide + PIECE_KING) {
-            return TRUE;
-          }
-          break;
+    sqDst += nDelta;
+    while (IN_BOARD(sqDst)) {
+      int pcDst = ucpcSquares[sqDst];
+      if (pcDst != 0) {
+        if (pcDst == pcOppSide + PIECE_CANNON) {
+          return TRUE;
         }
-        sqDst += nDelta;
+        break;
       }
       sqDst += nDelta;
-      while (IN_BOARD(sqDst)) {
-        int pcDst = ucpcSquares[sqDst];
-        if (pcDst != 0) {
-          if (pcDst == pcOppSide + PIECE_CANNON) {
-            return TRUE;
-          }
-          break;
-        }
-        sqDst += nDelta;
-      }
     }
-    return FALSE;
   }
   return FALSE;
 }
@@ -1157,11 +1180,59 @@ static struct {
   int mvResult;                  // ߵ
   int nHistoryTable[65536];      // ʷ
   int mvKillers[LIMIT_DEPTH][2]; // ɱ߷
-  HashItem HashTable[HASH_SIZE]; // û
+  HashItem *HashTable;           // û
+  int nHashSize;                 // Entries in HashTable, a power of 2
   int nBookSize;                 // ֿС
   BookItem BookTable[BOOK_SIZE]; // ֿ
+  int nNodes;                    // Nodes searched for the current move
+  int nStartTime;                // When the search started (milliseconds)
+  int nDepth;                    // The iteration being searched
+  int nDepthDone;                // The last completed iteration
+  int nHashProbes, nHashHits, nHashCuts; // Statistics of the search
+  int nBetaCuts, nNullCuts;
+  BOOL bStop;                    // The node budget or the time is used up
 } Search;
 
+// Wall-clock milliseconds.  (On POSIX systems clock() counts CPU time.)
+static int GetTickCount(void) {
+#ifdef WIN32
+  return (int) (clock() * 1000.0 / CLOCKS_PER_SEC);
+#else
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec * 1000 + t.tv_usec / 1000;
+#endif
+}
+
+// Counts a node and tells whether the search has to stop.  The first iteration
+// is always completed so that there is a move to play.
+static BOOL SearchStopped(void) {
+  if (Search.bStop) {
+    return TRUE;
+  }
+  Search.nNodes ++;
+  if (Search.nDepth > 1) {
+    if (s_search_nodes > 0 && Search.nNodes >= s_search_nodes) {
+      Search.bStop = TRUE;
+    } else if (s_search_time > 0 && (Search.nNodes & 1023) == 0 &&
+               GetTickCount() - Search.nStartTime >= s_search_time) {
+      Search.bStop = TRUE;
+    }
+  }
+  return Search.bStop;
+}
+
+// Allocates the transposition table.  It shrinks if the memory is not available.
+static void AllocHash(int nEntries) {
+  free(Search.HashTable);
+  Search.HashTable = NULL;
+  while ((Search.HashTable = (HashItem *) calloc(nEntries, sizeof(HashItem))) == NULL &&
+         nEntries > 1) {
+    nEntries /= 2;
+  }
+  Search.nHashSize = (Search.HashTable == NULL ? 0 : nEntries);
+}
+
 // װ뿪ֿ
 
 #include <fstream>   // file I/O
@@ -1173,8 +1244,12 @@ static void LoadBook(void) {
      */
 
     using namespace std;
+    Search.nBookSize = 0;
+    if (s_opening_book.empty()) {
+        return;
+    }
     ifstream fp_in;  // declarations of streams fp_in and fp_out
-    fp_in.open(s_opening_book, ios::in|ios::binary|ios::ate);
+    fp_in.open(s_opening_book.c_str(), ios::in|ios::binary|ios::ate);
                                 // open and read til END
     if (!fp_in.is_open()) {
         return;
@@ -1267,11 +1342,13 @@ static int ProbeHash(int vlAlpha, int vlBeta, int nDepth, int &mv) {
   BOOL bMate; // ɱ־ɱ壬ôҪ
   HashItem hsh;
 
-  hsh = Search.HashTable[pos.zobr.dwKey & (HASH_SIZE - 1)];
+  hsh = Search.HashTable[pos.zobr.dwKey & (Search.nHashSize - 1)];
+  Search.nHashProbes ++;
   if (hsh.dwLock0 != pos.zobr.dwLock0 || hsh.dwLock1 != pos.zobr.dwLock1) {
     mv = 0;
     return -MATE_VALUE;
   }
+  Search.nHashHits ++;
   mv = hsh.wmv;
   bMate = FALSE;
   if (hsh.svl > WIN_VALUE) {
@@ -1301,7 +1378,7 @@ static int ProbeHash(int vlAlpha, int vlBeta, int nDepth, int &mv) {
 // û
 static void RecordHash(int nFlag, int vl, int nDepth, int mv) {
   HashItem hsh;
-  hsh = Search.HashTable[pos.zobr.dwKey & (HASH_SIZE - 1)];
+  hsh = Search.HashTable[pos.zobr.dwKey & (Search.nHashSize - 1)];
   if (hsh.ucDepth > nDepth) {
     return;
   }
@@ -1323,7 +1400,7 @@ static void RecordHash(int nFlag, int vl, int nDepth, int mv) {
   hsh.wmv = mv;
   hsh.dwLock0 = pos.zobr.dwLock0;
   hsh.dwLock1 = pos.zobr.dwLock1;
-  Search.HashTable[pos.zobr.dwKey & (HASH_SIZE - 1)] = hsh;
+  Search.HashTable[pos.zobr.dwKey & (Search.nHashSize - 1)] = hsh;
 };
 
 // MVV/LVAÿļֵ
@@ -1440,6 +1517,11 @@ static int SearchQuiesc(int vlAlpha, int vlBeta) {
   int mvs[MAX_GEN_MOVES];
   // һ̬Ϊ¼׶
 
+  // 0. The value does not matter once the search is stopped
+  if (SearchStopped()) {
+    return 0;
+  }
+
   // 1. ظ
   vl = pos.RepStatus();
   if (vl != 0) {
@@ -1482,6 +1564,9 @@ static int SearchQuiesc(int vlAlpha, int vlBeta) {
     if (pos.MakeMove(mvs[i])) {
       vl = -SearchQuiesc(-vlBeta, -vlAlpha);
       pos.UndoMakeMove();
+      if (Search.bStop) {
+        return 0;
+      }
 
       // 8. Alpha-BetaСжϺͽض
       if (vl > vlBest) {    // ҵֵ(ȷAlphaPVBeta߷)
@@ -1515,6 +1600,11 @@ static int SearchFull(int vlAlpha, int vlBeta, int nDepth, BOOL bNoNull = FALSE)
     return SearchQuiesc(vlAlpha, vlBeta);
   }
 
+  // 1-0. The value does not matter once the search is stopped
+  if (SearchStopped()) {
+    return 0;
+  }
+
   // 1-1. ظ(ע⣺Ҫڸڵ飬û߷)
   vl = pos.RepStatus();
   if (vl != 0) {
@@ -1529,6 +1619,7 @@ static int SearchFull(int vlAlpha, int vlBeta, int nDepth, BOOL bNoNull = FALSE)
   // 1-3. ûüõû߷
   vl = ProbeHash(vlAlpha, vlBeta, nDepth, mvHash);
   if (vl > -MATE_VALUE) {
+    Search.nHashCuts ++;
     return vl;
   }
 
@@ -1537,7 +1628,11 @@ static int SearchFull(int vlAlpha, int vlBeta, int nDepth, BOOL bNoNull = FALSE)
     pos.NullMove();
     vl = -SearchFull(-vlBeta, 1 - vlBeta, nDepth - NULL_DEPTH - 1, NO_NULL);
     pos.UndoNullMove();
+    if (Search.bStop) {
+      return 0;
+    }
     if (vl >= vlBeta) {
+      Search.nNullCuts ++;
       return vl;
     }
   }
@@ -1565,12 +1660,16 @@ static int SearchFull(int vlAlpha, int vlBeta, int nDepth, BOOL bNoNull = FALSE)
         }
       }
       pos.UndoMakeMove();
+      if (Search.bStop) {
+        return 0;
+      }
 
       // 5. Alpha-BetaСжϺͽض
       if (vl > vlBest) {    // ҵֵ(ȷAlphaPVBeta߷)
         vlBest = vl;        // "vlBest"ĿǰҪصֵܳAlpha-Beta߽
         if (vl >= vlBeta) { // ҵһBeta߷
           nHashFlag = HASH_BETA;
+          Search.nBetaCuts ++;
           mvBest = mv;      // Beta߷Ҫ浽ʷ
           break;            // Betaض
         }
@@ -1616,10 +1715,14 @@ static int SearchRoot(int nDepth) {
         }
       }
       pos.UndoMakeMove();
+      // Stopped: the caller falls back on the last completed iteration
+      if (Search.bStop) {
+        return vlBest;
+      }
       if (vl > vlBest) {
         vlBest = vl;
         Search.mvResult = mv;
-        if (vlBest > -WIN_VALUE && vlBest < WIN_VALUE) {
+        if (s_randomize && vlBest > -WIN_VALUE && vlBest < WIN_VALUE) {
           vlBest += (rand() & RANDOM_MASK) - (rand() & RANDOM_MASK);
         }
       }
@@ -1630,16 +1733,60 @@ static int SearchRoot(int nDepth) {
   return vlBest;
 }
 
+// The move in binary form (see XQWLight.h)
+static unsigned int BinaryMove(int mv) {
+  return (XQWLight::_xqwlight2square(SRC(mv)) << 8) | XQWLight::_xqwlight2square(DST(mv));
+}
+
+// Reports a completed iteration.  The principal variation is read from the
+// hash table, which is not counted as probes.
+static void ReportProgress(int nDepth, int vl) {
+  XQWLight::Progress progress;
+  int i, nUsed, mv;
+
+  progress.depth = nDepth;
+  progress.score = vl;
+  progress.nodes = Search.nNodes;
+  progress.msecs = GetTickCount() - Search.nStartTime;
+  nUsed = 0;
+  for (i = 0; i < 1000 && i < Search.nHashSize; i ++) {
+    if (Search.HashTable[i].ucFlag != 0) {
+      nUsed ++;
+    }
+  }
+  progress.hashFull = (Search.nHashSize < 1000 ? nUsed * 1000 / Search.nHashSize : nUsed);
+
+  progress.pvLength = 0;
+  mv = Search.mvResult;
+  while (mv != 0 && progress.pvLength < nDepth && progress.pvLength < 32 &&
+         pos.LegalMove(mv) && pos.MakeMove(mv)) {
+    progress.pv[progress.pvLength ++] = BinaryMove(mv);
+    const HashItem &hsh = Search.HashTable[pos.zobr.dwKey & (Search.nHashSize - 1)];
+    mv = (hsh.dwLock0 == pos.zobr.dwLock0 && hsh.dwLock1 == pos.zobr.dwLock1 ? hsh.wmv : 0);
+  }
+  for (i = 0; i < progress.pvLength; i ++) {
+    pos.UndoMakeMove();
+  }
+  s_progress_callback(progress, s_progress_data);
+}
+
 // 
 static void SearchMain(void) {
-  int i, t, vl, nGenMoves;
+  int i, t, vl, nGenMoves, mvDone;
   int mvs[MAX_GEN_MOVES];
 
   // ʼ
   memset(Search.nHistoryTable, 0, 65536 * sizeof(int));       // ʷ
   memset(Search.mvKillers, 0, LIMIT_DEPTH * 2 * sizeof(int)); // ɱ߷
-  memset(Search.HashTable, 0, HASH_SIZE * sizeof(HashItem));  // û
-  t = clock();       // ʼʱ
+  memset(Search.HashTable, 0, Search.nHashSize * sizeof(HashItem));  // û
+  t = GetTickCount(); // ʼʱ
+  Search.nStartTime = t;
+  Search.nNodes = 0;
+  Search.nDepth = 0;
+  Search.nDepthDone = 0;
+  Search.nHashProbes = Search.nHashHits = Search.nHashCuts = 0;
+  Search.nBetaCuts = Search.nNullCuts = 0;
+  Search.bStop = FALSE;
   pos.nDistance = 0; // ʼ
 
   // ֿ
@@ -1666,19 +1813,35 @@ static void SearchMain(void) {
   if (vl == 1) {
     return;
   }
+  mvDone = 0;
 
   // 
   for (i = 1; i <= s_search_depth; i ++) {
+    Search.nDepth = i;
     vl = SearchRoot(i);
+    // The node budget or the time ran out inside this iteration
+    if (Search.bStop) {
+      printf("%s: Search depth STOPPED = [%d]. nodes=[%d]\n", __FUNCTION__, i, Search.nNodes);
+      // The partial iteration only saw some root moves; its best is not
+      // comparable with the completed one, so keep the completed move.
+      if (mvDone != 0) {
+        Search.mvResult = mvDone;
+      }
+      break;
+    }
+    Search.nDepthDone = i;
+    mvDone = Search.mvResult;
+    if (s_progress_callback != NULL) {
+      ReportProgress(i, vl);
+    }
     // ɱ壬ֹ
     if (vl > WIN_VALUE || vl < -WIN_VALUE) {
       break;
     }
-    // һ룬ֹ
-    //if (clock() - t > CLOCKS_PER_SEC) {
-    float elapse = ((float) clock() - t) / CLOCKS_PER_SEC;
-    printf("%s: Search depth DONE = [%d]. elapse=[%.02f]\n", __FUNCTION__, i, elapse);
-    if ( (int)elapse > s_search_time ) {
+    // Half of the time is used up: the next iteration would not finish
+    const int elapse = GetTickCount() - t;
+    printf("%s: Search depth DONE = [%d]. elapse=[%d ms] nodes=[%d]\n", __FUNCTION__, i, elapse, Search.nNodes);
+    if ( s_search_time > 0 && 2 * elapse > s_search_time ) {
       break;
     }
     printf("%s: Search depth START = [%d].\n", __FUNCTION__, i+1);
@@ -1711,6 +1874,9 @@ XQWLight::init_game( unsigned char board[10][9] /* = NULL */,
 {
     srand((DWORD) time(NULL));
     InitZobrist();
+    if (Search.HashTable == NULL) {
+      AllocHash(HASH_SIZE);
+    }
     //Xqwl.hInst = hInstance;
     LoadBook();
     //Xqwl.bFlipped = FALSE;
@@ -1741,10 +1907,112 @@ XQWLight::on_human_move( const std::string& sMove )
     pos.MakeMove( Search.mvResult );
 }
 
+unsigned int
+XQWLight::generate_move_binary()
+{
+    SearchMain();
+
+    if ( Search.mvResult == 0 ) return 0;  // No move found.
+    pos.MakeMove( Search.mvResult );
+    const unsigned int src = _xqwlight2square( Search.mvResult & 255 );
+    const unsigned int dst = _xqwlight2square( Search.mvResult >> 8 );
+    return (src << 8) | dst;
+}
+
+void
+XQWLight::on_human_move_binary( unsigned int move )
+{
+    const unsigned int src = _square2xqwlight( move >> 8 );
+    const unsigned int dst = _square2xqwlight( move & 255 );
+    Search.mvResult = src | (dst << 8);
+    pos.MakeMove( Search.mvResult );
+}
+
 void
 XQWLight::set_search_time( int nSeconds )
 {
-    s_search_time = nSeconds;
+    set_move_time( nSeconds * 1000 );
+}
+
+void
+XQWLight::set_move_time( int nMilliseconds )
+{
+    s_search_time = nMilliseconds;
+}
+
+void
+XQWLight::set_node_limit( int nNodes )
+{
+    s_search_nodes = nNodes;
+}
+
+void
+XQWLight::set_hash_size( int nMegabytes )
+{
+    const size_t bytes = (size_t) nMegabytes << 20;
+    int nEntries = 1;
+    while ( 2 * nEntries * sizeof(HashItem) <= bytes ) nEntries *= 2;
+
+    if ( nEntries != Search.nHashSize )
+    {
+        AllocHash( nEntries );
+    }
+}
+
+void
+XQWLight::set_opening_book( const std::string& sPath )
+{
+    s_opening_book = sPath;
+    LoadBook();
+}
+
+void
+XQWLight::get_search_info( SearchInfo& info )
+{
+    info.depth      = Search.nDepthDone;
+    info.nodes      = Search.nNodes;
+    info.hashProbes = Search.nHashProbes;
+    info.hashHits   = Search.nHashHits;
+    info.hashCuts   = Search.nHashCuts;
+    info.betaCuts   = Search.nBetaCuts;
+    info.nullCuts   = Search.nNullCuts;
+}
+
+void
+XQWLight::set_progress_callback( ProgressCallback callback,
+                                 void*            data )
+{
+    s_progress_callback = callback;
+    s_progress_data     = data;
+}
+
+unsigned int
+XQWLight::bench_search( int nDepth )
+{
+    const int  depth     = s_search_depth;
+    const int  msecs     = s_search_time;
+    const int  nodes     = s_search_nodes;
+    const int  nBookSize = Search.nBookSize;
+    const BOOL bRandom   = s_randomize;
+
+    s_search_depth = ( nDepth < LIMIT_DEPTH ? nDepth : LIMIT_DEPTH - 1 );
+    s_search_time  = 0;
+    s_search_nodes = 0;
+    Search.nBookSize = 0;  // The book is kept loaded.
+    s_randomize    = FALSE;
+
+    SearchMain();
+
+    s_search_depth = depth;
+    s_search_time  = msecs;
+    s_search_nodes = nodes;
+    Search.nBookSize = nBookSize;
+    s_randomize    = bRandom;
+
+    if ( Search.mvResult == 0 ) return 0;  // No move found.
+    const unsigned int src = _xqwlight2square( Search.mvResult & 255 );
+    const unsigned int dst = _xqwlight2square( Search.mvResult >> 8 );
+    return (src << 8) | dst;
 }
 
 unsigned int
@@ -1759,6 +2027,18 @@ XQWLight::_hox2xqwlight( const std::string& sMove )
 	return src | (dst << 8);
 }
 
+unsigned int
+XQWLight::_square2xqwlight( unsigned int sq )
+{
+	return (3 + sq % 9) + (3 + sq / 9) * 16;
+}
+
+unsigned int
+XQWLight::_xqwlight2square( unsigned int sq )
+{
+	return ((sq / 16) - 3) * 9 + (sq % 16) - 3;
+}
+
 std::string
 XQWLight::_xqwlight2hox( unsigned int move )
 {
@@ -52,14 +52,68 @@ namespace XQWLight
 	std::string generate_move();
     void        on_human_move( const std::string& sMove );
 
+    unsigned int generate_move_binary();
+    void         on_human_move_binary( unsigned int move );
+        /* The same as above without strings: a move is (from << 8) | to,
+         * where a square is 9 * row + column in HOX coordinates.
+         * generate_move_binary() returns 0 if there is no move. */
+
     void set_search_time( int nSeconds );
 	    /* Only approximately... */
 
+    void set_move_time( int nMilliseconds );
+        /* Wall-clock cap per move (0 = none).  No new iteration is started
+         * after half of it, and a running one is abandoned at the cap. */
+
+    void set_node_limit( int nNodes );
+        /* Node budget per move (0 = none).  Unlike the time, it gives the
+         * same play on every computer.  The search depth set by
+         * init_engine() is only a ceiling. */
+
+    void set_hash_size( int nMegabytes );
+        /* Size of the transposition table, rounded down to a power of 2
+         * entries.  The default is 16 MB. */
+
+    void set_opening_book( const std::string& sPath );
+        /* Loads an opening book (BOOK.DAT format) now and for the next
+         * games.  An empty path disables the book. */
+
+    struct SearchInfo
+    {
+        int depth;       // The last completed iteration.
+        int nodes;
+        int hashProbes, hashHits, hashCuts;
+        int betaCuts, nullCuts;
+    };
+    void get_search_info( SearchInfo& info );
+        /* The statistics of the last search. */
+
+    struct Progress
+    {
+        int depth;            // The iteration just completed.
+        int score;            // For the side to move.
+        int nodes, msecs;     // Since the search started.
+        int hashFull;         // Per mille.
+        int pvLength;
+        unsigned int pv[32];  // The best line, in binary form.
+    };
+    typedef void (*ProgressCallback)( const Progress& progress, void* data );
+    void set_progress_callback( ProgressCallback callback, void* data );
+        /* 'callback' (NULL for none) is called with 'data' after each
+         * iteration of the searches. */
+
+    unsigned int bench_search( int nDepth );
+        /* Searches the current position to the given depth, without
+         * node or time limit, book or random noise, and returns the best
+         * move (in binary form, 0 if none) without playing it. */
+
 
     /* PRIVATE API (declared here for documentation purpose) */
 
 	unsigned int _hox2xqwlight( const std::string& sMove );
 	std::string _xqwlight2hox( unsigned int move );
+	unsigned int _square2xqwlight( unsigned int sq );
+	unsigned int _xqwlight2square( unsigned int sq );
 
 } // namespace XQWLight
 
@@ -65,6 +65,210 @@
  */
 typedef std::list<std::string> MoveList;
 
+/**
+ * An engine option, such as the size of the hash table.
+ * Values are always passed as strings: a decimal number for a SPIN option,
+ * "true" or "false" for a CHECK option, and any text for a STRING option.
+ */
+struct AIOption
+{
+    enum Type
+    {
+        AI_OPTION_SPIN,    /* An integer within [minValue, maxValue] */
+        AI_OPTION_CHECK,   /* A boolean                              */
+        AI_OPTION_STRING   /* A text, such as a file path            */
+    };
+
+    AIOption( const std::string& n = "",
+              Type               t = AI_OPTION_STRING,
+              const std::string& v = "",
+              int                lo = 0,
+              int                hi = 0 )
+        : name( n ), type( t ), value( v ), minValue( lo ), maxValue( hi ) {}
+
+    std::string  name;      /* Unique within an engine, e.g. "Hash" (MB). */
+    Type         type;
+    std::string  value;     /* The current value.                         */
+    int          minValue;  /* The range of a SPIN option.                */
+    int          maxValue;
+};
+typedef std::list<AIOption> AIOptionList;
+
+/**
+ * A move in binary form: (from << 8) | to, where a square is
+ * (9 * row + column) in HOX coordinates.  That is, the move "xyXY" goes
+ * from the square 9*y+x to the square 9*Y+X.
+ */
+typedef unsigned short AIMove;
+
+#define hoxAI_MOVE_NONE  0  /* No move (the origin cannot be the destination) */
+
+inline AIMove AIMakeMove( int from, int to ) { return (AIMove)( (from << 8) | to ); }
+inline int    AIMoveFrom( AIMove move )      { return move >> 8; }
+inline int    AIMoveTo( AIMove move )        { return move & 0xFF; }
+
+/**
+ * Convert between the binary and the 4-digit ("xyXY") form of a move
+ * without allocating.  A malformed move becomes hoxAI_MOVE_NONE.
+ */
+inline AIMove AIMoveFromString( const char* sMove )
+{
+    for ( int i = 0; i < 4; ++i )
+    {
+        if ( sMove[i] < '0' || sMove[i] > ( i % 2 == 0 ? '8' : '9' ) )
+            return hoxAI_MOVE_NONE;
+    }
+    return AIMakeMove( 9 * (sMove[1] - '0') + (sMove[0] - '0'),
+                       9 * (sMove[3] - '0') + (sMove[2] - '0') );
+}
+
+inline void AIMoveToString( AIMove move, char sMove[5] )
+{
+    sMove[0] = (char)( '0' + AIMoveFrom( move ) % 9 );
+    sMove[1] = (char)( '0' + AIMoveFrom( move ) / 9 );
+    sMove[2] = (char)( '0' + AIMoveTo( move ) % 9 );
+    sMove[3] = (char)( '0' + AIMoveTo( move ) / 9 );
+    sMove[4] = '\0';
+}
+
+/**
+ * A position in binary form.  Each square (9 * row + column, row 0 being
+ * Black's back rank as in FEN) holds the FEN letter of its piece, i.e.
+ * 'K', 'A', 'E', 'R', 'H', 'C', 'P' for Red and lowercase for Black,
+ * or 0 if it is empty.
+ */
+struct AIPosition
+{
+    char  squares[90];
+    char  side;         /* The side to move: 'w' (Red) or 'b' (Black). */
+};
+
+/**
+ * Render a position in FEN, for engines that only understand the text form.
+ */
+inline std::string AIPositionToFEN( const AIPosition& position )
+{
+    std::string fen;
+    int zeros = 0;  // The # of empty squares.
+    for ( int i = 0; i < 90; ++i )
+    {
+        if ( position.squares[i] == 0 ) ++zeros;
+        else
+        {
+            if ( zeros > 0 ) { fen += (char)( '0' + zeros ); zeros = 0; }
+            fen += position.squares[i];
+        }
+
+        if ( i % 9 == 8 ) // end of a row (rank)?
+        {
+            if ( zeros > 0 ) { fen += (char)( '0' + zeros ); zeros = 0; }
+            if ( i != 89 ) fen += '/';
+        }
+    }
+    fen += ' ';
+    fen += ( position.side == 'b' ? 'b' : 'w' );
+    return fen;
+}
+
+/**
+ * The reverse of AIPositionToFEN().  Only the placement and the side to
+ * move are read.  Returns false if the FEN is malformed.
+ */
+inline bool AIPositionFromFEN( const std::string& fen, AIPosition& position )
+{
+    for ( int i = 0; i < 90; ++i ) position.squares[i] = 0;
+    position.side = 'w';
+
+    int row = 0, col = 0;
+    std::string::size_type i = 0;
+    for ( ; i < fen.size() && fen[i] != ' '; ++i )
+    {
+        const char c = fen[i];
+        if      ( c == '/' )             { ++row; col = 0; }
+        else if ( c >= '1' && c <= '9' ) { col += c - '0'; }
+        else if ( std::string("KAERHCPkaerhcp").find( c ) != std::string::npos )
+        {
+            if ( row > 9 || col > 8 ) return false;
+            position.squares[9 * row + col++] = c;
+        }
+        else return false;
+
+        if ( row > 9 || col > 9 ) return false;
+    }
+    if ( i + 1 < fen.size() ) position.side = ( fen[i + 1] == 'b' ? 'b' : 'w' );
+    return ( row == 9 );
+}
+
+/**
+ * What an engine tells about the search of its last generated move.
+ */
+struct AISearchInfo
+{
+    AISearchInfo() : depth( 0 ), nodes( 0 ), hashProbes( 0 ), hashHits( 0 )
+                   , hashCutoffs( 0 ), betaCutoffs( 0 ), nullCutoffs( 0 ) {}
+
+    int            depth;  /* The deepest completed iteration, in plies
+                            * (0 if none, e.g. for a book move).       */
+    unsigned long  nodes;  /* The nodes visited, as counted by the engine. */
+
+    /* The counters that an engine does not keep stay 0. */
+    unsigned long  hashProbes;   /* Lookups in the transposition table, */
+    unsigned long  hashHits;     /*   those that found the position,    */
+    unsigned long  hashCutoffs;  /*   and those that ended the node.    */
+    unsigned long  betaCutoffs;  /* Nodes ended by a move failing high. */
+    unsigned long  nullCutoffs;  /* Nodes ended by the null move.       */
+};
+
+#define hoxAI_MAX_PV  32  /* The longest principal variation reported. */
+
+/**
+ * Where a search stands after one of its iterations.
+ */
+struct AISearchProgress
+{
+    AISearchProgress() : depth( 0 ), selDepth( 0 ), score( 0 ), nodes( 0 )
+                       , msecs( 0 ), hashFull( 0 ), pvLength( 0 ) {}
+
+    int            depth;     /* The iteration just completed, in plies. */
+    int            selDepth;  /* The deepest ply reached (0 if unknown). */
+    int            score;     /* For the side to move, in the engine's
+                               * own units.                              */
+    unsigned long  nodes;     /* Since the search started.               */
+    unsigned long  msecs;     /* Since the search started.               */
+    int            hashFull;  /* The table in use, per mille (0 if unknown). */
+
+    AIMove         pv[hoxAI_MAX_PV];  /* The best line, starting with the */
+    int            pvLength;          /* best move (at least that move).  */
+};
+
+/**
+ * Receives the progress of the searches of an engine.
+ */
+class AISearchListener
+{
+public:
+    virtual ~AISearchListener() {}
+
+    virtual void onSearchProgress( const AISearchProgress& progress ) = 0;
+        /* Called on the thread of the search after each iteration.
+         * It should return quickly: the search waits for it. */
+};
+
+/**
+ * A difficulty level of an engine (see setDifficultyLevel), for the
+ * plugins that keep a table of them.  A level is a node budget and a
+ * wall-clock cap per move; the search depth is only a ceiling.  The
+ * budgets are calibrated by self-play from the opening position, and
+ * each table notes the average time per move that it took (plain 'make'
+ * build, single core).
+ */
+struct AILevel
+{
+    int maxDepth;  // Ceiling on the search depth.
+    int nodes;     // Node budget per move.
+    int msecs;     // Wall-clock cap per move.
+};
+
 /**
  * AIEngineLib interface.
  */
@@ -87,6 +291,63 @@ public:
 
     virtual std::string getInfo() { return ""; }
 
+    // ------------ Engine options (may be called before initEngine()).
+    virtual int         listOptions( AIOptionList& options )
+                            { return hoxAI_RC_NOT_SUPPORTED; }
+    virtual int         setOption( const std::string& name,
+                                   const std::string& value )
+                            { return hoxAI_RC_NOT_SUPPORTED; }
+                            /* Returns hoxAI_RC_NOT_FOUND for an unknown
+                             * option and hoxAI_RC_ERR for a bad value. */
+
+    // ------------ Binary exchange of positions and moves.
+    //              Same as initGame(), generateMove() and onHumanMove()
+    //              but without strings.  An engine overrides them to avoid
+    //              allocating; the defaults go through the text functions.
+    // ............................................. position - NULL for the initial one
+    virtual int         initGameBinary( const AIPosition* position,
+                                        const AIMove*     moves,
+                                        int               nMoves )
+                            {
+                                MoveList moveList;
+                                char sMove[5];
+                                for ( int i = 0; i < nMoves; ++i )
+                                {
+                                    AIMoveToString( moves[i], sMove );
+                                    moveList.push_back( sMove );
+                                }
+                                return initGame( position ? AIPositionToFEN( *position ) : "",
+                                                 moveList );
+                            }
+    virtual AIMove      generateMoveBinary()
+                            { return AIMoveFromString( generateMove().c_str() ); }
+    virtual void        onHumanMoveBinary( AIMove move )
+                            {
+                                char sMove[5];
+                                AIMoveToString( move, sMove );
+                                onHumanMove( sMove );
+                            }
+
+    // ------------ Statistics of the last generateMove() (or its binary form).
+    virtual int         getSearchInfo( AISearchInfo& info )
+                            { return hoxAI_RC_NOT_SUPPORTED; }
+
+    // ------------ Benchmark: search the current position to a fixed depth
+    //              (plies, as the engine counts them) with no time or node
+    //              limit, no opening book and no randomness, so that the
+    //              nodes are the same on every run of a new engine.  Some
+    //              engines play the move: start a new game afterwards.
+    virtual int         benchSearch( int           depth,
+                                     AIMove&       move,
+                                     AISearchInfo& info )
+                            { return hoxAI_RC_NOT_SUPPORTED; }
+
+    // ------------ Search progress: 'listener' (NULL to stop) is told about
+    //              each iteration of the following searches.  The engine
+    //              does not own it.
+    virtual int         setSearchListener( AISearchListener* listener )
+                            { return hoxAI_RC_NOT_SUPPORTED; }
+
     void operator delete(void* p)
         {
             if (p)
@@ -0,0 +1,173 @@
+/***************************************************************************
+ *  Copyright 2007-2009 Huy Phan  <huyphan@playxiangqi.com>                *
+ *                      Bharatendra Boddu (bharathendra at yahoo dot com)  *
+ *                                                                         *
+ *  This file is part of HOXChess.                                         *
+ *                                                                         *
+ *  HOXChess is free software: you can redistribute it and/or modify       *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  HOXChess is distributed in the hope that it will be useful,            *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with HOXChess.  If not, see <http://www.gnu.org/licenses/>.      *
+ ***************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+// Name:            AIHostProtocol.h
+// Created:         10/19/2026
+//
+// Description:     The pipe protocol between a client and the engine host
+//                  (AI_host), which runs AI Engine Plugins out of process.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INCLUDED_AI_HOST_PROTOCOL_H__
+#define __INCLUDED_AI_HOST_PROTOCOL_H__
+
+#include <string>
+#include "AIEngineLib.h"
+
+/**
+ * Every message is a frame:
+ *
+ *     length  (u32)  - The number of bytes that follow.
+ *     command (u8)   - One of AIHostCommand.
+ *     slot    (u8)   - The engine instance inside the host.
+ *     payload
+ *
+ * Integers are little-endian and a string is its length (u16) followed by
+ * its bytes.  The host answers each request, except QUIT, with one frame of
+ * the same command and slot whose payload starts with a return-code (i32).
+ * Once SET_LISTENER is on, a search also sends PROGRESS frames of its slot
+ * (with a return-code of 0) before the reply.
+ * The requests of a slot are handled in order; different slots run at the
+ * same time, so their replies may come in any order.
+ */
+enum AIHostCommand
+{
+    AI_HOST_OPEN = 1,       /* Create the engine of the slot.         */
+    AI_HOST_CLOSE,          /* Destroy the engine of the slot.        */
+    AI_HOST_INIT_ENGINE,    /* level (i32)                            */
+    AI_HOST_INIT_GAME,      /* hasPosition (u8) [squares (90) side (u8)]
+                             * nMoves (u16) moves (u16 * nMoves)      */
+    AI_HOST_GENERATE_MOVE,  /*   => move (u16)                        */
+    AI_HOST_HUMAN_MOVE,     /* move (u16)                             */
+    AI_HOST_SET_LEVEL,      /* level (i32)                            */
+    AI_HOST_GET_INFO,       /*   => info (string)                     */
+    AI_HOST_LIST_OPTIONS,   /*   => nOptions (u16) { name (string) type (u8)
+                             *        value (string) min (i32) max (i32) } */
+    AI_HOST_SET_OPTION,     /* name (string) value (string)           */
+    AI_HOST_QUIT,           /* No reply: the host exits.              */
+    AI_HOST_SEARCH_INFO,    /*   => depth (i32) nodes (u32) hashProbes (u32)
+                             *      hashHits (u32) hashCutoffs (u32)
+                             *      betaCutoffs (u32) nullCutoffs (u32) */
+    AI_HOST_BENCH,          /* depth (i32)
+                             *   => move (u16) and the SEARCH_INFO    */
+    AI_HOST_SET_LISTENER,   /* on (u8)                                */
+    AI_HOST_PROGRESS        /* From the host only, during a search:
+                             *   depth (i32) selDepth (i32) score (i32)
+                             *   nodes (u32) msecs (u32) hashFull (i32)
+                             *   pvLength (u16) pv (u16 * pvLength)   */
+};
+
+#define AI_HOST_MAX_SLOTS       64
+#define AI_HOST_MAX_FRAME  0x10000  /* The largest accepted length. */
+
+/**
+ * Builds a frame.
+ */
+class AIHostWriter
+{
+public:
+    AIHostWriter( int command, int slot )
+        {
+            m_buf.reserve( 64 );
+            m_buf.append( 4, '\0' );  // The length (see data()).
+            put8( command );
+            put8( slot );
+        }
+
+    void put8( int v )  { m_buf += (char) ( v & 0xFF ); }
+    void put16( int v ) { put8( v ); put8( v >> 8 ); }
+    void put32( int v ) { put16( v ); put16( v >> 16 ); }
+    void putString( const std::string& s )
+        {
+            const size_t n = ( s.size() < 0xFFFF ? s.size() : 0xFFFF );
+            put16( (int) n );
+            m_buf.append( s, 0, n );
+        }
+
+    /* The whole frame, length included. */
+    const std::string& data()
+        {
+            const size_t n = m_buf.size() - 4;
+            m_buf[0] = (char) ( n & 0xFF );
+            m_buf[1] = (char) ( (n >> 8) & 0xFF );
+            m_buf[2] = (char) ( (n >> 16) & 0xFF );
+            m_buf[3] = (char) ( (n >> 24) & 0xFF );
+            return m_buf;
+        }
+
+private:
+    std::string  m_buf;
+};
+
+/**
+ * Parses a frame (without its length).  Reading past the end sets a
+ * sticky error and returns zeros.
+ */
+class AIHostReader
+{
+public:
+    AIHostReader( const char* data, size_t size )
+        : m_p( (const unsigned char*) data ), m_left( size ), m_ok( true ) {}
+
+    int get8()
+        {
+            if ( m_left < 1 ) { m_ok = false; return 0; }
+            --m_left;
+            return *m_p++;
+        }
+    int get16() { const int lo = get8(); return lo | ( get8() << 8 ); }
+    int get32()
+        {
+            const unsigned int lo = (unsigned int) get16();
+            return (int) ( lo | ( (unsigned int) get16() << 16 ) );
+        }
+    std::string getString()
+        {
+            const size_t n = (size_t) get16();
+            if ( n > m_left ) { m_ok = false; m_left = 0; return ""; }
+            const std::string s( (const char*) m_p, n );
+            m_p += n; m_left -= n;
+            return s;
+        }
+    bool getBytes( char* dest, size_t n )
+        {
+            if ( n > m_left ) { m_ok = false; m_left = 0; return false; }
+            for ( size_t i = 0; i < n; ++i ) dest[i] = (char) m_p[i];
+            m_p += n; m_left -= n;
+            return true;
+        }
+
+    bool ok() const { return m_ok; }
+
+private:
+    const unsigned char*  m_p;
+    size_t                m_left;
+    bool                  m_ok;
+};
+
+/** The length of a frame from its first 4 bytes. */
+inline size_t AIHostFrameLength( const unsigned char header[4] )
+{
+    return (size_t) header[0]         | ( (size_t) header[1] << 8 )
+         | ( (size_t) header[2] << 16 ) | ( (size_t) header[3] << 24 );
+}
+
+#endif /* __INCLUDED_AI_HOST_PROTOCOL_H__ */
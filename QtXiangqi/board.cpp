@@ -8,6 +8,8 @@ static const int borderY = 40;
 static const int cellS = 60;
 static const float pieceS = 45.0;
 static const float animateS = 55.0;
+static const int keyframePlies = 16; // Moves between two keyframes.
+static const uchar keyPieceShown = 0x80;
 
 ////////////////////////////////////////////////////////////////////
 //
@@ -76,6 +78,7 @@ Board::Board(QWidget* parent, BoardOwner* boardOwner)
     _infoLabel->setProperty("tag", INFO_LABEL_TAG_NONE);
 
     _referee->initGame();
+    _takeKeyframe();
     _initSoundSystem();
 }
 
@@ -105,6 +108,8 @@ void Board::resetBoard()
     _referee->initGame();
     _moves.clear();
     _nthMove = HISTORY_INDEX_END;
+    _keyframes.clear();
+    _takeKeyframe();
 }
 
 void Board::paintEvent(QPaintEvent *event)
@@ -207,6 +212,7 @@ void Board::onNewMove(hox::Position from, hox::Position to, bool setupMode /* =
 
     // Finally, update the Board's UI accordingly.
     _updateUIOnNewMove(pMove, !setupMode /* animated */);
+    _takeKeyframe();
 }
 
 void Board::_updateUIOnNewMove(ReplayMove* pMove, bool animated)
@@ -329,7 +335,7 @@ void Board::doReplay_BEGIN()
     }
     _playSound("Replay");
 
-    while (_doReplayPREV(false /* no animation */)) { /* ... until no more move */ }
+    _doReplayGOTO(0);
     _setReplayMode( isInReplay_() );
 }
 
@@ -366,6 +372,7 @@ bool Board::_doReplayNEXT(bool animated)
         _clearAllAnimation();
         _updateUIOnNewMove(pMove, animated);
     }
+    _takeKeyframe();
 
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     // NOTE: We delay updating the index to the "END" mark to avoid race
@@ -390,14 +397,81 @@ void Board::doReplay_END()
     if (_moves.empty() || _nthMove == HISTORY_INDEX_END) {
         return;
     }
-    const int lastMoveIndex = _moves.size() - 2;
-    while (_nthMove < lastMoveIndex) {
-        _doReplayNEXT(false /* no animation */);
-    }
+    _doReplayGOTO(_moves.size() - 1);
     _doReplayNEXT(true /* animation */);
     _setReplayMode( isInReplay_() );
 }
 
+/**
+ * Shows the position after a given number of moves, starting from the
+ * nearest keyframe or the current position (whichever is closer).
+ * Nothing is animated.
+ */
+void Board::_doReplayGOTO(int ply)
+{
+    Q_ASSERT_X(ply >= 0 && ply <= _moves.size(), "Replay GOTO", "Invalid ply");
+    int current = _replayPly();
+
+    if (!_keyframes.isEmpty()) {
+        const int index = qMin(ply / keyframePlies, _keyframes.size() - 1);
+        const int keyPly = index * keyframePlies;
+        if (ply - keyPly < qAbs(ply - current)) {
+            _clearAllAnimation();
+            _restoreKeyframe(index);
+            _nthMove = (keyPly == _moves.size() ? (int) HISTORY_INDEX_END : keyPly - 1);
+            current = keyPly;
+        }
+    }
+
+    for (; current > ply; --current) {
+        if (!_doReplayPREV(false /* no animation */)) break;
+    }
+    for (; current < ply; ++current) {
+        if (!_doReplayNEXT(false /* no animation */)) break;
+    }
+}
+
+/**
+ * The number of moves played to reach the position on the Board.
+ */
+int Board::_replayPly() const
+{
+    return (_nthMove == HISTORY_INDEX_END ? _moves.size() : _nthMove + 1);
+}
+
+/**
+ * Takes a keyframe of the Board if it is the first to reach the next
+ * multiple of 'keyframePlies' moves.
+ */
+void Board::_takeKeyframe()
+{
+    const int ply = _replayPly();
+    if (ply % keyframePlies != 0 || ply / keyframePlies != _keyframes.size()) {
+        return;  // Not a keyframe, or already taken.
+    }
+
+    QByteArray keyframe(_pieces.size(), 0);
+    for (int i = 0; i < _pieces.size(); ++i) {
+        const Piece* piece = _pieces.at(i);
+        // The square (0-89) and whether the piece is on the Board.
+        keyframe[i] = char( (piece->row() * 9 + piece->col())
+                          | (piece->isHidden() ? 0 : keyPieceShown) );
+    }
+    _keyframes.append(keyframe);
+}
+
+void Board::_restoreKeyframe(int index)
+{
+    const QByteArray& keyframe = _keyframes.at(index);
+    for (int i = 0; i < _pieces.size(); ++i) {
+        Piece* piece = _pieces.at(i);
+        const uchar keyPiece = uchar(keyframe.at(i));
+        const int square = keyPiece & ~keyPieceShown;
+        _setPiecePosition(piece, hox::Position(square / 9, square % 9));
+        piece->setVisible((keyPiece & keyPieceShown) != 0);
+    }
+}
+
 void Board::_setPiecePosition(Piece* piece, hox::Position newPosition)
 {
     piece->setPosition(newPosition.row, newPosition.col);
@@ -44,6 +44,11 @@ private:
 
     bool _doReplayPREV(bool animated = true);
     bool _doReplayNEXT(bool animated = true);
+    void _doReplayGOTO(int ply);
+    int  _replayPly() const;
+
+    void _takeKeyframe();
+    void _restoreKeyframe(int index);
 
     void _onGameOver();
     void _setReplayMode(bool on);
@@ -84,6 +89,10 @@ private:
     QList<ReplayMove*>  _moves;    // MOVE history
     int                 _nthMove;  // The pivot for Move Replay
 
+    // Position after every KEYFRAME_PLIES moves: one byte per piece
+    // (in the order of '_pieces'), see _takeKeyframe().
+    QList<QByteArray>   _keyframes;
+
     QHash<QString, QSound*> _sounds;
 };
 